@@ -10,8 +10,10 @@
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <map>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -25,6 +27,7 @@
 #include <mem/mem_alloc_aligned.h>
 #include <mem/mem_alloc_std.h>
 #include <mem/mem_intrusive_ptr.h>
+#include <mem/mem_deferred_ref_counter.h>
 #include <mem/mem_ref_counter.h>
 
 #include <math/math_vector.h>
@@ -346,7 +349,14 @@ namespace geodesics
         typedef mem::intrusive_ptr< face >		face_pointer;
 #endif
 
-        class vertex : public mem::alloc_aligned< vertex >, public mem::ref_counter<vertex>
+#if defined(USE_IMMEDIATE_REF_COUNT)
+        template <class derived> using ref_counter = mem::ref_counter<derived>;
+#else
+        //the iterators copy pointers all the time, keep the copies out of the shared objects, so the mesh can be traversed from many threads
+        template <class derived> using ref_counter = mem::deferred_ref_counter<derived>;
+#endif
+
+        class vertex : public mem::alloc_aligned< vertex >, public ref_counter<vertex>
         {
             public:
 
@@ -380,7 +390,7 @@ namespace geodesics
             half_edge_pointer m_incident_edge;
         };
 
-        class face : public mem::ref_counter<face>
+        class face : public ref_counter<face>
         {
             public:
 
@@ -394,7 +404,7 @@ namespace geodesics
             uint32_t m_index;
         };
 
-        class half_edge : public mem::ref_counter<half_edge>
+        class half_edge : public ref_counter<half_edge>
         {
             public:
 
@@ -1402,8 +1412,53 @@ int wmain(int argc, wchar_t* argv[])
     }
     
 
+    //read only traversal from all cores (one with the immediate counters), the one ring iterators copy half edge pointers on every step
+    timer.reset();
+
+    uint64_t vertex_count = h->vertices_end() - h->vertices_begin();
+
+#if defined(USE_IMMEDIATE_REF_COUNT) && !defined(USE_SHARED_PTR)
+    //the immediate counters are not atomic, the copies of the iterators would race
+    uint32_t thread_count = 1;
+#else
+    uint32_t thread_count = std::max( std::thread::hardware_concurrency(), 1U );
+#endif
+
+    std::vector< uint64_t >     valences( thread_count );
+    std::vector< std::thread >  threads;
+
+    for ( uint32_t t = 0; t < thread_count; ++t )
+    {
+        threads.push_back( std::thread( [&, t] () -> void
+        {
+            uint64_t valence = 0;
+
+            for ( auto v = vertex_count * t / thread_count; v < vertex_count * ( t + 1 ) / thread_count; ++v )
+            {
+                for ( auto iter = h->vertex_vertex( static_cast<uint32_t> ( v ) ); iter.is_valid(); ++iter )
+                {
+                    ++valence;
+                }
+            }
+
+            valences[t] = valence;
+        }));
+    }
+
+    std::for_each( threads.begin(), threads.end(), [] ( std::thread& t ) -> void
+    {
+        t.join();
+    });
+
+    auto seconds_traversed_elapsed = timer.milliseconds();
+
     std::cout<<"mesh loaded for "<< seconds_loaded_elapsed <<" milliseconds" << std::endl;
     std::cout<<"half_mesh created for "<< seconds_created_elapsed <<" milliseconds" << std::endl;
+    std::cout<<"half_mesh traversed by "<< thread_count << " threads for "<< seconds_traversed_elapsed <<" milliseconds, average valence "<< static_cast<double> ( std::accumulate( valences.begin(), valences.end(), 0ULL ) ) / vertex_count << std::endl;
+
+    //all threads are joined, release the unreferenced half edge structures
+    h.reset();
+    mem::deferred_ref_collect();
     
     return 0;
 }
@@ -6,7 +6,9 @@
                                         &gTaskMgrCRT,
     #endif
                                         &gTaskMgrSS,
-
+    #if _MSC_VER >= 1700
+                                        &gTaskMgrWS,
+    #endif
                                       };
 
     const wchar_t *TaskMgrNames[TaskMgrID::Count + 1] = { TEXT("TBB"),
@@ -14,6 +16,9 @@
                                             TEXT("ConcRT"),
                                             #endif
                                             TEXT("SS"),
+                                            #if _MSC_VER >= 1700
+                                            TEXT("WS"),
+                                            #endif
                                             TEXT("None")
     };
 
@@ -34,6 +39,13 @@
         const wchar_t *TaskMgrNames[TaskMgrID::Count + 1] = { TEXT("SS"),
                                                 TEXT("None")
         };
+    #elif defined(STATIC_WS)
+        #if _MSC_VER >= 1700
+            TaskMgrWS* g_pTaskMgr = &gTaskMgrWS;
+            const wchar_t *TaskMgrNames[TaskMgrID::Count + 1] = { TEXT("WS"),
+                                                    TEXT("None")
+            };
+        #endif
     #elif defined(STATIC_TBB)
         TaskMgrTbb* g_pTaskMgr = &gTaskMgr;
         const wchar_t *TaskMgrNames[TaskMgrID::Count + 1] = { TEXT("TBB"),
@@ -29,6 +29,8 @@
 //#define STATIC_CRT
   // Uses Simple Scheduler (custom) as the only scheduler
 //#define STATIC_SS
+  // Uses the portable work-stealing scheduler as the only scheduler
+//#define STATIC_WS
 #include "TaskMgr.h"
 
 
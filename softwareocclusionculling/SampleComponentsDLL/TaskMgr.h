@@ -30,10 +30,16 @@ struct TaskMgrID
 
         SS,
 
+    #if _MSC_VER >= 1700
+        WS,
+    #endif
+
     #elif defined(STATIC_TBB)
         TBB,
     #elif defined(STATIC_SS)
         SS,
+    #elif defined(STATIC_WS) && _MSC_VER >= 1700
+        WS,
     #elif defined(STATIC_CRT) && _MSC_VER >= 1600 
         CRT,
     #endif
@@ -52,6 +58,9 @@ struct TaskMgrID
     #if _MSC_VER >= 1600
         #include "TaskMgrCRT.h"
     #endif
+    #if _MSC_VER >= 1700
+        #include "TaskMgrWS.h"
+    #endif
     extern DynamicTaskMgrBase* g_pTaskMgr;
 #else
     #define DYNAMIC_BASE
@@ -60,8 +69,17 @@ struct TaskMgrID
     #if _MSC_VER >= 1600
         #include "TaskMgrCRT.h"
     #endif
+    #if _MSC_VER >= 1700
+        #include "TaskMgrWS.h"
+    #endif
     #if defined(STATIC_SS)
         extern TaskMgrSS* g_pTaskMgr;
+    #elif defined(STATIC_WS)
+        #if _MSC_VER >= 1700
+            extern TaskMgrWS* g_pTaskMgr;
+        #else
+            #error "Work-stealing scheduler requires C++11 threads and atomics"
+        #endif
     #elif defined(STATIC_TBB)
         extern TaskMgrTbb* g_pTaskMgr;
     #elif defined(STATIC_CRT)
@@ -0,0 +1,354 @@
+/*!
+    \file TaskMgrWS.cpp
+
+    TaskMgrWS is a class that uses a portable work-stealing scheduler with a
+    C-style handle and callback mechanism for scheduling tasks across any
+    number of CPU cores.
+
+    Copyright 2011 Intel Corporation
+    All Rights Reserved
+
+    Permission is granted to use, copy, distribute and prepare derivative works of this
+    software for any purpose and without fee, provided, that the above copyright notice
+    and this statement appear in all copies.  Intel makes no representations about the
+    suitability of this software for any purpose.  THIS SOFTWARE IS PROVIDED ""AS IS.""
+    INTEL SPECIFICALLY DISCLAIMS ALL WARRANTIES, EXPRESS OR IMPLIED, AND ALL LIABILITY,
+    INCLUDING CONSEQUENTIAL AND OTHER INDIRECT DAMAGES, FOR THE USE OF THIS SOFTWARE,
+    INCLUDING LIABILITY FOR INFRINGEMENT OF ANY PROPRIETARY RIGHTS, AND INCLUDING THE
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.  Intel does not
+    assume any responsibility for any errors which may appear in this software nor any
+    responsibility to update it.
+
+*/
+#include "SampleComponents.h"
+#include "TaskMgrWS.h"
+
+#include <stdio.h>
+#include <strsafe.h>
+
+//
+//  Global work-stealing task mananger instance
+//
+TaskMgrWS                      gTaskMgrWS;
+
+
+TaskMgrWS::TaskSet::TaskSet()
+: mpFunc( NULL )
+, mpvArg( 0 )
+, muSize( 0 )
+, mhTaskset( TASKSETHANDLE_INVALID )
+, mbCompleted( true )
+, miRefCount( 0 )
+, miStartCount( 0 )
+, miCompletionCount( 0 )
+{
+    mszSetName[ 0 ] = 0;
+    memset( Successors, 0, sizeof( Successors ) ) ;
+};
+
+void TaskMgrWS::TaskSet::Execute( UINT uTaskId, INT iContextId )
+{
+    ProfileBeginTask( mszSetName );
+
+    mpFunc( mpvArg, iContextId, uTaskId, muSize );
+
+    ProfileEndTask();
+
+    //  Notify the taskmgr that this set completed one of its tasks.
+    gTaskMgrWS.CompleteTaskSet( mhTaskset );
+}
+
+void TaskMgrWS::ExecuteTask( void* pOwner, unsigned int hSet, unsigned int uTaskId, int iContextId )
+{
+    TaskMgrWS* pTaskMgr = reinterpret_cast<TaskMgrWS*>( pOwner );
+    pTaskMgr->mSets[ hSet ].Execute( uTaskId, iContextId );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Implementation of TaskMgrWS
+//
+///////////////////////////////////////////////////////////////////////////////
+
+TaskMgrWS::TaskMgrWS() : miDemoModeThreadCountOverride(-1), muNextFreeSet(0)
+{
+}
+
+TaskMgrWS::~TaskMgrWS()
+{
+}
+
+BOOL TaskMgrWS::Init()
+{
+    mTaskScheduler.Init( &TaskMgrWS::ExecuteTask, this, miDemoModeThreadCountOverride );
+
+    //  Reset thread override demo variable.
+    miDemoModeThreadCountOverride = -1;
+
+    return TRUE;
+}
+
+VOID TaskMgrWS::Shutdown()
+{
+    //
+    //  Release any left-over tasksets
+    for( UINT uSet = 0; uSet < MAX_TASKSETS; ++uSet )
+    {
+        if( mSets[ uSet ].mpFunc )
+        {
+            WaitForSet( uSet );
+        }
+    }
+
+    mTaskScheduler.Shutdown();
+}
+
+
+BOOL TaskMgrWS::CreateTaskSet(TASKSETFUNC     pFunc,
+                              VOID*           pArg,
+                              UINT            uTaskCount,
+                              TASKSETHANDLE*  pDepends,
+                              UINT            uDepends,
+                              OPTIONAL LPCSTR szSetName,
+                              TASKSETHANDLE*  pOutHandle )
+{
+    TASKSETHANDLE           hSet;
+
+    //  Validate incomming parameters
+    if( 0 == uTaskCount || NULL == pFunc )
+    {
+        return FALSE;
+    }
+
+    //  The scheduler packs task indices in 24 bits, larger sets would
+    //  silently lose tasks
+    assert( uTaskCount <= TaskSchedulerWS::MAX_TASKS );
+
+    if( uTaskCount > TaskSchedulerWS::MAX_TASKS )
+    {
+        return FALSE;
+    }
+
+    //
+    //  Allocate and setup the internal taskset
+    //
+    hSet = AllocateTaskSet();
+
+    TaskSet* pSet = &mSets[ hSet ];
+
+    //  NOTE: one refcount is owned by the tasking system the other
+    //  by the caller.  One start count is held while the dependencies
+    //  are registered so the set cannot be scheduled half way through.
+    pSet->miRefCount        = 2;
+    pSet->miStartCount      = uDepends + 1;
+    pSet->mpvArg            = pArg;
+    pSet->muSize            = uTaskCount;
+    pSet->miCompletionCount = uTaskCount;
+    pSet->mhTaskset         = hSet;
+    pSet->mpFunc            = pFunc;
+    pSet->mbCompleted       = false;
+
+#ifdef PROFILEGPA
+    //
+    //  Track task name if profiling is enabled
+    if( szSetName )
+    {
+        StringCbCopyA(
+            pSet->mszSetName,
+            sizeof( pSet->mszSetName ),
+            szSetName );
+    }
+    else
+    {
+        StringCbCopyA(
+            pSet->mszSetName,
+            sizeof( pSet->mszSetName ),
+            "Unnamed Task" );
+    }
+#else
+    UNREFERENCED_PARAMETER( szSetName );
+#endif // PROFILEGPA
+
+    //
+    //  Iterate over the dependency list and setup the successor
+    //  pointers in each parent to point to this taskset.
+    //
+    for( UINT uDepend = 0; uDepend < uDepends; ++uDepend )
+    {
+        TASKSETHANDLE hDependsOn = pDepends[ uDepend ];
+
+        if( hDependsOn == TASKSETHANDLE_INVALID )
+        {
+            --pSet->miStartCount;
+            continue;
+        }
+
+        TaskSet* pDependsOn = &mSets[ hDependsOn ];
+
+        //
+        //  A taskset with a new successor is consider incomplete even if it
+        //  already has completed.  This mechanism allows us tasksets that are
+        //  already done to appear active and capable of spawning successors.
+        //
+        int iPrevCompletion = pDependsOn->miCompletionCount.fetch_add( 1 );
+
+        if( 0 == iPrevCompletion )
+        {
+            //  The dependency taskset was already completed and has released
+            //  the refcount of the tasking system.  Addref the taskset since
+            //  the next Completion will release it again.
+            //
+            //  NOTE: There is no race conditon here since the caller must still
+            //  hold a reference to the depenent taskset which was passed in.
+            ++pDependsOn->miRefCount;
+        }
+
+        UINT uSuccessor;
+        {
+            std::lock_guard<std::mutex> lock( pDependsOn->mSuccessorsLock );
+
+            for( uSuccessor = 0; uSuccessor < MAX_SUCCESSORS; ++uSuccessor )
+            {
+                if( NULL == pDependsOn->Successors[ uSuccessor ] )
+                {
+                    pDependsOn->Successors[ uSuccessor ] = pSet;
+                    break;
+                }
+            }
+        }
+
+        //
+        //  If the successor list is full we have a problem.  The app
+        //  needs to give us more space by increasing MAX_SUCCESSORS
+        //
+        if( uSuccessor == MAX_SUCCESSORS )
+        {
+            printf( "Too many successors for this task set.\nIncrease MAX_SUCCESSORS\n" );
+            return FALSE;
+        }
+
+        //
+        //  Mark the set as completed for the successor adding operation.
+        //
+        CompleteTaskSet( hDependsOn );
+    }
+
+    //
+    //  Release the start count held during setup, scheduling the set if
+    //  all of its dependencies have already completed.
+    //
+    if( 0 == --pSet->miStartCount )
+    {
+        mTaskScheduler.AddTaskSet( hSet, uTaskCount );
+    }
+
+    //  Set output taskset handle
+    *pOutHandle = hSet;
+
+    return TRUE;
+}
+
+VOID TaskMgrWS::ReleaseHandle( TASKSETHANDLE hSet )
+{
+    --mSets[ hSet ].miRefCount;
+}
+
+
+VOID TaskMgrWS::ReleaseHandles( TASKSETHANDLE *phSet,UINT uSet )
+{
+    for( UINT uIdx = 0; uIdx < uSet; ++uIdx )
+    {
+        ReleaseHandle( phSet[ uIdx ] );
+    }
+}
+
+VOID TaskMgrWS::WaitForSet( TASKSETHANDLE hSet )
+{
+    //
+    //  Help executing tasks until our taskset is done.
+    //
+    if( !mSets[ hSet ].mbCompleted )
+    {
+        mTaskScheduler.WaitForFlag( &mSets[ hSet ].mbCompleted );
+    }
+}
+
+BOOL
+TaskMgrWS::IsSetComplete( TASKSETHANDLE hSet )
+{
+    return mSets[ hSet ].mbCompleted ? TRUE : FALSE;
+}
+
+
+TASKSETHANDLE TaskMgrWS::AllocateTaskSet()
+{
+    UINT                        uSet = muNextFreeSet;
+
+    //
+    //  Find a slot in the TaskMgrWS for a new task set.
+    //
+    //  NOTE: if we have too many tasks pending we will spin on the slot.  If
+    //  spinning occures, see TaskMgrCommon.h and increase MAX_TASKSETS
+    //
+    while( NULL != mSets[ uSet ].mpFunc || mSets[ uSet ].miRefCount != 0 )
+    {
+        uSet = ( uSet + 1 ) % MAX_TASKSETS;
+    }
+
+    muNextFreeSet = ( uSet + 1 ) % MAX_TASKSETS;
+
+    return (TASKSETHANDLE)uSet;
+}
+
+VOID TaskMgrWS::CompleteTaskSet( TASKSETHANDLE hSet )
+{
+    TaskSet*             pSet = &mSets[ hSet ];
+
+    if( 0 == --pSet->miCompletionCount )
+    {
+        //
+        //  The task set has completed.  We need to look at the successors
+        //  and signal them that this dependency of theirs has completed.
+        //
+        TaskSet* pReady[ MAX_SUCCESSORS ];
+        UINT     uReady = 0;
+
+        {
+            std::lock_guard<std::mutex> lock( pSet->mSuccessorsLock );
+
+            for( UINT uSuccessor = 0; uSuccessor < MAX_SUCCESSORS; ++uSuccessor )
+            {
+                TaskSet* pSuccessor = pSet->Successors[ uSuccessor ];
+
+                //
+                //  A signaled successor must be removed from the Successors list
+                //  before the mSuccessorsLock can be released.
+                //
+                pSet->Successors[ uSuccessor ] = NULL;
+
+                //
+                //  If the start count is 0 the successor has had all its
+                //  dependencies satisified and can be scheduled.
+                //
+                if( NULL != pSuccessor && 0 == --pSuccessor->miStartCount )
+                {
+                    pReady[ uReady++ ] = pSuccessor;
+                }
+            }
+        }
+
+        pSet->mpFunc = 0;
+        pSet->mbCompleted.store( true, std::memory_order_release );
+
+        //
+        //  Spawn outside of the lock; the successors go on the deque of
+        //  this thread and are stolen from there by the idle threads.
+        //
+        for( UINT uIdx = 0; uIdx < uReady; ++uIdx )
+        {
+            mTaskScheduler.AddTaskSet( pReady[ uIdx ]->mhTaskset, pReady[ uIdx ]->muSize );
+        }
+
+        ReleaseHandle( hSet );
+    }
+}
@@ -0,0 +1,179 @@
+/*!
+    \file TaskMgrWS.h
+
+    TaskMgrWS is a class that uses a portable work-stealing scheduler with a
+    C-style handle and callback mechanism for scheduling tasks across any
+    number of CPU cores.
+
+    TaskMgrWS is a singleton object and is already instantiated for the app as
+    gTaskMgrWS.  Like the other task managers, tasksets are created from the
+    thread that called Init, or from within running tasks; successors spawned
+    by a task end up on the deque of the worker that completed the dependency.
+    The app can control two knobs in the TaskMgrWS class through MAX_SUCCESSORS
+    and MAX_TASKSETS defined in TaskMgrCommon.h (see TaskMgrSS.h for details).
+
+    Unlike TaskMgrSS, which hands whole task sets to the workers round-robin
+    from a central queue, TaskMgrWS recursively splits each task set over the
+    per-thread deques of TaskSchedulerWS.  Idle threads steal the larger halves,
+    so task sets with uneven tasks (e.g. the binning and per-tile rasterization
+    of the depth buffer) are balanced across the cores.  WaitForSet lets the
+    waiting thread execute tasks instead of blocking.
+
+    Copyright 2011 Intel Corporation
+    All Rights Reserved
+
+    Permission is granted to use, copy, distribute and prepare derivative works of this
+    software for any purpose and without fee, provided, that the above copyright notice
+    and this statement appear in all copies.  Intel makes no representations about the
+    suitability of this software for any purpose.  THIS SOFTWARE IS PROVIDED ""AS IS.""
+    INTEL SPECIFICALLY DISCLAIMS ALL WARRANTIES, EXPRESS OR IMPLIED, AND ALL LIABILITY,
+    INCLUDING CONSEQUENTIAL AND OTHER INDIRECT DAMAGES, FOR THE USE OF THIS SOFTWARE,
+    INCLUDING LIABILITY FOR INFRINGEMENT OF ANY PROPRIETARY RIGHTS, AND INCLUDING THE
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.  Intel does not
+    assume any responsibility for any errors which may appear in this software nor any
+    responsibility to update it.
+*/
+#pragma once
+
+#include <wtypes.h>
+
+#include <atomic>
+#include <mutex>
+
+#include "Profile.h"
+#include "TaskMgrCommon.h"
+
+  // DYAMIC_BASE is used when the SampleComponents have dynamic
+  // switching between schedulers enabled. When either using this
+  // as a stand alone module or with a static scheduler is does
+  // nothing.
+#ifndef  DYNAMIC_BASE
+#   define DYNAMIC_BASE
+#endif
+
+#include "TaskSchedulerWS.h"
+
+/*! The TaskMgrWS allows the user to schedule tasksets on top of the
+    work-stealing TaskSchedulerWS.  All TaskMgrWS functions are NOT
+    threadsafe.  TaskMgrWS is designed to be called only from the main
+    thread.  Multi-threading is achieved by creating TaskSets that
+    execute on threads created by the scheduler.
+*/
+class TaskMgrWS DYNAMIC_BASE
+{
+public:
+    TaskMgrWS();
+    ~TaskMgrWS();
+
+    //  Init will setup the tasking system.  It must be called before
+    //  any other functions on the TaskMgrWS interface.
+    BOOL
+        Init();
+
+    //  Shutdown will stop the tasking system. Any outstanding tasks will
+    //  be waited for and the worker threads will be released.
+    VOID
+        Shutdown();
+
+    //  Creates a task set and provides a handle to allow the application
+    //  CreateTaskSet can fail if, by adding this task to the successor lists
+    //  of its dependecies the list exceeds MAX_SUCCESSORS.  To fix, increase
+    //  MAX_SUCCESSORS.  It also fails for more than TaskSchedulerWS::MAX_TASKS
+    //  tasks.
+    //
+    //  NOTE: A tasket of size 1 is valid.  The most common case is to have
+    //  tasksets of >> 1 so the default tasking primitive is a taskset rather
+    //  than a task.
+    BOOL  CreateTaskSet(TASKSETFUNC                 pFunc,        //  Function pointer to the
+                                                                  //  Taskset callback function
+                        VOID*                       pArg,         //  App data pointer (can be NULL)
+                        UINT                        uTaskCount,   //  Number of tasks to create
+                        TASKSETHANDLE*              pDepends,     //  Array of TASKSETHANDLEs that
+                                                                  //  this taskset depends on.  The
+                                                                  //  taskset will not be scheduled
+                                                                  //  until all tasksets in this list
+                                                                  //  complete.
+                        UINT                        uDepends,     //  Count of the depends list
+                        OPTIONAL LPCSTR             szSetName,    //  [Optional] name of the taskset
+                                                                  //  the name is used for profiling
+                        OUT TASKSETHANDLE*          pOutHandle);  //  [Out] Handle to the new taskset
+
+    //  All TASKSETHANDLE must be released when no longer referenced.
+    //  ReleaseHandle will release the Applications reference on the taskset.
+    //  It should only be called once per handle returned from CreateTaskSet.
+    VOID ReleaseHandle( TASKSETHANDLE hSet );        //  Taskset handle to release
+
+    //  All TASKSETHANDLE must be released when no longer referenced.
+    //  ReleaseHandles will release the Applications reference on the array
+    //  of taskset handled specified.  It should only be called once per handle
+    //  returned from CreateTaskSet.
+    VOID ReleaseHandles( TASKSETHANDLE* phSet,  //  Taskset handle array to release
+                         UINT uSet );           //  count of taskset handle array
+
+    //  WaitForSet will make the calling thread execute tasks and return
+    //  only when the taskset specified has completed execution.
+    VOID WaitForSet( TASKSETHANDLE hSet );      // Taskset to wait for completion
+
+    //  IsSetComplete simple checks to see if the given taskset has completed. It
+    //  does not block.
+    BOOL IsSetComplete( TASKSETHANDLE hSet );    // Taskset to check completion of
+
+    //  DEMO ONLY: set variable before calling init to the
+    //  number of worker threads WS should create.  Changing this value will
+    //  result in inaccurate performance timings.
+    INT miDemoModeThreadCountOverride;
+private:
+
+    class TaskSet
+    {
+    public:
+        TaskSet();
+
+          // Executes a single task on a thread identified by iContextId
+        void Execute(UINT uTaskId, INT iContextId);
+
+          // Data and callback for the Task to execute
+        TASKSETFUNC             mpFunc;
+        void*                   mpvArg;
+        UINT                    muSize;
+        TASKSETHANDLE           mhTaskset;
+
+          // Interal bookkeeping for for managing the TaskSet
+        std::atomic<bool>       mbCompleted;
+        std::atomic<int>        miRefCount;
+        std::atomic<int>        miStartCount;
+        std::atomic<int>        miCompletionCount;
+
+          // Lock to keep threads from destroying the successor list
+        std::mutex              mSuccessorsLock;
+        TaskSet*                Successors[ MAX_SUCCESSORS ];
+
+        CHAR                    mszSetName[ MAX_TASKSETNAMELENGTH ];
+    };
+
+      // Entry point for the scheduler
+    static void ExecuteTask( void* pOwner, unsigned int hSet, unsigned int uTaskId, int iContextId );
+
+    //  INTERNAL:
+    //  Allocate a free slot in the mSets list
+    TASKSETHANDLE AllocateTaskSet();
+
+    //  INTERNAL:
+    //  Called by the tasking system when a task in a set completes.
+    VOID CompleteTaskSet( TASKSETHANDLE hSet );
+
+
+    //  Array containing the WS task parents.
+    TaskSet mSets[ MAX_TASKSETS ];
+
+    //  Helper array index of next free task slot.
+    UINT muNextFreeSet;
+
+    //  The work-stealing task scheduler
+    TaskSchedulerWS mTaskScheduler;
+};
+
+//
+//  Forward decl of the TaskMgrWS instance defined in TaskMgrWS.cpp
+//
+extern TaskMgrWS   gTaskMgrWS;
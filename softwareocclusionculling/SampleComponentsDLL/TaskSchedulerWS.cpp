@@ -0,0 +1,367 @@
+/*!
+    \file TaskSchedulerWS.cpp
+
+    TaskSchedulerWS is a work-stealing scheduler that manages the distribution of
+    tasks among the worker threads and the lifetime of the worker threads.
+
+    Copyright 2011 Intel Corporation
+    All Rights Reserved
+
+    Permission is granted to use, copy, distribute and prepare derivative works of this
+    software for any purpose and without fee, provided, that the above copyright notice
+    and this statement appear in all copies.  Intel makes no representations about the
+    suitability of this software for any purpose.  THIS SOFTWARE IS PROVIDED ""AS IS.""
+    INTEL SPECIFICALLY DISCLAIMS ALL WARRANTIES, EXPRESS OR IMPLIED, AND ALL LIABILITY,
+    INCLUDING CONSEQUENTIAL AND OTHER INDIRECT DAMAGES, FOR THE USE OF THIS SOFTWARE,
+    INCLUDING LIABILITY FOR INFRINGEMENT OF ANY PROPRIETARY RIGHTS, AND INCLUDING THE
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.  Intel does not
+    assume any responsibility for any errors which may appear in this software nor any
+    responsibility to update it.
+
+*/
+
+#include "TaskSchedulerWS.h"
+
+namespace
+{
+      // Number of unsuccessful searches for work before a worker goes to sleep
+    const int SPIN_COUNT_BEFORE_SLEEP = 64;
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#   define WS_THREAD_LOCAL __declspec(thread)
+#else
+#   define WS_THREAD_LOCAL thread_local
+#endif
+
+      // Context of the calling thread, -1 for threads unknown to the scheduler
+    WS_THREAD_LOCAL int tlsContextId = -1;
+
+      // State of the victim selection of the calling thread
+    WS_THREAD_LOCAL unsigned int tlsRandomState = 0;
+
+    inline TASKRANGE MakeRange( unsigned int hSet, unsigned int uBegin, unsigned int uEnd )
+    {
+        return ( (TASKRANGE)( hSet & 0xFFFF ) << 48 ) | ( (TASKRANGE)( uBegin & 0xFFFFFF ) << 24 ) | (TASKRANGE)( uEnd & 0xFFFFFF );
+    }
+
+    inline unsigned int RangeSet( TASKRANGE range )   { return (unsigned int)( range >> 48 ); }
+    inline unsigned int RangeBegin( TASKRANGE range ) { return (unsigned int)( range >> 24 ) & 0xFFFFFF; }
+    inline unsigned int RangeEnd( TASKRANGE range )   { return (unsigned int)range & 0xFFFFFF; }
+
+      // Cheap per-thread random victim selection
+    inline unsigned int NextRandom( unsigned int& uState )
+    {
+        uState ^= uState << 13;
+        uState ^= uState >> 17;
+        uState ^= uState << 5;
+        return uState;
+    }
+}
+
+// WorkStealingDeque implementation
+
+WorkStealingDeque::WorkStealingDeque()
+: miTop( 0 )
+, miBottom( 0 )
+{
+    for( int i = 0; i < CAPACITY; ++i )
+    {
+        mRanges[ i ].store( 0, std::memory_order_relaxed );
+    }
+}
+
+bool WorkStealingDeque::Push( TASKRANGE range )
+{
+    int64_t b = miBottom.load( std::memory_order_relaxed );
+    int64_t t = miTop.load( std::memory_order_acquire );
+
+    if( b - t >= CAPACITY )
+    {
+        return false;
+    }
+
+    mRanges[ b & ( CAPACITY - 1 ) ].store( range, std::memory_order_relaxed );
+    miBottom.store( b + 1, std::memory_order_release );
+    return true;
+}
+
+bool WorkStealingDeque::Pop( TASKRANGE* pRange )
+{
+    int64_t b = miBottom.load( std::memory_order_relaxed ) - 1;
+    miBottom.store( b, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    int64_t t = miTop.load( std::memory_order_relaxed );
+
+    if( t > b )
+    {
+          // Empty, restore the bottom
+        miBottom.store( b + 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    *pRange = mRanges[ b & ( CAPACITY - 1 ) ].load( std::memory_order_relaxed );
+
+    if( t == b )
+    {
+          // Last element, race against the thieves for it
+        bool bWon = miTop.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+        miBottom.store( b + 1, std::memory_order_relaxed );
+        return bWon;
+    }
+
+    return true;
+}
+
+bool WorkStealingDeque::Steal( TASKRANGE* pRange )
+{
+    int64_t t = miTop.load( std::memory_order_acquire );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    int64_t b = miBottom.load( std::memory_order_acquire );
+
+    if( t >= b )
+    {
+        return false;
+    }
+
+    TASKRANGE range = mRanges[ t & ( CAPACITY - 1 ) ].load( std::memory_order_relaxed );
+
+    if( !miTop.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+    {
+        return false;
+    }
+
+    *pRange = range;
+    return true;
+}
+
+// TaskSchedulerWS implementation
+
+TaskSchedulerWS::TaskSchedulerWS()
+: mpExecute( 0 )
+, mpOwner( 0 )
+, miThreadCount( 0 )
+, mpThreads( 0 )
+, mpDeques( 0 )
+, mbInitialized( false )
+, miTaskCount( 0 )
+, miSleeping( 0 )
+, mbAlive( false )
+{
+}
+
+  // Initializes the Sheduler and creates the worker threads
+void TaskSchedulerWS::Init( TASKEXECUTEFUNC pExecute, void* pOwner, int thread_count )
+{
+      // If the scheduler is still running, ignore this
+    if( mbInitialized ) return;
+
+    mpExecute = pExecute;
+    mpOwner = pOwner;
+    miTaskCount = 0;
+    miSleeping = 0;
+    mbAlive = true;
+    mbInitialized = true;
+
+      // Get the number of worker threads that will be available
+    if( thread_count == MAX_THREADS )
+    {
+          // Leave one core for the main thread.
+        int iProcCount = (int)std::thread::hardware_concurrency();
+        miThreadCount = iProcCount > 1 ? iProcCount - 1 : 0;
+    }
+    else
+    {
+        miThreadCount = thread_count;
+    }
+
+    mpDeques = new WorkStealingDeque[ miThreadCount + 1 ];
+
+      // The context ID for the main thread is 0.
+    tlsContextId = 0;
+
+    mpThreads = miThreadCount ? new std::thread[ miThreadCount ] : 0;
+    for( int iThread = 0; iThread < miThreadCount; ++iThread )
+    {
+        mpThreads[ iThread ] = std::thread( &TaskSchedulerWS::ThreadMain, this, iThread + 1 );
+    }
+}
+
+  // Clean up the worker threads and associated data
+void TaskSchedulerWS::Shutdown()
+{
+    if( !mbInitialized ) return;
+
+      // Tell all of the threads to break out of their loops and wake the sleeping ones
+    {
+        std::lock_guard<std::mutex> lock( mSleepLock );
+        mbAlive = false;
+    }
+    mTaskAvailable.notify_all();
+
+    for( int iThread = 0; iThread < miThreadCount; ++iThread )
+    {
+        mpThreads[ iThread ].join();
+    }
+
+    delete [] mpThreads;
+    delete [] mpDeques;
+    mpThreads = 0;
+    mpDeques = 0;
+    miThreadCount = 0;
+    mbInitialized = false;
+}
+
+  // Main loop for the worker threads
+void TaskSchedulerWS::ThreadMain( int iContextId )
+{
+    tlsContextId = iContextId;
+
+    int iSpins = 0;
+
+    while( mbAlive.load( std::memory_order_relaxed ) )
+    {
+        TASKRANGE range;
+
+        if( FindWork( iContextId, &range ) )
+        {
+            ExecuteRange( iContextId, range );
+            iSpins = 0;
+        }
+        else if( ++iSpins < SPIN_COUNT_BEFORE_SLEEP || miTaskCount.load() > 0 )
+        {
+              // Work is either in flight or about to show up, keep looking for it
+            std::this_thread::yield();
+        }
+        else
+        {
+              // or sleep if all of the work has been completed
+            std::unique_lock<std::mutex> lock( mSleepLock );
+            ++miSleeping;
+            mTaskAvailable.wait( lock, [this]() { return miTaskCount.load() > 0 || !mbAlive.load(); } );
+            --miSleeping;
+            iSpins = 0;
+        }
+    }
+
+    tlsContextId = -1;
+}
+
+  // Threads without a context (iContextId < 0) can only steal
+bool TaskSchedulerWS::FindWork( int iContextId, TASKRANGE* pRange )
+{
+    if( iContextId >= 0 && mpDeques[ iContextId ].Pop( pRange ) )
+    {
+        return true;
+    }
+
+      // Start at a random victim so thieves do not all hit the same deque
+    if( tlsRandomState == 0 )
+    {
+        tlsRandomState = 0x9E3779B9u * (unsigned int)( iContextId + 2 );
+    }
+
+    const int iContextCount = miThreadCount + 1;
+    const int iFirst = (int)( NextRandom( tlsRandomState ) % (unsigned int)iContextCount );
+
+    for( int i = 0; i < iContextCount; ++i )
+    {
+        int iVictim = ( iFirst + i ) % iContextCount;
+        if( iVictim != iContextId && mpDeques[ iVictim ].Steal( pRange ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TaskSchedulerWS::ExecuteRange( int iContextId, TASKRANGE range )
+{
+    unsigned int hSet   = RangeSet( range );
+    unsigned int uBegin = RangeBegin( range );
+    unsigned int uEnd   = RangeEnd( range );
+
+      // Keep the lower half and expose the upper half to the thieves,
+      // until a single task is left.  If the deque is full, or the thread
+      // has no deque, the remaining tasks are simply executed here.
+    bool bPushed = false;
+    while( iContextId >= 0 && uEnd - uBegin > 1 )
+    {
+        unsigned int uMiddle = uBegin + ( uEnd - uBegin ) / 2;
+        if( !mpDeques[ iContextId ].Push( MakeRange( hSet, uMiddle, uEnd ) ) )
+        {
+            break;
+        }
+        uEnd = uMiddle;
+        bPushed = true;
+    }
+
+    if( bPushed )
+    {
+        WakeWorkers();
+    }
+
+      // Threads unknown to the scheduler report the main thread context, as
+      // only the main thread is expected to drive the task manager.
+    int iTaskContextId = iContextId < 0 ? 0 : iContextId;
+
+    for( unsigned int uTask = uBegin; uTask < uEnd; ++uTask )
+    {
+        mpExecute( mpOwner, hSet, uTask, iTaskContextId );
+        miTaskCount.fetch_sub( 1 );
+    }
+}
+
+  // Adds a task set to the deque of the calling thread
+void TaskSchedulerWS::AddTaskSet( unsigned int hSet, unsigned int uTaskCount )
+{
+    assert( uTaskCount <= MAX_TASKS );
+
+      // Increase the Task Count before adding the tasks to keep the
+      // workers from going to sleep during this process
+    miTaskCount.fetch_add( (int)uTaskCount );
+
+    int iContextId = tlsContextId;
+
+    if( iContextId < 0 || !mpDeques[ iContextId ].Push( MakeRange( hSet, 0, uTaskCount ) ) )
+    {
+          // Threads that do not own a deque, or a full deque, run the set inline
+        ExecuteRange( iContextId, MakeRange( hSet, 0, uTaskCount ) );
+        return;
+    }
+
+    WakeWorkers();
+}
+
+void TaskSchedulerWS::WakeWorkers()
+{
+    if( miSleeping.load() > 0 )
+    {
+        std::lock_guard<std::mutex> lock( mSleepLock );
+        mTaskAvailable.notify_all();
+    }
+}
+
+  // Executes tasks on the calling thread when it needs to wait for a Task Set to be completed
+void TaskSchedulerWS::WaitForFlag( const std::atomic<bool>* pFlag )
+{
+    int iContextId = tlsContextId;
+
+      // The loop will break with no more than one task being executed,
+      // returning the waiting thread as soon as possible.
+    while( !pFlag->load( std::memory_order_acquire ) )
+    {
+        TASKRANGE range;
+
+        if( FindWork( iContextId, &range ) )
+        {
+            ExecuteRange( iContextId, range );
+        }
+        else
+        {
+              // The waiting thread needs to stay alert, so it yields until
+              // the condition is met or more work is added.
+            std::this_thread::yield();
+        }
+    }
+}
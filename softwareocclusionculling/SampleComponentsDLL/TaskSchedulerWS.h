@@ -0,0 +1,147 @@
+/*!
+    \file TaskSchedulerWS.h
+
+    TaskSchedulerWS is a work-stealing scheduler that manages the distribution of
+    tasks among the worker threads and the lifetime of the worker threads. It is
+    created and used by the TaskMgrWS.
+
+    Every thread (the main thread and each worker) owns a Chase-Lev deque of
+    task ranges.  A thread pushes and pops ranges at the bottom of its own deque
+    while idle threads steal from the top of the other deques.  A range is split
+    in half on execution and the upper half is pushed back, so big task sets
+    spread over all threads and uneven tasks are load-balanced automatically.
+
+    The scheduler only uses the C++11 standard library and has no dependency
+    on the Windows threading API.
+
+    Copyright 2011 Intel Corporation
+    All Rights Reserved
+
+    Permission is granted to use, copy, distribute and prepare derivative works of this
+    software for any purpose and without fee, provided, that the above copyright notice
+    and this statement appear in all copies.  Intel makes no representations about the
+    suitability of this software for any purpose.  THIS SOFTWARE IS PROVIDED ""AS IS.""
+    INTEL SPECIFICALLY DISCLAIMS ALL WARRANTIES, EXPRESS OR IMPLIED, AND ALL LIABILITY,
+    INCLUDING CONSEQUENTIAL AND OTHER INDIRECT DAMAGES, FOR THE USE OF THIS SOFTWARE,
+    INCLUDING LIABILITY FOR INFRINGEMENT OF ANY PROPRIETARY RIGHTS, AND INCLUDING THE
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.  Intel does not
+    assume any responsibility for any errors which may appear in this software nor any
+    responsibility to update it.
+
+*/
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+  // Use to give variable their own cache line to prevent false sharing
+#if defined(_MSC_VER)
+#   define WS_CACHE_ALIGN __declspec(align(64))
+#else
+#   define WS_CACHE_ALIGN __attribute__((aligned(64)))
+#endif
+
+#if defined(_MSC_VER)
+#pragma warning ( push )
+#pragma warning ( disable : 4324 ) // skip warning on structure padding.
+#endif
+
+  // A task range packed in 64 bits: the task set handle and the
+  // [begin, end) interval of task indices that still have to run.
+typedef uint64_t TASKRANGE;
+
+  // Lock-free single owner, multiple thief deque (Chase and Lev, 2005; with the
+  // C11 memory model orderings from Le et al., 2013).  The capacity is fixed;
+  // Push fails when the deque is full and the caller runs the range inline.
+class WorkStealingDeque
+{
+public:
+    static const int CAPACITY = 1024;
+
+    WorkStealingDeque();
+
+      // Owner only: adds a range at the bottom
+    bool Push( TASKRANGE range );
+
+      // Owner only: removes the most recently pushed range
+    bool Pop( TASKRANGE* pRange );
+
+      // Any thread: removes the oldest range
+    bool Steal( TASKRANGE* pRange );
+
+private:
+    WS_CACHE_ALIGN std::atomic<int64_t>  miTop;
+    WS_CACHE_ALIGN std::atomic<int64_t>  miBottom;
+    WS_CACHE_ALIGN std::atomic<uint64_t> mRanges[ CAPACITY ];
+};
+
+  // Callback used by the scheduler to run a single task of a task set.
+  // It returns after the task was executed and its completion was recorded.
+typedef void (*TASKEXECUTEFUNC)( void* pOwner, unsigned int hSet, unsigned int uTaskId, int iContextId );
+
+class TaskSchedulerWS
+{
+public:
+      // Constant to pass to the Init method
+    static const int MAX_THREADS = -1;
+
+      // Largest task count of a task set, begin and end of a range take 24 bits each
+    static const unsigned int MAX_TASKS = 0xFFFFFF;
+
+    TaskSchedulerWS();
+
+      // Sets up the deques and the worker threads.  The calling thread becomes
+      // context 0 and is the only thread that may add task sets from outside a task.
+    void Init( TASKEXECUTEFUNC pExecute, void* pOwner, int thread_count = MAX_THREADS );
+
+      // Shuts down the scheduler and joins the threads
+    void Shutdown();
+
+      // Schedules the tasks [0, uTaskCount) of the task set on the deque of the
+      // calling thread.  Idle threads steal them from there.  uTaskCount must
+      // not exceed MAX_TASKS.
+    void AddTaskSet( unsigned int hSet, unsigned int uTaskCount );
+
+      // Makes the calling thread execute tasks until *pFlag becomes true
+      // instead of blocking.
+    void WaitForFlag( const std::atomic<bool>* pFlag );
+
+private:
+    void ThreadMain( int iContextId );
+
+      // Pops from the own deque first, then tries to steal from the others
+    bool FindWork( int iContextId, TASKRANGE* pRange );
+
+      // Splits the range until a single task is left and runs it
+    void ExecuteRange( int iContextId, TASKRANGE range );
+
+    void WakeWorkers();
+
+    TASKEXECUTEFUNC     mpExecute;
+    void*               mpOwner;
+
+      // Number of worker threads, not counting the main thread
+    int                 miThreadCount;
+    std::thread*        mpThreads;
+      // One deque per context, index 0 belongs to the main thread
+    WorkStealingDeque*  mpDeques;
+    bool                mbInitialized;
+
+      // Sleeping support for the worker threads
+    std::mutex              mSleepLock;
+    std::condition_variable mTaskAvailable;
+
+      // These variables are padded to be placed in individual cache lines, preventing
+      // false sharing during interlocked operations.
+    WS_CACHE_ALIGN std::atomic<int>  miTaskCount;
+    WS_CACHE_ALIGN std::atomic<int>  miSleeping;
+    WS_CACHE_ALIGN std::atomic<bool> mbAlive;
+};
+
+#if defined(_MSC_VER)
+#pragma warning ( pop )
+#endif
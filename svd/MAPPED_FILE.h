@@ -0,0 +1,179 @@
+//#####################################################################
+// Class MAPPED_FILE
+//#####################################################################
+// A file accessed through windows of memory mapped pages. Only the windows
+// in use are mapped, so a file of any size is processed with constant memory:
+// a window is unmapped when it is destroyed, the dirty pages of an output
+// file are left to the page cache and written back by the operating system.
+// Windows may start at any byte offset, the mapping itself starts at the
+// allocation granularity below it.
+//#####################################################################
+#ifndef __MAPPED_FILE__
+#define __MAPPED_FILE__
+#include <stddef.h>
+#include <stdint.h>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace PhysBAM{
+
+class MAPPED_FILE
+{
+#ifdef _WIN32
+    HANDLE file,mapping;
+#else
+    int file;
+#endif
+    uint64_t size;
+    bool writable;
+
+public:
+    class WINDOW
+    {
+        friend class MAPPED_FILE;
+        void* base;
+        size_t length;
+        char* data;
+
+        WINDOW(const WINDOW&);
+        void operator=(const WINDOW&);
+    public:
+        WINDOW()
+            :base(0),length(0),data(0)
+        {}
+
+        ~WINDOW()
+        {Unmap();}
+
+        template<class T> T* Pointer() const
+        {return reinterpret_cast<T*>(data);}
+
+        void Unmap()
+        {
+            if(!base) return;
+#ifdef _WIN32
+            UnmapViewOfFile(base);
+#else
+            munmap(base,length);
+#endif
+            base=0;length=0;data=0;
+        }
+
+        // asks the operating system to read the pages ahead, while the thread works on another window
+        void Prefetch() const
+        {
+            if(!base) return;
+#ifdef _WIN32
+#if _WIN32_WINNT>=0x0602
+            WIN32_MEMORY_RANGE_ENTRY range;range.VirtualAddress=base;range.NumberOfBytes=length;
+            PrefetchVirtualMemory(GetCurrentProcess(),1,&range,0);
+#endif
+#else
+            madvise(base,length,MADV_WILLNEED);
+#endif
+        }
+    };
+
+    // opens an existing file for reading, or creates (truncates) a file of new_size bytes for writing
+    MAPPED_FILE(const char* name,const bool write=false,const uint64_t new_size=0)
+        :size(0),writable(write)
+    {
+#ifdef _WIN32
+        mapping=0;
+        file=CreateFileA(name,write?GENERIC_READ|GENERIC_WRITE:GENERIC_READ,FILE_SHARE_READ,0,write?CREATE_ALWAYS:OPEN_EXISTING,FILE_FLAG_SEQUENTIAL_SCAN,0);
+        if(file==INVALID_HANDLE_VALUE){file=0;return;}
+        LARGE_INTEGER file_size;
+        if(write){
+            file_size.QuadPart=(LONGLONG)new_size;
+            if(!SetFilePointerEx(file,file_size,0,FILE_BEGIN) || !SetEndOfFile(file)){Close();return;}}
+        else if(!GetFileSizeEx(file,&file_size)){Close();return;}
+        size=(uint64_t)file_size.QuadPart;
+        // a mapping of an empty file fails, an empty file has no windows anyway
+        if(size) mapping=CreateFileMappingA(file,0,write?PAGE_READWRITE:PAGE_READONLY,(DWORD)(size>>32),(DWORD)size,0);
+        if(size && !mapping) Close();
+#else
+        file=write?open(name,O_RDWR|O_CREAT|O_TRUNC,0644):open(name,O_RDONLY);
+        if(file<0) return;
+        if(write && ftruncate(file,(off_t)new_size)!=0){Close();return;}
+        struct stat status;
+        if(fstat(file,&status)!=0){Close();return;}
+        size=(uint64_t)status.st_size;
+#endif
+    }
+
+    ~MAPPED_FILE()
+    {Close();}
+
+    bool Valid() const
+    {
+#ifdef _WIN32
+        return file!=0;
+#else
+        return file>=0;
+#endif
+    }
+
+    uint64_t Size() const
+    {return size;}
+
+    // maps the bytes [offset,offset+bytes) of the file into window, returns false on failure
+    bool Map(WINDOW& window,const uint64_t offset,const size_t bytes) const
+    {
+        window.Unmap();
+        if(!Valid() || !bytes || offset+bytes>size) return false;
+        const uint64_t granularity=Allocation_Granularity();
+        const uint64_t begin=offset/granularity*granularity;
+        const size_t length=(size_t)(offset-begin)+bytes;
+#ifdef _WIN32
+        void* base=MapViewOfFile(mapping,writable?FILE_MAP_WRITE:FILE_MAP_READ,(DWORD)(begin>>32),(DWORD)begin,length);
+        if(!base) return false;
+#else
+        int flags=MAP_SHARED;
+#ifdef MAP_POPULATE
+        // the pages are faulted in by one call instead of one fault per page in the kernels
+        flags|=MAP_POPULATE;
+#endif
+        void* base=mmap(0,length,writable?PROT_READ|PROT_WRITE:PROT_READ,flags,file,(off_t)begin);
+        if(base==MAP_FAILED) return false;
+        madvise(base,length,MADV_SEQUENTIAL);
+#endif
+        window.base=base;window.length=length;window.data=(char*)base+(offset-begin);
+        return true;
+    }
+
+    static uint64_t Allocation_Granularity()
+    {
+#ifdef _WIN32
+        SYSTEM_INFO info;GetSystemInfo(&info);
+        return info.dwAllocationGranularity;
+#else
+        return (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+    }
+
+private:
+    void Close()
+    {
+#ifdef _WIN32
+        if(mapping) CloseHandle(mapping);
+        if(file) CloseHandle(file);
+        mapping=0;file=0;
+#else
+        if(file>=0) close(file);
+        file=-1;
+#endif
+    }
+
+    MAPPED_FILE(const MAPPED_FILE&);
+    void operator=(const MAPPED_FILE&);
+};
+}
+#endif
@@ -0,0 +1,234 @@
+//#####################################################################
+// Class PARALLEL_FOR
+//#####################################################################
+// Persistent pool of pinned threads executing an index range [imin,imax_plus_one).
+// The range is cut into one contiguous block per thread, so a thread works on
+// the same memory in every invocation (and Run_Static can be used to first-touch
+// the data so the pages are placed on the NUMA node of that thread). Inside its
+// block a thread claims guided chunks (half of what is left, never less than the
+// grain) with a single atomic compare-and-swap; once the own block is exhausted it
+// claims chunks from the other blocks, which evens out imbalance without a lock.
+// Thread tid is pinned to the tid-th entry of Cpu_Order, which lists one logical
+// processor of every physical core before the SMT siblings. The calling thread
+// gets its old affinity back when the pool is destroyed.
+//#####################################################################
+#ifndef __PARALLEL_FOR__
+#define __PARALLEL_FOR__
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+namespace PhysBAM{
+
+class PARALLEL_FOR
+{
+public:
+    typedef std::function<void(const int imin,const int imax_plus_one)> RANGE_FUNCTION;
+
+private:
+    struct CURSOR
+    {
+        std::atomic<int> next;
+        int end;
+        char padding[64-sizeof(std::atomic<int>)-sizeof(int)]; // one cache line per cursor
+        CURSOR():next(0),end(0){}
+    };
+
+    const int number_of_threads;
+    std::vector<std::thread> threads;
+    CURSOR* const cursors;
+    std::mutex lock;
+    std::condition_variable start_condition,done_condition;
+    int generation,threads_running;
+    bool exiting,steal;
+    int grain;
+    RANGE_FUNCTION range_function;
+    const bool pinned;
+#ifdef _WIN32
+    DWORD_PTR caller_affinity;
+#elif defined(__linux__)
+    cpu_set_t caller_affinity;
+#endif
+
+public:
+    // thread_count includes the calling thread, which executes block 0
+    explicit PARALLEL_FOR(const int thread_count,const bool pin_threads=true)
+        :number_of_threads(std::max(thread_count,1)),cursors(new CURSOR[std::max(thread_count,1)]),generation(0),threads_running(0),exiting(false),steal(true),grain(1),pinned(pin_threads)
+    {
+        if(pinned){
+#ifdef _WIN32
+            caller_affinity=Pin_Current_Thread(0);
+#else
+#ifdef __linux__
+            pthread_getaffinity_np(pthread_self(),sizeof(cpu_set_t),&caller_affinity);
+#endif
+            Pin_Current_Thread(0);
+#endif
+        }
+        for(int tid=1;tid<number_of_threads;tid++) threads.push_back(std::thread(&PARALLEL_FOR::Thread_Routine,this,tid,pin_threads));
+    }
+
+    ~PARALLEL_FOR()
+    {
+        {std::lock_guard<std::mutex> guard(lock);exiting=true;}
+        start_condition.notify_all();
+        for(size_t i=0;i<threads.size();i++) threads[i].join();
+        delete[] cursors;
+        if(pinned){
+#ifdef _WIN32
+            if(caller_affinity) SetThreadAffinityMask(GetCurrentThread(),caller_affinity);
+#elif defined(__linux__)
+            pthread_setaffinity_np(pthread_self(),sizeof(cpu_set_t),&caller_affinity);
+#endif
+        }
+    }
+
+    int Number_Of_Threads() const
+    {return number_of_threads;}
+
+    // Dynamic schedule: guided chunks, multiples of grain, stolen across blocks when a thread runs dry
+    void Run(const int imin,const int imax_plus_one,const int grain_input,const RANGE_FUNCTION& function)
+    {Execute(imin,imax_plus_one,grain_input,function,true);}
+
+    // Static schedule: every thread processes exactly its own block; use for first-touch placement
+    void Run_Static(const int imin,const int imax_plus_one,const int grain_input,const RANGE_FUNCTION& function)
+    {Execute(imin,imax_plus_one,grain_input,function,false);}
+
+    // Logical processors with one of every physical core first, then their SMT siblings, so consecutive
+    // threads land on different cores before any core runs two of them
+    static const std::vector<int>& Cpu_Order()
+    {
+        static const std::vector<int> order=Compute_Cpu_Order();
+        return order;
+    }
+
+    // Pins the calling thread to the cpu-th logical processor of Cpu_Order, returns the previous mask on Windows
+#ifdef _WIN32
+    static DWORD_PTR Pin_Current_Thread(const int cpu)
+    {
+        const std::vector<int>& order=Cpu_Order();
+        return SetThreadAffinityMask(GetCurrentThread(),(DWORD_PTR)1<<order[cpu%order.size()]);
+    }
+#else
+    static void Pin_Current_Thread(const int cpu)
+    {
+#ifdef __linux__
+        const std::vector<int>& order=Cpu_Order();
+        cpu_set_t cpu_set;CPU_ZERO(&cpu_set);CPU_SET(order[cpu%order.size()],&cpu_set);
+        pthread_setaffinity_np(pthread_self(),sizeof(cpu_set_t),&cpu_set);
+#else
+        (void)cpu;
+#endif
+    }
+#endif
+
+private:
+    void Execute(const int imin,const int imax_plus_one,const int grain_input,const RANGE_FUNCTION& function,const bool steal_input)
+    {
+        if(imax_plus_one<=imin) return;
+        grain=std::max(grain_input,1);steal=steal_input;range_function=function;
+
+        // Block boundaries are multiples of the grain so SIMD kernels never straddle two chunks
+        const int size=imax_plus_one-imin,grains=(size+grain-1)/grain;
+        for(int tid=0;tid<number_of_threads;tid++){
+            int begin=imin+(int)(((long long)grains*tid/number_of_threads)*grain),end=imin+(int)(((long long)grains*(tid+1)/number_of_threads)*grain);
+            cursors[tid].next.store(std::min(begin,imax_plus_one),std::memory_order_relaxed);cursors[tid].end=std::min(end,imax_plus_one);}
+
+        {std::lock_guard<std::mutex> guard(lock);threads_running=number_of_threads-1;generation++;}
+        start_condition.notify_all();
+
+        Process(0);
+
+        std::unique_lock<std::mutex> guard(lock);
+        while(threads_running!=0) done_condition.wait(guard);
+    }
+
+    void Thread_Routine(const int tid,const bool pin_threads)
+    {
+        if(pin_threads) Pin_Current_Thread(tid);
+        int seen_generation=0;
+        while(1){
+            {std::unique_lock<std::mutex> guard(lock);
+            while(generation==seen_generation && !exiting) start_condition.wait(guard);
+            if(exiting) return;
+            seen_generation=generation;}
+            Process(tid);
+            {std::lock_guard<std::mutex> guard(lock);
+            if(--threads_running==0) done_condition.notify_one();}
+        }
+    }
+
+    void Process(const int tid)
+    {
+        int begin,end;
+        while(Claim(cursors[tid],begin,end)) range_function(begin,end);
+        if(!steal) return;
+        for(int offset=1;offset<number_of_threads;offset++){
+            CURSOR& victim=cursors[(tid+offset)%number_of_threads];
+            while(Claim(victim,begin,end)) range_function(begin,end);}
+    }
+
+    static std::vector<int> Compute_Cpu_Order()
+    {
+        const int cpu_count=std::max((int)std::thread::hardware_concurrency(),1);
+        std::vector<int> first,siblings;
+#ifdef _WIN32
+        DWORD length=0;
+        GetLogicalProcessorInformation(0,&length);
+        std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> information(length/sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+        if(length && GetLogicalProcessorInformation(&information[0],&length))
+            for(size_t i=0;i<information.size();i++) if(information[i].Relationship==RelationProcessorCore){
+                bool first_of_core=true;
+                for(int cpu=0;cpu<(int)(8*sizeof(ULONG_PTR)) && cpu<cpu_count;cpu++) if(information[i].ProcessorMask&((ULONG_PTR)1<<cpu)){
+                    (first_of_core?first:siblings).push_back(cpu);first_of_core=false;}}
+#elif defined(__linux__)
+        // A physical core is a (package, core id) pair of the sysfs topology
+        std::vector<std::pair<int,int> > cores;
+        for(int cpu=0;cpu<cpu_count;cpu++){
+            int package=-1,core=-1;char path[128];
+            std::snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d/topology/physical_package_id",cpu);
+            if(FILE* file=std::fopen(path,"r")){if(std::fscanf(file,"%d",&package)!=1) package=-1;std::fclose(file);}
+            std::snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d/topology/core_id",cpu);
+            if(FILE* file=std::fopen(path,"r")){if(std::fscanf(file,"%d",&core)!=1) core=-1;std::fclose(file);}
+            const std::pair<int,int> key(package,core);
+            if(core<0 || std::find(cores.begin(),cores.end(),key)==cores.end()){cores.push_back(key);first.push_back(cpu);}
+            else siblings.push_back(cpu);}
+#endif
+        // Without a topology the logical processors are taken in order
+        if((int)(first.size()+siblings.size())!=cpu_count){
+            first.clear();siblings.clear();
+            for(int cpu=0;cpu<cpu_count;cpu++) first.push_back(cpu);}
+        first.insert(first.end(),siblings.begin(),siblings.end());
+        return first;
+    }
+
+    bool Claim(CURSOR& cursor,int& begin,int& end)
+    {
+        int current=cursor.next.load(std::memory_order_relaxed);
+        while(current<cursor.end){
+            const int remaining=cursor.end-current;
+            int chunk=std::max(((remaining/2)/grain)*grain,grain);
+            if(!steal) chunk=remaining;
+            const int next=std::min(current+chunk,cursor.end);
+            if(cursor.next.compare_exchange_weak(current,next,std::memory_order_relaxed)){begin=current;end=next;return true;}}
+        return false;
+    }
+
+//#####################################################################
+};
+}
+#endif
@@ -0,0 +1,14 @@
+//#####################################################################
+// Batch kernels of wavelet_spline/include/svd
+//#####################################################################
+// Compiled once per instruction set with one of
+// -DSVD_BATCH_KERNELS_AVX, -DSVD_BATCH_KERNELS_AVX2 or
+// -DSVD_BATCH_KERNELS_AVX512 and the matching code generation flags (-mavx,
+// -mavx2 -mfma, -mavx512f), see svd_batch_kernels.h. The drivers that link
+// the objects define SVD_BATCH_KERNEL_OBJECTS, are built for the baseline
+// and run the widest kernels the processor supports.
+//#####################################################################
+
+#include <svd/svd_batch_kernels.h>
+
+//#####################################################################
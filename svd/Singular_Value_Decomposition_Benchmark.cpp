@@ -0,0 +1,175 @@
+//#####################################################################
+// Benchmark of both 3x3 singular value decompositions
+//#####################################################################
+// Runs the Sifakis kernel of this directory and the templated
+// decomposition of wavelet_spline/include/svd on the same matrices, for
+// every instruction set the processor supports (scalar, SSE, AVX, AVX2,
+// AVX-512) and for 1, 2, 4, ... threads. Reports the throughput, the
+// reconstruction error max|U*S*V'-A| and the largest off diagonal element
+// of U'*A*V, both relative to max|A| of the matrix, for three input
+// distributions: uniform entries, near identity and condition number 1e6.
+//
+// Usage: Singular_Value_Decomposition_Benchmark [matrices] [max threads]
+//#####################################################################
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <svd/svd_cpu.h>
+
+#include "PARALLEL_FOR.h"
+#include "sys_profile_timer.h"
+#include "Singular_Value_Decomposition_Benchmark.h"
+
+struct IMPLEMENTATION
+{
+    const char* name;
+    const char* set;
+    svd::cpu::instruction_set required;
+    BENCHMARK_KERNEL kernel;
+};
+
+const IMPLEMENTATION implementations[]={
+    {"sifakis","scalar",svd::cpu::instruction_set_scalar,Sifakis_Scalar},
+    {"sifakis","sse",svd::cpu::instruction_set_sse,Sifakis_SSE},
+    {"sifakis","avx",svd::cpu::instruction_set_avx,Sifakis_AVX},
+    {"sifakis","avx512",svd::cpu::instruction_set_avx512,Sifakis_AVX512},
+    {"templated","scalar",svd::cpu::instruction_set_scalar,Templated_Scalar},
+    {"templated","sse",svd::cpu::instruction_set_sse,Templated_SSE},
+    {"templated","avx",svd::cpu::instruction_set_avx,Templated_AVX},
+    {"templated","avx2",svd::cpu::instruction_set_avx2,Templated_AVX2},
+    {"templated","avx512",svd::cpu::instruction_set_avx512,Templated_AVX512}};
+
+// the planes of every array are allocated in one block
+struct STORAGE
+{
+    std::vector<float> memory;
+    BENCHMARK_DATA data;
+
+    explicit STORAGE(const int size)
+        :memory((size_t)30*size)
+    {
+        data.size=size;
+        for(int k=0;k<9;k++){
+            data.a[k]=&memory[(size_t)k*size];
+            data.u[k]=&memory[(size_t)(9+k)*size];
+            data.v[k]=&memory[(size_t)(18+k)*size];}
+        for(int k=0;k<3;k++) data.sigma[k]=&memory[(size_t)(27+k)*size];
+    }
+};
+
+//#####################################################################
+// Input distributions
+//#####################################################################
+void Random_Rotation(std::mt19937& generator,double r[9])
+{
+    std::normal_distribution<double> normal;
+    double x=normal(generator),y=normal(generator),z=normal(generator),w=normal(generator);
+    const double n=1./std::sqrt(x*x+y*y+z*z+w*w);x*=n;y*=n;z*=n;w*=n;
+    r[0]=1-2*(y*y+z*z);r[1]=2*(x*y-z*w);  r[2]=2*(x*z+y*w);
+    r[3]=2*(x*y+z*w);  r[4]=1-2*(x*x+z*z);r[5]=2*(y*z-x*w);
+    r[6]=2*(x*z-y*w);  r[7]=2*(y*z+x*w);  r[8]=1-2*(x*x+y*y);
+}
+
+enum DISTRIBUTION {DISTRIBUTION_UNIFORM,DISTRIBUTION_NEAR_IDENTITY,DISTRIBUTION_CONDITIONED};
+
+const char* distribution_names[]={"uniform entries in [-1,1]","near identity, perturbation 1e-3","condition number 1e6"};
+
+void Initialize(BENCHMARK_DATA& data,const DISTRIBUTION distribution)
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> uniform(-1.,1.);
+    for(int i=0;i<data.size;i++){
+        double a[9];
+        if(distribution==DISTRIBUTION_CONDITIONED){
+            const double sigma[3]={1.,1e-3,1e-6};
+            double r1[9],r2[9];Random_Rotation(generator,r1);Random_Rotation(generator,r2);
+            for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+                a[row*3+column]=0;for(int k=0;k<3;k++) a[row*3+column]+=r1[row*3+k]*sigma[k]*r2[column*3+k];}}
+        else{
+            const bool near_identity=distribution==DISTRIBUTION_NEAR_IDENTITY;
+            for(int k=0;k<9;k++) a[k]=(near_identity&&k%4==0?1.:0.)+(near_identity?1e-3:1.)*uniform(generator);}
+        for(int k=0;k<9;k++) data.a[k][i]=(float)a[k];}
+}
+
+//#####################################################################
+// Function Measure
+//#####################################################################
+// largest reconstruction error and off diagonal element of U'*A*V over all matrices, relative to max|A|
+void Measure(const BENCHMARK_DATA& data,double& reconstruction,double& off_diagonal)
+{
+    reconstruction=off_diagonal=0;
+    for(int i=0;i<data.size;i++){
+        double a[9],u[9],v[9],sigma[3],a_max=0;
+        for(int k=0;k<9;k++){a[k]=data.a[k][i];u[k]=data.u[k][i];v[k]=data.v[k][i];a_max=std::max(a_max,std::fabs(a[k]));}
+        for(int k=0;k<3;k++) sigma[k]=data.sigma[k][i];
+        if(a_max==0) continue;
+        for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+            double usv=0,uav=0;
+            for(int k=0;k<3;k++){
+                usv+=u[row*3+k]*sigma[k]*v[column*3+k];
+                for(int l=0;l<3;l++) uav+=u[k*3+row]*a[k*3+l]*v[l*3+column];}
+            reconstruction=std::max(reconstruction,std::fabs(usv-a[row*3+column])/a_max);
+            if(row!=column) off_diagonal=std::max(off_diagonal,std::fabs(uav)/a_max);}}
+}
+
+//#####################################################################
+// Function Run
+//#####################################################################
+// best of the repetitions, the pool of threads is created before the timing
+double Run(PhysBAM::PARALLEL_FOR& parallel_for,const BENCHMARK_KERNEL kernel,const BENCHMARK_DATA& data,const int repetitions)
+{
+    const int grain=1024;
+    double best=0;
+    for(int repetition=0;repetition<repetitions;repetition++){
+        sys::profile_timer timer;
+        parallel_for.Run(0,data.size,grain,[&](const int imin,const int imax_plus_one){kernel(data,imin,imax_plus_one);});
+        const double seconds=timer.seconds();
+        if(repetition==0 || seconds<best) best=seconds;}
+    return best;
+}
+
+int main(int argc,char* argv[])
+{
+    // a multiple of the widest kernel
+    const int size=((argc>1?atoi(argv[1]):1048576)+15)/16*16;
+    const int max_threads=argc>2?atoi(argv[2]):std::max((int)std::thread::hardware_concurrency(),1);
+    const int repetitions=3;
+
+    const svd::cpu::instruction_set supported=svd::cpu::supported_instruction_set();
+
+    std::vector<int> thread_counts;
+    for(int threads=1;threads<max_threads;threads*=2) thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    STORAGE storage(size);
+    BENCHMARK_DATA& data=storage.data;
+
+    for(int distribution=DISTRIBUTION_UNIFORM;distribution<=DISTRIBUTION_CONDITIONED;distribution++){
+        Initialize(data,(DISTRIBUTION)distribution);
+
+        printf("%s, %d matrices\n",distribution_names[distribution],size);
+        printf("  %-10s %-7s %8s %14s %12s %12s\n","svd","set","threads","matrices/s","recon","off diag");
+
+        for(const IMPLEMENTATION& implementation:implementations){
+            if(supported<implementation.required){
+                printf("  %-10s %-7s not supported by the processor\n",implementation.name,implementation.set);
+                continue;}
+
+            // the results do not depend on the thread count
+            double reconstruction=0,off_diagonal=0;
+            for(size_t t=0;t<thread_counts.size();t++){
+                PhysBAM::PARALLEL_FOR parallel_for(thread_counts[t]);
+                const double seconds=Run(parallel_for,implementation.kernel,data,repetitions);
+                if(t==0) Measure(data,reconstruction,off_diagonal);
+                printf("  %-10s %-7s %8d %14.0f %12.3e %12.3e\n",implementation.name,implementation.set,thread_counts[t],size/seconds,reconstruction,off_diagonal);}}
+        printf("\n");}
+
+    return 0;
+}
+//#####################################################################
@@ -0,0 +1,37 @@
+//#####################################################################
+// Kernels of Singular_Value_Decomposition_Benchmark
+//#####################################################################
+// Singular_Value_Decomposition_Benchmark_Kernels.cpp is compiled once per
+// instruction set, each object exports the kernels of its set. The Sifakis
+// kernel (Singular_Value_Decomposition_Kernel.h) exists for every set but
+// AVX2, which it has no use for, the templated decomposition of
+// wavelet_spline/include/svd for every set.
+//#####################################################################
+#ifndef __Singular_Value_Decomposition_Benchmark__
+#define __Singular_Value_Decomposition_Benchmark__
+
+// SoA planes, element k (row major) of matrix i is a[k][i], u, v likewise, sigma[k][i] is singular value k
+struct BENCHMARK_DATA
+{
+    int size;
+    float* a[9];
+    float* u[9];
+    float* sigma[3];
+    float* v[9];
+};
+
+// decomposes the matrices [imin,imax_plus_one), both are multiples of 16
+typedef void (*BENCHMARK_KERNEL)(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+
+void Sifakis_Scalar(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+void Sifakis_SSE(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+void Sifakis_AVX(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+void Sifakis_AVX512(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+
+void Templated_Scalar(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+void Templated_SSE(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+void Templated_AVX(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+void Templated_AVX2(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+void Templated_AVX512(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one);
+
+#endif
@@ -0,0 +1,76 @@
+//#####################################################################
+// Kernels of Singular_Value_Decomposition_Benchmark
+//#####################################################################
+// Compiled once per instruction set with one of -DBENCHMARK_SCALAR,
+// -DBENCHMARK_SSE, -DBENCHMARK_AVX, -DBENCHMARK_AVX2 or -DBENCHMARK_AVX512
+// and the matching code generation flags, so the driver itself is built for
+// the baseline and only calls the kernels the processor supports.
+//#####################################################################
+
+#if defined(BENCHMARK_SCALAR)
+#define BENCHMARK_SET Scalar
+#define BENCHMARK_NUMBER svd::cpu_scalar
+#define BENCHMARK_WIDTH 1
+#elif defined(BENCHMARK_SSE)
+#define BENCHMARK_SET SSE
+#define BENCHMARK_NUMBER svd::sse_vector
+#define BENCHMARK_WIDTH 4
+#elif defined(BENCHMARK_AVX)
+#define BENCHMARK_SET AVX
+#define BENCHMARK_NUMBER svd::avx_vector
+#define BENCHMARK_WIDTH 8
+#elif defined(BENCHMARK_AVX2)
+#define BENCHMARK_SET AVX2
+#define BENCHMARK_NUMBER svd::avx2_vector
+#define BENCHMARK_WIDTH 8
+#elif defined(BENCHMARK_AVX512)
+#define BENCHMARK_SET AVX512
+#define BENCHMARK_NUMBER svd::avx512_vector
+#define BENCHMARK_WIDTH 16
+#else
+#error "define one of BENCHMARK_SCALAR, BENCHMARK_SSE, BENCHMARK_AVX, BENCHMARK_AVX2, BENCHMARK_AVX512"
+#endif
+
+#define BENCHMARK_PASTE_(prefix,set) prefix##_##set
+#define BENCHMARK_PASTE(prefix,set) BENCHMARK_PASTE_(prefix,set)
+#define BENCHMARK_NAME(prefix) BENCHMARK_PASTE(prefix,BENCHMARK_SET)
+
+#include <cmath>
+
+#include "Singular_Value_Decomposition_Benchmark.h"
+#include "Singular_Value_Decomposition_Kernel.h"
+
+#include <svd/svd.h>
+
+#if !defined(BENCHMARK_AVX2)
+//#####################################################################
+// Function Sifakis
+//#####################################################################
+void BENCHMARK_NAME(Sifakis)(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one)
+{
+    Singular_Value_Decomposition::KERNEL_DATA kernel_data;
+    for(int k=0;k<9;k++){kernel_data.a[k]=data.a[k];kernel_data.u[k]=data.u[k];kernel_data.v[k]=data.v[k];}
+    for(int k=0;k<3;k++) kernel_data.sigma[k]=data.sigma[k];
+    Singular_Value_Decomposition::BENCHMARK_NAME(Kernel)(kernel_data,imin,imax_plus_one,0);
+}
+#endif
+//#####################################################################
+// Function Templated
+//#####################################################################
+// a template, so the raw vector types are not template arguments of the svd classes outside of one
+template<class T> static void Templated(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one)
+{
+    for(int index=imin;index<imax_plus_one;index+=BENCHMARK_WIDTH){
+        svd::matrix3x3<T> a,u,v;svd::vector3<T> sigma;
+        T* aa=&a.a11;for(int k=0;k<9;k++) aa[k]=svd::math::load<T>(data.a[k]+index);
+        svd::compute(a,u,sigma,v);
+        const T* uu=&u.a11;const T* vv=&v.a11;const T* ss=&sigma.x;
+        for(int k=0;k<9;k++){svd::math::store(data.u[k]+index,uu[k]);svd::math::store(data.v[k]+index,vv[k]);}
+        for(int k=0;k<3;k++) svd::math::store(data.sigma[k]+index,ss[k]);}
+}
+
+void BENCHMARK_NAME(Templated)(const BENCHMARK_DATA& data,const int imin,const int imax_plus_one)
+{
+    Templated<BENCHMARK_NUMBER>(data,imin,imax_plus_one);
+}
+//#####################################################################
@@ -21,28 +21,27 @@
 #include <iostream>
 #include <vector>
 
-#include <concrt.h>
-#include <ppl.h>
-
+#include "PARALLEL_FOR.h"
+#include "sys_profile_zone.h"
 #include "Singular_Value_Decomposition_Helper.h"
 
-
-
-
-//#define USE_SCALAR_IMPLEMENTATION
-#define USE_SSE_IMPLEMENTATION
-// #define USE_AVX_IMPLEMENTATION
-// #define PRINT_DEBUGGING_OUTPUT
-
-#define COMPUTE_V_AS_MATRIX
-// #define COMPUTE_V_AS_QUATERNION
-#define COMPUTE_U_AS_MATRIX
-// #define COMPUTE_U_AS_QUATERNION
-
-#include "Singular_Value_Decomposition_Preamble.hpp"
-
 using namespace Singular_Value_Decomposition;
 
+namespace
+{
+    // Smallest chunk handed to a thread; a multiple of every SIMD width, and the same for
+    // the first-touch in Allocate_Data and Run_Parallel so each thread sees the same block
+    const int parallel_grain=1024;
+}
+
+//#####################################################################
+// Destructor
+//#####################################################################
+template<class T,int size> Singular_Value_Decomposition_Size_Specific_Helper<T,size>::
+~Singular_Value_Decomposition_Size_Specific_Helper()
+{
+    delete parallel_for;
+}
 
 //#####################################################################
 // Function Allocate_Data
@@ -51,7 +50,7 @@ template<class T,int size> void Singular_Value_Decomposition_Size_Specific_Helpe
 Allocate_Data(T*& a11,T*& a21,T*& a31,T*& a12,T*& a22,T*& a32,T*& a13,T*& a23,T*& a33,
     T*& u11,T*& u21,T*& u31,T*& u12,T*& u22,T*& u32,T*& u13,T*& u23,T*& u33,
     T*& v11,T*& v21,T*& v31,T*& v12,T*& v22,T*& v32,T*& v13,T*& v23,T*& v33,
-    T*& sigma1,T*& sigma2,T*& sigma3)
+    T*& sigma1,T*& sigma2,T*& sigma3,const int number_of_threads)
 {
     a11=new T[size];
     a21=new T[size];
@@ -86,6 +85,16 @@ Allocate_Data(T*& a11,T*& a21,T*& a31,T*& a12,T*& a22,T*& a32,T*& a13,T*& a23,T*
     sigma1=new T[size];
     sigma2=new T[size];
     sigma3=new T[size];
+
+    // First-touch the pages from the threads (and with the same blocks) Run_Parallel will use,
+    // so that every block ends up on the NUMA node of the core processing it
+    if(number_of_threads>1){
+        PhysBAM::PARALLEL_FOR first_touch(number_of_threads);
+        first_touch.Run_Static(0,size,parallel_grain,[&](const int imin,const int imax_plus_one)
+        {
+            T* const arrays[]={a11,a21,a31,a12,a22,a32,a13,a23,a33,u11,u21,u31,u12,u22,u32,u13,u23,u33,v11,v21,v31,v12,v22,v32,v13,v23,v33,sigma1,sigma2,sigma3};
+            for(int array=0;array<(int)(sizeof(arrays)/sizeof(arrays[0]));array++) std::fill(arrays[array]+imin,arrays[array]+imax_plus_one,(T)0);
+        });}
 }
 //#####################################################################
 // Function Initialize_Data
@@ -94,13 +103,15 @@ template<class T,int size> void Singular_Value_Decomposition_Size_Specific_Helpe
 Initialize_Data(T*& a11,T*& a21,T*& a31,T*& a12,T*& a22,T*& a32,T*& a13,T*& a23,T*& a33,
     T*& u11,T*& u21,T*& u31,T*& u12,T*& u22,T*& u32,T*& u13,T*& u23,T*& u33,
     T*& v11,T*& v21,T*& v31,T*& v12,T*& v22,T*& v32,T*& v13,T*& v23,T*& v33,
-    T*& sigma1,T*& sigma2,T*& sigma3)
+    T*& sigma1,T*& sigma2,T*& sigma3,const T perturbation)
 {
+    // Uniform entries in [-1,1], or the identity plus entries in [-perturbation,perturbation]
+    const T scale=perturbation>0?perturbation:(T)1,diagonal=perturbation>0?(T)1:(T)0;
     srand(1);
     for(int i=0;i<size;i++){
-        a11[i]=2.*(T)rand()/(T)RAND_MAX-1.;a21[i]=2.*(T)rand()/(T)RAND_MAX-1.;a31[i]=2.*(T)rand()/(T)RAND_MAX-1.;
-        a12[i]=2.*(T)rand()/(T)RAND_MAX-1.;a22[i]=2.*(T)rand()/(T)RAND_MAX-1.;a32[i]=2.*(T)rand()/(T)RAND_MAX-1.;
-        a13[i]=2.*(T)rand()/(T)RAND_MAX-1.;a23[i]=2.*(T)rand()/(T)RAND_MAX-1.;a33[i]=2.*(T)rand()/(T)RAND_MAX-1.;
+        a11[i]=diagonal+scale*(2.*(T)rand()/(T)RAND_MAX-1.);a21[i]=scale*(2.*(T)rand()/(T)RAND_MAX-1.);a31[i]=scale*(2.*(T)rand()/(T)RAND_MAX-1.);
+        a12[i]=scale*(2.*(T)rand()/(T)RAND_MAX-1.);a22[i]=diagonal+scale*(2.*(T)rand()/(T)RAND_MAX-1.);a32[i]=scale*(2.*(T)rand()/(T)RAND_MAX-1.);
+        a13[i]=scale*(2.*(T)rand()/(T)RAND_MAX-1.);a23[i]=scale*(2.*(T)rand()/(T)RAND_MAX-1.);a33[i]=diagonal+scale*(2.*(T)rand()/(T)RAND_MAX-1.);
 
         T one_over_frobenius_norm=(T)1./sqrt(
             (double)a11[i]*(double)a11[i]+(double)a12[i]*(double)a12[i]+(double)a13[i]*(double)a13[i]+
@@ -121,54 +132,20 @@ Initialize_Data(T*& a11,T*& a21,T*& a31,T*& a12,T*& a22,T*& a32,T*& a13,T*& a23,
 //#####################################################################
 // Function Run_Parallel
 //#####################################################################
-namespace
-{
-    template<class T,int size>
-    struct Singular_Value_Decomposition_Size_Specific_Thread_Helper
-    {
-        Singular_Value_Decomposition_Size_Specific_Helper<T,size>* const obj;
-
-        const int imin, imax_plus_one ;
-
-        Singular_Value_Decomposition_Size_Specific_Thread_Helper(
-            Singular_Value_Decomposition_Size_Specific_Helper<T,size>* const obj_input,const int imin_input,const int imax_plus_one_input)
-            :obj(obj_input),imin(imin_input),imax_plus_one(imax_plus_one_input) {}
-        void Run()
-        {
-            obj->Run_Index_Range(imin,imax_plus_one);
-        }
-
-        void operator()() const
-        {
-            obj->Run_Index_Range(imin,imax_plus_one);
-        }
-    };
-}
-
 template<class T,int size> void Singular_Value_Decomposition_Size_Specific_Helper<T,size>::
 Run_Parallel(const int number_of_partitions)
 {
-    std::vector < Concurrency::task_handle< Singular_Value_Decomposition_Size_Specific_Thread_Helper<T,size>  > > tasks_storage;
-
-    Concurrency::structured_task_group tasks;
-
-    for( int partition=0; partition<number_of_partitions; partition++ )
-    {
-        int imin=(size/number_of_partitions)*partition+std::min(size%number_of_partitions,partition);
-        int imax_plus_one=(size/number_of_partitions)*(partition+1)+std::min(size%number_of_partitions,partition+1);
+    // The pool is kept between calls, so threads stay pinned to the cores that own their blocks
+    if(!parallel_for || parallel_for->Number_Of_Threads()!=number_of_partitions){
+        delete parallel_for;
+        parallel_for=new PhysBAM::PARALLEL_FOR(number_of_partitions);}
+    Reset_Jacobi_Sweeps();
 
-        auto task = Concurrency::make_task (  Singular_Value_Decomposition_Size_Specific_Thread_Helper<T,size>(this, imin, imax_plus_one) ) ; 
-
-        tasks_storage.emplace_back(task);
-    }
-
-    std::for_each( std::begin( tasks_storage), std::end(tasks_storage), [&]( Concurrency::task_handle< Singular_Value_Decomposition_Size_Specific_Thread_Helper<T,size>  > & r) -> void
+    parallel_for->Run(0,size,parallel_grain,[this](const int imin,const int imax_plus_one)
     {
-        tasks.run( r );
+        SYS_PROFILE_ZONE("svd_chunk");
+        Run_Index_Range(imin,imax_plus_one);
     });
-
-
-    tasks.wait();
 }
 
 //#####################################################################
@@ -176,62 +153,15 @@ Run_Parallel(const int number_of_partitions)
 //#####################################################################
 template<class T,int size> void Singular_Value_Decomposition_Size_Specific_Helper<T,size>::
 Run_Index_Range(const int imin,const int imax_plus_one)
-{   
-
-#include "Singular_Value_Decomposition_Kernel_Declarations.hpp"
-
-#ifdef USE_SSE_IMPLEMENTATION
-#define STEP_SIZE 4
-#endif
-#ifdef USE_AVX_IMPLEMENTATION
-#define STEP_SIZE 8
-#endif
-#ifdef USE_SCALAR_IMPLEMENTATION
-#define STEP_SIZE 1
-#endif
-
-    for(int index=imin;index<imax_plus_one;index+=STEP_SIZE){
-        
-    ENABLE_SCALAR_IMPLEMENTATION(Sa11.f=a11[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va11=_mm_loadu_ps(a11+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va11=_mm256_loadu_ps(a11+index);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa21.f=a21[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va21=_mm_loadu_ps(a21+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va21=_mm256_loadu_ps(a21+index);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa31.f=a31[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va31=_mm_loadu_ps(a31+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va31=_mm256_loadu_ps(a31+index);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa12.f=a12[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va12=_mm_loadu_ps(a12+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va12=_mm256_loadu_ps(a12+index);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa22.f=a22[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va22=_mm_loadu_ps(a22+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va22=_mm256_loadu_ps(a22+index);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa32.f=a32[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va32=_mm_loadu_ps(a32+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va32=_mm256_loadu_ps(a32+index);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa13.f=a13[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va13=_mm_loadu_ps(a13+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va13=_mm256_loadu_ps(a13+index);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa23.f=a23[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va23=_mm_loadu_ps(a23+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va23=_mm256_loadu_ps(a23+index);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa33.f=a33[index];)                                      ENABLE_SSE_IMPLEMENTATION(Va33=_mm_loadu_ps(a33+index);)                                  ENABLE_AVX_IMPLEMENTATION(Va33=_mm256_loadu_ps(a33+index);)
-
-#include "Singular_Value_Decomposition_Main_Kernel_Body.hpp"
-
-    ENABLE_SCALAR_IMPLEMENTATION(u11[index]=Su11.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u11+index,Vu11);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u11+index,Vu11);)
-    ENABLE_SCALAR_IMPLEMENTATION(u21[index]=Su21.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u21+index,Vu21);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u21+index,Vu21);)
-    ENABLE_SCALAR_IMPLEMENTATION(u31[index]=Su31.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u31+index,Vu31);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u31+index,Vu31);)
-    ENABLE_SCALAR_IMPLEMENTATION(u12[index]=Su12.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u12+index,Vu12);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u12+index,Vu12);)
-    ENABLE_SCALAR_IMPLEMENTATION(u22[index]=Su22.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u22+index,Vu22);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u22+index,Vu22);)
-    ENABLE_SCALAR_IMPLEMENTATION(u32[index]=Su32.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u32+index,Vu32);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u32+index,Vu32);)
-    ENABLE_SCALAR_IMPLEMENTATION(u13[index]=Su13.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u13+index,Vu13);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u13+index,Vu13);)
-    ENABLE_SCALAR_IMPLEMENTATION(u23[index]=Su23.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u23+index,Vu23);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u23+index,Vu23);)
-    ENABLE_SCALAR_IMPLEMENTATION(u33[index]=Su33.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(u33+index,Vu33);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(u33+index,Vu33);)
-
-    ENABLE_SCALAR_IMPLEMENTATION(v11[index]=Sv11.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v11+index,Vv11);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v11+index,Vv11);)
-    ENABLE_SCALAR_IMPLEMENTATION(v21[index]=Sv21.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v21+index,Vv21);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v21+index,Vv21);)
-    ENABLE_SCALAR_IMPLEMENTATION(v31[index]=Sv31.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v31+index,Vv31);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v31+index,Vv31);)
-    ENABLE_SCALAR_IMPLEMENTATION(v12[index]=Sv12.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v12+index,Vv12);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v12+index,Vv12);)
-    ENABLE_SCALAR_IMPLEMENTATION(v22[index]=Sv22.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v22+index,Vv22);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v22+index,Vv22);)
-    ENABLE_SCALAR_IMPLEMENTATION(v32[index]=Sv32.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v32+index,Vv32);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v32+index,Vv32);)
-    ENABLE_SCALAR_IMPLEMENTATION(v13[index]=Sv13.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v13+index,Vv13);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v13+index,Vv13);)
-    ENABLE_SCALAR_IMPLEMENTATION(v23[index]=Sv23.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v23+index,Vv23);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v23+index,Vv23);)
-    ENABLE_SCALAR_IMPLEMENTATION(v33[index]=Sv33.f;)                                      ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(v33+index,Vv33);)                                 ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(v33+index,Vv33);)
-
-    ENABLE_SCALAR_IMPLEMENTATION(sigma1[index]=Sa11.f;)                                   ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(sigma1+index,Va11);)                              ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(sigma1+index,Va11);)
-    ENABLE_SCALAR_IMPLEMENTATION(sigma2[index]=Sa22.f;)                                   ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(sigma2+index,Va22);)                              ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(sigma2+index,Va22);)
-    ENABLE_SCALAR_IMPLEMENTATION(sigma3[index]=Sa33.f;)                                   ENABLE_SSE_IMPLEMENTATION(_mm_storeu_ps(sigma3+index,Va33);)                              ENABLE_AVX_IMPLEMENTATION(_mm256_storeu_ps(sigma3+index,Va33);)
-
-    }
-
-#undef STEP_SIZE
-
+{
+    const KERNEL_DATA data={
+        {a11,a12,a13,a21,a22,a23,a31,a32,a33},
+        {u11,u12,u13,u21,u22,u23,u31,u32,u33},
+        {sigma1,sigma2,sigma3},
+        {v11,v12,v13,v21,v22,v23,v31,v32,v33}};
+
+    jacobi_sweeps+=kernel->kernel(data,imin,imax_plus_one,jacobi_tolerance);
+    jacobi_vectors+=(imax_plus_one-imin+kernel->width-1)/kernel->width;
 }
 //#####################################################################
 template class Singular_Value_Decomposition_Size_Specific_Helper<float,65536>;
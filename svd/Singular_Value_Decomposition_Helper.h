@@ -17,6 +17,12 @@
 #ifndef __Singular_Value_Decomposition_Helper__
 #define __Singular_Value_Decomposition_Helper__
 
+#include <atomic>
+
+#include "Singular_Value_Decomposition_Kernel.h"
+
+namespace PhysBAM{class PARALLEL_FOR;}
+
 namespace Singular_Value_Decomposition{
 
 template<class T,int size>
@@ -26,6 +32,10 @@ class Singular_Value_Decomposition_Size_Specific_Helper
     T* const u11,* const u21,* const u31,* const u12,* const u22,* const u32,* const u13,* const u23,* const u33;
     T* const v11,* const v21,* const v31,* const v12,* const v22,* const v32,* const v13,* const v23,* const v33;
     T* const sigma1,* const sigma2,* const sigma3;
+    PhysBAM::PARALLEL_FOR* parallel_for;
+    const KERNEL_VARIANT* kernel;
+    T jacobi_tolerance;
+    std::atomic<long long> jacobi_sweeps,jacobi_vectors;
 
 public:
     explicit Singular_Value_Decomposition_Size_Specific_Helper(
@@ -42,23 +52,49 @@ public:
         :a11(a11_input),a21(a21_input),a31(a31_input),a12(a12_input),a22(a22_input),a32(a32_input),a13(a13_input),a23(a23_input),a33(a33_input),
         u11(u11_input),u21(u21_input),u31(u31_input),u12(u12_input),u22(u22_input),u32(u32_input),u13(u13_input),u23(u23_input),u33(u33_input),
         v11(v11_input),v21(v21_input),v31(v31_input),v12(v12_input),v22(v22_input),v32(v32_input),v13(v13_input),v23(v23_input),v33(v33_input),
-        sigma1(sigma1_input),sigma2(sigma2_input),sigma3(sigma3_input)
+        sigma1(sigma1_input),sigma2(sigma2_input),sigma3(sigma3_input),parallel_for(0),
+        kernel(&Select_Kernel()),jacobi_tolerance(0),jacobi_sweeps(0),jacobi_vectors(0)
     {}
 
+    ~Singular_Value_Decomposition_Size_Specific_Helper();
+
+    // The helper owns its thread pool
+    Singular_Value_Decomposition_Size_Specific_Helper(const Singular_Value_Decomposition_Size_Specific_Helper&)=delete;
+    Singular_Value_Decomposition_Size_Specific_Helper& operator=(const Singular_Value_Decomposition_Size_Specific_Helper&)=delete;
+
     void Run()
-    {Run_Index_Range(0,size);}
+    {Reset_Jacobi_Sweeps();Run_Index_Range(0,size);}
+
+    // The widest variant of the kernel the processor supports by default, see Singular_Value_Decomposition_Kernel.h
+    void Set_Kernel(const KERNEL_VARIANT& variant)
+    {kernel=&variant;}
+
+    const KERNEL_VARIANT& Kernel() const
+    {return *kernel;}
+
+    // Zero runs the fixed number of Jacobi sweeps. Otherwise a SIMD vector stops sweeping once the off-diagonal
+    // part of A^T*A is below the tolerance (relative to its diagonal) in all of its lanes
+    void Set_Jacobi_Tolerance(const T tolerance)
+    {jacobi_tolerance=tolerance;}
+
+    // Average number of Jacobi sweeps per SIMD vector of the last run
+    double Average_Jacobi_Sweeps() const
+    {return jacobi_vectors?(double)jacobi_sweeps/(double)jacobi_vectors:0.;}
+
+    void Reset_Jacobi_Sweeps()
+    {jacobi_sweeps=0;jacobi_vectors=0;}
   
 //#####################################################################
     static void Allocate_Data(
         T*& a11,T*& a21,T*& a31,T*& a12,T*& a22,T*& a32,T*& a13,T*& a23,T*& a33,
         T*& u11,T*& u21,T*& u31,T*& u12,T*& u22,T*& u32,T*& u13,T*& u23,T*& u33,
         T*& v11,T*& v21,T*& v31,T*& v12,T*& v22,T*& v32,T*& v13,T*& v23,T*& v33,
-        T*& sigma1,T*& sigma2,T*& sigma3);
+        T*& sigma1,T*& sigma2,T*& sigma3,const int number_of_threads=1);
     static void Initialize_Data(
         T*& a11,T*& a21,T*& a31,T*& a12,T*& a22,T*& a32,T*& a13,T*& a23,T*& a33,
         T*& u11,T*& u21,T*& u31,T*& u12,T*& u22,T*& u32,T*& u13,T*& u23,T*& u33,
         T*& v11,T*& v21,T*& v31,T*& v12,T*& v22,T*& v32,T*& v13,T*& v23,T*& v33,
-        T*& sigma1,T*& sigma2,T*& sigma3);
+        T*& sigma1,T*& sigma2,T*& sigma3,const T perturbation=0);
     void Run_Parallel(const int number_of_partitions);
     void Run_Index_Range(const int imin, const int imax_plus_one);
 //#####################################################################
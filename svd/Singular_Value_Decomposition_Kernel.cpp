@@ -0,0 +1,41 @@
+//#####################################################################
+// Selection of the Singular Value Decomposition kernel
+//#####################################################################
+// Compiled for the baseline, it only calls the variant of a wider set after
+// svd::cpu has found the processor and the operating system support it.
+//#####################################################################
+
+#include <string.h>
+
+#include "Singular_Value_Decomposition_Kernel.h"
+
+using namespace Singular_Value_Decomposition;
+
+const KERNEL_VARIANT Singular_Value_Decomposition::kernel_variants[number_of_kernel_variants]={
+    {"scalar",svd::cpu::instruction_set_scalar,1,Kernel_Scalar},
+    {"sse",svd::cpu::instruction_set_sse,4,Kernel_SSE},
+    {"avx",svd::cpu::instruction_set_avx,8,Kernel_AVX},
+    {"avx512",svd::cpu::instruction_set_avx512,16,Kernel_AVX512}};
+
+//#####################################################################
+// Function Select_Kernel
+//#####################################################################
+const KERNEL_VARIANT& Singular_Value_Decomposition::
+Select_Kernel(const svd::cpu::instruction_set set)
+{
+    int selected=0;
+    for(int i=1;i<number_of_kernel_variants;i++) if(kernel_variants[i].required<=set) selected=i;
+    return kernel_variants[selected];
+}
+//#####################################################################
+// Function Find_Kernel
+//#####################################################################
+const KERNEL_VARIANT* Singular_Value_Decomposition::
+Find_Kernel(const char* name)
+{
+    for(int i=0;i<number_of_kernel_variants;i++)
+        if(!strcmp(kernel_variants[i].name,name))
+            return kernel_variants[i].required<=svd::cpu::supported_instruction_set()?&kernel_variants[i]:0;
+    return 0;
+}
+//#####################################################################
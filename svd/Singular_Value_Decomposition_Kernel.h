@@ -0,0 +1,68 @@
+//#####################################################################
+// Copyright (c) 2010-2011, Eftychios Sifakis.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+//     other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+// BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//#####################################################################
+// The kernel is a template over a SIMD policy
+// (Singular_Value_Decomposition_Kernel_Template.hpp). It is instantiated by
+// Singular_Value_Decomposition_Kernels.cpp, compiled once per instruction
+// set with the matching code generation flags, and every object exports the
+// variant of its set. Select_Kernel picks the widest variant the processor
+// supports at run time, down to the scalar one, so one binary runs on any
+// x86-64 processor.
+//#####################################################################
+#ifndef __Singular_Value_Decomposition_Kernel__
+#define __Singular_Value_Decomposition_Kernel__
+
+#include <svd/svd_cpu.h>
+
+namespace Singular_Value_Decomposition{
+
+// SoA planes, element k (row major) of matrix i is a[k][i], u, v likewise, sigma[k][i] is singular value k
+struct KERNEL_DATA
+{
+    const float* a[9];
+    float* u[9];
+    float* sigma[3];
+    float* v[9];
+};
+
+// decomposes the matrices [imin,imax_plus_one), both multiples of the width of the variant. A non-zero tolerance stops
+// the Jacobi sweeps of a SIMD vector once the off-diagonal part of A^T*A, relative to its diagonal, is below it in all
+// lanes. Returns the number of sweeps run, summed over the SIMD vectors
+typedef long long (*KERNEL)(const KERNEL_DATA& data,const int imin,const int imax_plus_one,const float jacobi_tolerance);
+
+long long Kernel_Scalar(const KERNEL_DATA& data,const int imin,const int imax_plus_one,const float jacobi_tolerance);
+long long Kernel_SSE(const KERNEL_DATA& data,const int imin,const int imax_plus_one,const float jacobi_tolerance);
+long long Kernel_AVX(const KERNEL_DATA& data,const int imin,const int imax_plus_one,const float jacobi_tolerance);
+long long Kernel_AVX512(const KERNEL_DATA& data,const int imin,const int imax_plus_one,const float jacobi_tolerance);
+
+struct KERNEL_VARIANT
+{
+    const char* name;
+    svd::cpu::instruction_set required;
+    int width;
+    KERNEL kernel;
+};
+
+// the variants, narrowest first. AVX2 adds nothing the kernel uses, an AVX2 processor runs the AVX variant
+const int number_of_kernel_variants=4;
+extern const KERNEL_VARIANT kernel_variants[number_of_kernel_variants];
+
+// the widest variant that runs on set, the scalar one at least
+const KERNEL_VARIANT& Select_Kernel(const svd::cpu::instruction_set set=svd::cpu::supported_instruction_set());
+
+// the variant of the given name, 0 if there is none or the processor does not support it
+const KERNEL_VARIANT* Find_Kernel(const char* name);
+}
+#endif
@@ -0,0 +1,733 @@
+//#####################################################################
+// Copyright (c) 2010-2011, Eftychios Sifakis.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+//     other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+// BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//#####################################################################
+// The kernel body, written once over a SIMD policy. A policy supplies the
+// vector type T, its width and one static function per instruction of the
+// kernel; SIMD_SCALAR works on the bits of a float, as the scalar variant
+// did. The operations are those of the SSE variant and in its order, so the
+// scalar, SSE and AVX instantiations produce the results of the former macro
+// kernels bit for bit. AVX-512 has no 12 bit reciprocal square root, its
+// 14 bit one makes the results differ in the last bits.
+//
+// Included by Singular_Value_Decomposition_Kernels.cpp only, which is
+// compiled once per instruction set. Everything is in an anonymous namespace,
+// so the instantiations of different objects never merge at link time.
+//#####################################################################
+#ifndef __Singular_Value_Decomposition_Kernel_Template__
+#define __Singular_Value_Decomposition_Kernel_Template__
+
+#include <cmath>
+#include <immintrin.h>
+
+#include "Singular_Value_Decomposition_Kernel.h"
+
+namespace Singular_Value_Decomposition{
+namespace{
+
+//#####################################################################
+// Class SIMD_SCALAR
+//#####################################################################
+struct SIMD_SCALAR
+{
+    union T{float f;unsigned int ui;};
+    enum {width=1};
+
+    static T Load(const float* p){T r;r.f=*p;return r;}
+    static void Store(float* p,const T a){*p=a.f;}
+    static T Set(const float f){T r;r.f=f;return r;}
+    static T Zero(){T r;r.f=0.;return r;}
+
+    static T Add(const T a,const T b){T r;r.f=a.f+b.f;return r;}
+    static T Sub(const T a,const T b){T r;r.f=a.f-b.f;return r;}
+    static T Mul(const T a,const T b){T r;r.f=a.f*b.f;return r;}
+    static T Max(const T a,const T b){T r;r.f=a.f<b.f?b.f:a.f;return r;}
+    static T Rsqrt(const T a){T r;_mm_store_ss(&r.f,_mm_rsqrt_ss(_mm_set_ss(a.f)));return r;}
+
+    static T And(const T a,const T b){T r;r.ui=a.ui&b.ui;return r;}
+    static T Andnot(const T a,const T b){T r;r.ui=~a.ui&b.ui;return r;}
+    static T Or(const T a,const T b){T r;r.ui=a.ui|b.ui;return r;}
+    static T Xor(const T a,const T b){T r;r.ui=a.ui^b.ui;return r;}
+
+    static T Cmp_Ge(const T a,const T b){T r;r.ui=(a.f>=b.f)?0xffffffff:0;return r;}
+    static T Cmp_Le(const T a,const T b){T r;r.ui=(a.f<=b.f)?0xffffffff:0;return r;}
+    static T Cmp_Lt(const T a,const T b){T r;r.ui=(a.f<b.f)?0xffffffff:0;return r;}
+    static bool All(const T mask){return mask.ui!=0;}
+};
+
+//#####################################################################
+// Class SIMD_SSE
+//#####################################################################
+struct SIMD_SSE
+{
+    typedef __m128 T;
+    enum {width=4};
+
+    static T Load(const float* p){return _mm_loadu_ps(p);}
+    static void Store(float* p,const T a){_mm_storeu_ps(p,a);}
+    static T Set(const float f){return _mm_set1_ps(f);}
+    static T Zero(){return _mm_setzero_ps();}
+
+    static T Add(const T a,const T b){return _mm_add_ps(a,b);}
+    static T Sub(const T a,const T b){return _mm_sub_ps(a,b);}
+    static T Mul(const T a,const T b){return _mm_mul_ps(a,b);}
+    static T Max(const T a,const T b){return _mm_max_ps(a,b);}
+    static T Rsqrt(const T a){return _mm_rsqrt_ps(a);}
+
+    static T And(const T a,const T b){return _mm_and_ps(a,b);}
+    static T Andnot(const T a,const T b){return _mm_andnot_ps(a,b);}
+    static T Or(const T a,const T b){return _mm_or_ps(a,b);}
+    static T Xor(const T a,const T b){return _mm_xor_ps(a,b);}
+
+    static T Cmp_Ge(const T a,const T b){return _mm_cmpge_ps(a,b);}
+    static T Cmp_Le(const T a,const T b){return _mm_cmple_ps(a,b);}
+    static T Cmp_Lt(const T a,const T b){return _mm_cmplt_ps(a,b);}
+    static bool All(const T mask){return _mm_movemask_ps(mask)==0xf;}
+};
+
+#ifdef __AVX__
+//#####################################################################
+// Class SIMD_AVX
+//#####################################################################
+struct SIMD_AVX
+{
+    typedef __m256 T;
+    enum {width=8};
+
+    static T Load(const float* p){return _mm256_loadu_ps(p);}
+    static void Store(float* p,const T a){_mm256_storeu_ps(p,a);}
+    static T Set(const float f){return _mm256_set1_ps(f);}
+    static T Zero(){return _mm256_setzero_ps();}
+
+    static T Add(const T a,const T b){return _mm256_add_ps(a,b);}
+    static T Sub(const T a,const T b){return _mm256_sub_ps(a,b);}
+    static T Mul(const T a,const T b){return _mm256_mul_ps(a,b);}
+    static T Max(const T a,const T b){return _mm256_max_ps(a,b);}
+    static T Rsqrt(const T a){return _mm256_rsqrt_ps(a);}
+
+    static T And(const T a,const T b){return _mm256_and_ps(a,b);}
+    static T Andnot(const T a,const T b){return _mm256_andnot_ps(a,b);}
+    static T Or(const T a,const T b){return _mm256_or_ps(a,b);}
+    static T Xor(const T a,const T b){return _mm256_xor_ps(a,b);}
+
+    static T Cmp_Ge(const T a,const T b){return _mm256_cmp_ps(a,b,_CMP_GE_OS);}
+    static T Cmp_Le(const T a,const T b){return _mm256_cmp_ps(a,b,_CMP_LE_OS);}
+    static T Cmp_Lt(const T a,const T b){return _mm256_cmp_ps(a,b,_CMP_LT_OS);}
+    static bool All(const T mask){return _mm256_movemask_ps(mask)==0xff;}
+};
+#endif
+
+#ifdef __AVX512F__
+//#####################################################################
+// Class SIMD_AVX512
+//#####################################################################
+// AVX-512F has no floating point logic, the masks are integer vectors of all ones lanes
+struct SIMD_AVX512
+{
+    typedef __m512 T;
+    enum {width=16};
+
+    static T Load(const float* p){return _mm512_loadu_ps(p);}
+    static void Store(float* p,const T a){_mm512_storeu_ps(p,a);}
+    static T Set(const float f){return _mm512_set1_ps(f);}
+    static T Zero(){return _mm512_setzero_ps();}
+
+    static T Add(const T a,const T b){return _mm512_add_ps(a,b);}
+    static T Sub(const T a,const T b){return _mm512_sub_ps(a,b);}
+    static T Mul(const T a,const T b){return _mm512_mul_ps(a,b);}
+    static T Max(const T a,const T b){return _mm512_max_ps(a,b);}
+    static T Rsqrt(const T a){return _mm512_rsqrt14_ps(a);}
+
+    static T And(const T a,const T b){return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a),_mm512_castps_si512(b)));}
+    static T Andnot(const T a,const T b){return _mm512_castsi512_ps(_mm512_andnot_si512(_mm512_castps_si512(a),_mm512_castps_si512(b)));}
+    static T Or(const T a,const T b){return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a),_mm512_castps_si512(b)));}
+    static T Xor(const T a,const T b){return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a),_mm512_castps_si512(b)));}
+
+    static T Mask(const __mmask16 mask){return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(mask,-1));}
+    static T Cmp_Ge(const T a,const T b){return Mask(_mm512_cmp_ps_mask(a,b,_CMP_GE_OS));}
+    static T Cmp_Le(const T a,const T b){return Mask(_mm512_cmp_ps_mask(a,b,_CMP_LE_OS));}
+    static T Cmp_Lt(const T a,const T b){return Mask(_mm512_cmp_ps_mask(a,b,_CMP_LT_OS));}
+    static bool All(const T mask){return _mm512_cmpneq_epi32_mask(_mm512_castps_si512(mask),_mm512_setzero_si512())==0xffff;}
+};
+#endif
+
+//#####################################################################
+// Class KERNEL_CONSTANTS
+//#####################################################################
+template<class SIMD>
+struct KERNEL_CONSTANTS
+{
+    typedef typename SIMD::T T;
+    T four_gamma_squared,sine_pi_over_eight,cosine_pi_over_eight,one_half,one,tiny_number,small_number,minus_two,jacobi_tolerance_squared;
+
+    explicit KERNEL_CONSTANTS(const float jacobi_tolerance)
+    {
+        const float Four_Gamma_Squared=sqrt(8.)+3.;
+        const float Sine_Pi_Over_Eight=.5*sqrt(2.-sqrt(2.));
+        const float Cosine_Pi_Over_Eight=.5*sqrt(2.+sqrt(2.));
+
+        four_gamma_squared=SIMD::Set(Four_Gamma_Squared);
+        sine_pi_over_eight=SIMD::Set(Sine_Pi_Over_Eight);
+        cosine_pi_over_eight=SIMD::Set(Cosine_Pi_Over_Eight);
+        one_half=SIMD::Set(.5);
+        one=SIMD::Set(1.);
+        tiny_number=SIMD::Set(1.e-20);
+        small_number=SIMD::Set(1.e-12);
+        minus_two=SIMD::Set(-2.);
+        jacobi_tolerance_squared=SIMD::Set(jacobi_tolerance*jacobi_tolerance);
+    }
+};
+
+//#####################################################################
+// Function Jacobi_Conjugation
+//#####################################################################
+// Conjugates the symmetric S with the Givens rotation annihilating s21 and accumulates it into the quaternion (qvs,qvvx,qvvy,qvvz).
+// The other two conjugations pass the same arguments cyclically permuted
+template<class SIMD> inline void
+Jacobi_Conjugation(typename SIMD::T& s11,typename SIMD::T& s21,typename SIMD::T& s31,typename SIMD::T& s22,typename SIMD::T& s32,typename SIMD::T&,
+    typename SIMD::T& qvs,typename SIMD::T& qvvx,typename SIMD::T& qvvy,typename SIMD::T& qvvz,const KERNEL_CONSTANTS<SIMD>& k)
+{
+    typedef typename SIMD::T T;
+    T c,s,ch,sh,tmp1,tmp2,tmp3,tmp4,tmp5;
+
+    // Compute the Givens angle (and half-angle)
+
+    sh=SIMD::Mul(s21,k.one_half);
+    tmp5=SIMD::Sub(s11,s22);
+
+    tmp2=SIMD::Mul(sh,sh);
+    tmp1=SIMD::Cmp_Ge(tmp2,k.tiny_number);
+    sh=SIMD::And(tmp1,sh);
+    ch=SIMD::And(tmp1,tmp5);
+    tmp2=SIMD::Andnot(tmp1,k.one);
+    ch=SIMD::Or(ch,tmp2);
+
+    tmp1=SIMD::Mul(sh,sh);
+    tmp2=SIMD::Mul(ch,ch);
+    tmp3=SIMD::Add(tmp1,tmp2);
+    tmp4=SIMD::Rsqrt(tmp3);
+
+    s=SIMD::Mul(tmp4,k.one_half);
+    c=SIMD::Mul(tmp4,s);
+    c=SIMD::Mul(tmp4,c);
+    c=SIMD::Mul(tmp3,c);
+    tmp4=SIMD::Add(tmp4,s);
+    tmp4=SIMD::Sub(tmp4,c);
+
+    sh=SIMD::Mul(tmp4,sh);
+    ch=SIMD::Mul(tmp4,ch);
+
+    tmp1=SIMD::Mul(k.four_gamma_squared,tmp1);
+    tmp1=SIMD::Cmp_Le(tmp2,tmp1);
+
+    tmp2=SIMD::And(k.sine_pi_over_eight,tmp1);
+    sh=SIMD::Andnot(tmp1,sh);
+    sh=SIMD::Or(sh,tmp2);
+    tmp2=SIMD::And(k.cosine_pi_over_eight,tmp1);
+    ch=SIMD::Andnot(tmp1,ch);
+    ch=SIMD::Or(ch,tmp2);
+
+    tmp1=SIMD::Mul(sh,sh);
+    tmp2=SIMD::Mul(ch,ch);
+    c=SIMD::Sub(tmp2,tmp1);
+    s=SIMD::Mul(ch,sh);
+    s=SIMD::Add(s,s);
+
+    // Perform the actual Givens conjugation
+
+    tmp1=SIMD::Mul(s,s31);
+    tmp2=SIMD::Mul(s,s32);
+    s31=SIMD::Mul(c,s31);
+    s32=SIMD::Mul(c,s32);
+    s31=SIMD::Add(tmp2,s31);
+    s32=SIMD::Sub(s32,tmp1);
+
+    tmp2=SIMD::Mul(s,s);
+    tmp1=SIMD::Mul(s22,tmp2);
+    tmp3=SIMD::Mul(s11,tmp2);
+    tmp4=SIMD::Mul(c,c);
+    s11=SIMD::Mul(s11,tmp4);
+    s22=SIMD::Mul(s22,tmp4);
+    s11=SIMD::Add(s11,tmp1);
+    s22=SIMD::Add(s22,tmp3);
+    tmp4=SIMD::Sub(tmp4,tmp2);
+    tmp2=SIMD::Add(s21,s21);
+    s21=SIMD::Mul(s21,tmp4);
+    tmp4=SIMD::Mul(c,s);
+    tmp2=SIMD::Mul(tmp2,tmp4);
+    tmp5=SIMD::Mul(tmp5,tmp4);
+    s11=SIMD::Add(s11,tmp2);
+    s21=SIMD::Sub(s21,tmp5);
+    s22=SIMD::Sub(s22,tmp2);
+
+    // Compute the cumulative rotation, in quaternion form
+
+    tmp1=SIMD::Mul(sh,qvvx);
+    tmp2=SIMD::Mul(sh,qvvy);
+    tmp3=SIMD::Mul(sh,qvvz);
+    sh=SIMD::Mul(sh,qvs);
+
+    qvs=SIMD::Mul(ch,qvs);
+    qvvx=SIMD::Mul(ch,qvvx);
+    qvvy=SIMD::Mul(ch,qvvy);
+    qvvz=SIMD::Mul(ch,qvvz);
+
+    qvvz=SIMD::Add(qvvz,sh);
+    qvs=SIMD::Sub(qvs,tmp3);
+    qvvx=SIMD::Add(qvvx,tmp2);
+    qvvy=SIMD::Sub(qvvy,tmp1);
+}
+
+//#####################################################################
+// Function Givens_Rotation
+//#####################################################################
+// (x,y) <- (c*x+s*y,c*y-s*x)
+template<class SIMD> inline void
+Givens_Rotation(typename SIMD::T& x,typename SIMD::T& y,const typename SIMD::T c,const typename SIMD::T s)
+{
+    typedef typename SIMD::T T;
+    T tmp1=SIMD::Mul(s,x);
+    T tmp2=SIMD::Mul(s,y);
+    x=SIMD::Mul(c,x);
+    y=SIMD::Mul(c,y);
+    x=SIMD::Add(x,tmp2);
+    y=SIMD::Sub(y,tmp1);
+}
+
+//#####################################################################
+// Function Givens_QR_Factorization
+//#####################################################################
+// Annihilates anpivot against apivot, rotating the rows (a11,a12,a13),(a21,a22,a23) of A and the columns (u11,u21,u31),(u12,u22,u32) of U
+template<class SIMD> inline void
+Givens_QR_Factorization(const typename SIMD::T apivot,const typename SIMD::T anpivot,
+    typename SIMD::T& a11,typename SIMD::T& a21,typename SIMD::T& a12,typename SIMD::T& a22,typename SIMD::T& a13,typename SIMD::T& a23,
+    typename SIMD::T& u11,typename SIMD::T& u12,typename SIMD::T& u21,typename SIMD::T& u22,typename SIMD::T& u31,typename SIMD::T& u32,
+    const KERNEL_CONSTANTS<SIMD>& k)
+{
+    typedef typename SIMD::T T;
+    T c,s,ch,sh,tmp1,tmp2,tmp3,tmp4,tmp5;
+
+    // Compute the Givens half-angle, construct the Givens quaternion and the rotation sine/cosine (for the full angle)
+
+    sh=SIMD::Mul(anpivot,anpivot);
+    sh=SIMD::Cmp_Ge(sh,k.small_number);
+    sh=SIMD::And(sh,anpivot);
+
+    tmp5=SIMD::Zero();
+    ch=SIMD::Sub(tmp5,apivot);
+    ch=SIMD::Max(ch,apivot);
+    ch=SIMD::Max(ch,k.small_number);
+    tmp5=SIMD::Cmp_Ge(apivot,tmp5);
+
+    tmp1=SIMD::Mul(ch,ch);
+    tmp2=SIMD::Mul(sh,sh);
+    tmp2=SIMD::Add(tmp1,tmp2);
+    tmp1=SIMD::Rsqrt(tmp2);
+
+    tmp4=SIMD::Mul(tmp1,k.one_half);
+    tmp3=SIMD::Mul(tmp1,tmp4);
+    tmp3=SIMD::Mul(tmp1,tmp3);
+    tmp3=SIMD::Mul(tmp2,tmp3);
+    tmp1=SIMD::Add(tmp1,tmp4);
+    tmp1=SIMD::Sub(tmp1,tmp3);
+    tmp1=SIMD::Mul(tmp1,tmp2);
+
+    ch=SIMD::Add(ch,tmp1);
+
+    tmp1=SIMD::Andnot(tmp5,sh);
+    tmp2=SIMD::Andnot(tmp5,ch);
+    ch=SIMD::And(tmp5,ch);
+    sh=SIMD::And(tmp5,sh);
+    ch=SIMD::Or(ch,tmp1);
+    sh=SIMD::Or(sh,tmp2);
+
+    tmp1=SIMD::Mul(ch,ch);
+    tmp2=SIMD::Mul(sh,sh);
+    tmp2=SIMD::Add(tmp1,tmp2);
+    tmp1=SIMD::Rsqrt(tmp2);
+
+    tmp4=SIMD::Mul(tmp1,k.one_half);
+    tmp3=SIMD::Mul(tmp1,tmp4);
+    tmp3=SIMD::Mul(tmp1,tmp3);
+    tmp3=SIMD::Mul(tmp2,tmp3);
+    tmp1=SIMD::Add(tmp1,tmp4);
+    tmp1=SIMD::Sub(tmp1,tmp3);
+
+    ch=SIMD::Mul(ch,tmp1);
+    sh=SIMD::Mul(sh,tmp1);
+
+    c=SIMD::Mul(ch,ch);
+    s=SIMD::Mul(sh,sh);
+    c=SIMD::Sub(c,s);
+    s=SIMD::Mul(sh,ch);
+    s=SIMD::Add(s,s);
+
+    // Rotate matrix A
+
+    Givens_Rotation<SIMD>(a11,a21,c,s);
+    Givens_Rotation<SIMD>(a12,a22,c,s);
+    Givens_Rotation<SIMD>(a13,a23,c,s);
+
+    // Update matrix U
+
+    Givens_Rotation<SIMD>(u11,u12,c,s);
+    Givens_Rotation<SIMD>(u21,u22,c,s);
+    Givens_Rotation<SIMD>(u31,u32,c,s);
+}
+
+//#####################################################################
+// Function Conditional_Swap
+//#####################################################################
+// swaps x and y in the lanes of mask
+template<class SIMD> inline void
+Conditional_Swap(const typename SIMD::T mask,typename SIMD::T& x,typename SIMD::T& y)
+{
+    typename SIMD::T tmp5=SIMD::Xor(x,y);
+    tmp5=SIMD::And(tmp5,mask);
+    x=SIMD::Xor(x,tmp5);
+    y=SIMD::Xor(y,tmp5);
+}
+
+//#####################################################################
+// Function Conditional_Negation
+//#####################################################################
+// -1 in the lanes of mask, 1 in the others
+template<class SIMD> inline typename SIMD::T
+Conditional_Negation(const typename SIMD::T mask,const KERNEL_CONSTANTS<SIMD>& k)
+{
+    typename SIMD::T tmp5=SIMD::And(k.minus_two,mask);
+    return SIMD::Add(k.one,tmp5);
+}
+
+//#####################################################################
+// Function Singular_Value_Decomposition_Kernel
+//#####################################################################
+// Decomposes the matrices [imin,imax_plus_one) of data, both multiples of SIMD::width. Returns the Jacobi sweeps run, summed over the SIMD vectors
+template<class SIMD> long long
+Singular_Value_Decomposition_Kernel(const KERNEL_DATA& data,const int imin,const int imax_plus_one,const float jacobi_tolerance)
+{
+    typedef typename SIMD::T T;
+    const KERNEL_CONSTANTS<SIMD> k(jacobi_tolerance);
+    // a value of zero always runs the full number of sweeps
+    const bool jacobi_early_exit=jacobi_tolerance>0;
+    long long jacobi_sweeps=0;
+
+    for(int index=imin;index<imax_plus_one;index+=SIMD::width){
+    T a11=SIMD::Load(data.a[0]+index),a12=SIMD::Load(data.a[1]+index),a13=SIMD::Load(data.a[2]+index);
+    T a21=SIMD::Load(data.a[3]+index),a22=SIMD::Load(data.a[4]+index),a23=SIMD::Load(data.a[5]+index);
+    T a31=SIMD::Load(data.a[6]+index),a32=SIMD::Load(data.a[7]+index),a33=SIMD::Load(data.a[8]+index);
+    T v11,v21,v31,v12,v22,v32,v13,v23,v33;
+    T tmp1,tmp2,tmp3,tmp4;
+
+    { // Begin block : Scope of qV
+
+    T qvs=k.one,qvvx=SIMD::Zero(),qvvy=SIMD::Zero(),qvvz=SIMD::Zero();
+
+    { // Begin block : Symmetric eigenanalysis
+
+    //###########################################################
+    // Compute normal equations matrix
+    //###########################################################
+
+    T s11=SIMD::Mul(a11,a11);
+    tmp1=SIMD::Mul(a21,a21);
+    s11=SIMD::Add(tmp1,s11);
+    tmp1=SIMD::Mul(a31,a31);
+    s11=SIMD::Add(tmp1,s11);
+
+    T s21=SIMD::Mul(a12,a11);
+    tmp1=SIMD::Mul(a22,a21);
+    s21=SIMD::Add(tmp1,s21);
+    tmp1=SIMD::Mul(a32,a31);
+    s21=SIMD::Add(tmp1,s21);
+
+    T s31=SIMD::Mul(a13,a11);
+    tmp1=SIMD::Mul(a23,a21);
+    s31=SIMD::Add(tmp1,s31);
+    tmp1=SIMD::Mul(a33,a31);
+    s31=SIMD::Add(tmp1,s31);
+
+    T s22=SIMD::Mul(a12,a12);
+    tmp1=SIMD::Mul(a22,a22);
+    s22=SIMD::Add(tmp1,s22);
+    tmp1=SIMD::Mul(a32,a32);
+    s22=SIMD::Add(tmp1,s22);
+
+    T s32=SIMD::Mul(a13,a12);
+    tmp1=SIMD::Mul(a23,a22);
+    s32=SIMD::Add(tmp1,s32);
+    tmp1=SIMD::Mul(a33,a32);
+    s32=SIMD::Add(tmp1,s32);
+
+    T s33=SIMD::Mul(a13,a13);
+    tmp1=SIMD::Mul(a23,a23);
+    s33=SIMD::Add(tmp1,s33);
+    tmp1=SIMD::Mul(a33,a33);
+    s33=SIMD::Add(tmp1,s33);
+
+    //###########################################################
+    // Solve symmetric eigenproblem using Jacobi iteration
+    //###########################################################
+
+    for(int sweep=1;sweep<=4;sweep++){
+
+        Jacobi_Conjugation<SIMD>(s11,s21,s31,s22,s32,s33,qvs,qvvx,qvvy,qvvz,k);
+        Jacobi_Conjugation<SIMD>(s22,s32,s21,s33,s31,s11,qvs,qvvy,qvvz,qvvx,k);
+        Jacobi_Conjugation<SIMD>(s33,s31,s32,s11,s21,s22,qvs,qvvz,qvvx,qvvy,k);
+
+        jacobi_sweeps++;
+
+        // Stop when the off-diagonal part of S is below the tolerance, relative to its diagonal, in every lane
+        if(jacobi_early_exit){
+        tmp1=SIMD::Mul(s21,s21);
+        tmp2=SIMD::Mul(s31,s31);
+        tmp1=SIMD::Add(tmp1,tmp2);
+        tmp2=SIMD::Mul(s32,s32);
+        tmp1=SIMD::Add(tmp1,tmp2);
+
+        tmp2=SIMD::Mul(s11,s11);
+        tmp3=SIMD::Mul(s22,s22);
+        tmp2=SIMD::Add(tmp2,tmp3);
+        tmp3=SIMD::Mul(s33,s33);
+        tmp2=SIMD::Add(tmp2,tmp3);
+        tmp2=SIMD::Mul(tmp2,k.jacobi_tolerance_squared);
+
+        tmp1=SIMD::Cmp_Le(tmp1,tmp2);
+        if(SIMD::All(tmp1)) break;}
+    }
+
+    } // End block : Symmetric eigenanalysis
+
+    //###########################################################
+    // Normalize quaternion for matrix V
+    //###########################################################
+
+    tmp2=SIMD::Mul(qvs,qvs);
+    tmp1=SIMD::Mul(qvvx,qvvx);
+    tmp2=SIMD::Add(tmp1,tmp2);
+    tmp1=SIMD::Mul(qvvy,qvvy);
+    tmp2=SIMD::Add(tmp1,tmp2);
+    tmp1=SIMD::Mul(qvvz,qvvz);
+    tmp2=SIMD::Add(tmp1,tmp2);
+
+    tmp1=SIMD::Rsqrt(tmp2);
+    tmp4=SIMD::Mul(tmp1,k.one_half);
+    tmp3=SIMD::Mul(tmp1,tmp4);
+    tmp3=SIMD::Mul(tmp1,tmp3);
+    tmp3=SIMD::Mul(tmp2,tmp3);
+    tmp1=SIMD::Add(tmp1,tmp4);
+    tmp1=SIMD::Sub(tmp1,tmp3);
+
+    qvs=SIMD::Mul(qvs,tmp1);
+    qvvx=SIMD::Mul(qvvx,tmp1);
+    qvvy=SIMD::Mul(qvvy,tmp1);
+    qvvz=SIMD::Mul(qvvz,tmp1);
+
+    //###########################################################
+    // Transform quaternion to matrix V
+    //###########################################################
+
+    tmp1=SIMD::Mul(qvvx,qvvx);
+    tmp2=SIMD::Mul(qvvy,qvvy);
+    tmp3=SIMD::Mul(qvvz,qvvz);
+    v11=SIMD::Mul(qvs,qvs);
+    v22=SIMD::Sub(v11,tmp1);
+    v33=SIMD::Sub(v22,tmp2);
+    v33=SIMD::Add(v33,tmp3);
+    v22=SIMD::Add(v22,tmp2);
+    v22=SIMD::Sub(v22,tmp3);
+    v11=SIMD::Add(v11,tmp1);
+    v11=SIMD::Sub(v11,tmp2);
+    v11=SIMD::Sub(v11,tmp3);
+    tmp1=SIMD::Add(qvvx,qvvx);
+    tmp2=SIMD::Add(qvvy,qvvy);
+    tmp3=SIMD::Add(qvvz,qvvz);
+    v32=SIMD::Mul(qvs,tmp1);
+    v13=SIMD::Mul(qvs,tmp2);
+    v21=SIMD::Mul(qvs,tmp3);
+    tmp1=SIMD::Mul(qvvy,tmp1);
+    tmp2=SIMD::Mul(qvvz,tmp2);
+    tmp3=SIMD::Mul(qvvx,tmp3);
+    v12=SIMD::Sub(tmp1,v21);
+    v23=SIMD::Sub(tmp2,v32);
+    v31=SIMD::Sub(tmp3,v13);
+    v21=SIMD::Add(tmp1,v21);
+    v32=SIMD::Add(tmp2,v32);
+    v13=SIMD::Add(tmp3,v13);
+
+    } // End block : Scope of qV
+
+    //###########################################################
+    // Multiply (from the right) with V
+    //###########################################################
+
+    tmp2=a12;
+    tmp3=a13;
+    a12=SIMD::Mul(v12,a11);
+    a13=SIMD::Mul(v13,a11);
+    a11=SIMD::Mul(v11,a11);
+    tmp1=SIMD::Mul(v21,tmp2);
+    a11=SIMD::Add(a11,tmp1);
+    tmp1=SIMD::Mul(v31,tmp3);
+    a11=SIMD::Add(a11,tmp1);
+    tmp1=SIMD::Mul(v22,tmp2);
+    a12=SIMD::Add(a12,tmp1);
+    tmp1=SIMD::Mul(v32,tmp3);
+    a12=SIMD::Add(a12,tmp1);
+    tmp1=SIMD::Mul(v23,tmp2);
+    a13=SIMD::Add(a13,tmp1);
+    tmp1=SIMD::Mul(v33,tmp3);
+    a13=SIMD::Add(a13,tmp1);
+
+    tmp2=a22;
+    tmp3=a23;
+    a22=SIMD::Mul(v12,a21);
+    a23=SIMD::Mul(v13,a21);
+    a21=SIMD::Mul(v11,a21);
+    tmp1=SIMD::Mul(v21,tmp2);
+    a21=SIMD::Add(a21,tmp1);
+    tmp1=SIMD::Mul(v31,tmp3);
+    a21=SIMD::Add(a21,tmp1);
+    tmp1=SIMD::Mul(v22,tmp2);
+    a22=SIMD::Add(a22,tmp1);
+    tmp1=SIMD::Mul(v32,tmp3);
+    a22=SIMD::Add(a22,tmp1);
+    tmp1=SIMD::Mul(v23,tmp2);
+    a23=SIMD::Add(a23,tmp1);
+    tmp1=SIMD::Mul(v33,tmp3);
+    a23=SIMD::Add(a23,tmp1);
+
+    tmp2=a32;
+    tmp3=a33;
+    a32=SIMD::Mul(v12,a31);
+    a33=SIMD::Mul(v13,a31);
+    a31=SIMD::Mul(v11,a31);
+    tmp1=SIMD::Mul(v21,tmp2);
+    a31=SIMD::Add(a31,tmp1);
+    tmp1=SIMD::Mul(v31,tmp3);
+    a31=SIMD::Add(a31,tmp1);
+    tmp1=SIMD::Mul(v22,tmp2);
+    a32=SIMD::Add(a32,tmp1);
+    tmp1=SIMD::Mul(v32,tmp3);
+    a32=SIMD::Add(a32,tmp1);
+    tmp1=SIMD::Mul(v23,tmp2);
+    a33=SIMD::Add(a33,tmp1);
+    tmp1=SIMD::Mul(v33,tmp3);
+    a33=SIMD::Add(a33,tmp1);
+
+    //###########################################################
+    // Permute columns such that the singular values are sorted
+    //###########################################################
+
+    tmp1=SIMD::Mul(a11,a11);
+    tmp4=SIMD::Mul(a21,a21);
+    tmp1=SIMD::Add(tmp1,tmp4);
+    tmp4=SIMD::Mul(a31,a31);
+    tmp1=SIMD::Add(tmp1,tmp4);
+
+    tmp2=SIMD::Mul(a12,a12);
+    tmp4=SIMD::Mul(a22,a22);
+    tmp2=SIMD::Add(tmp2,tmp4);
+    tmp4=SIMD::Mul(a32,a32);
+    tmp2=SIMD::Add(tmp2,tmp4);
+
+    tmp3=SIMD::Mul(a13,a13);
+    tmp4=SIMD::Mul(a23,a23);
+    tmp3=SIMD::Add(tmp3,tmp4);
+    tmp4=SIMD::Mul(a33,a33);
+    tmp3=SIMD::Add(tmp3,tmp4);
+
+    // Swap columns 1-2 if necessary, then negate the 2nd column of A and V so that V is still a rotation
+
+    tmp4=SIMD::Cmp_Lt(tmp1,tmp2);
+    Conditional_Swap<SIMD>(tmp4,a11,a12);
+    Conditional_Swap<SIMD>(tmp4,a21,a22);
+    Conditional_Swap<SIMD>(tmp4,a31,a32);
+    Conditional_Swap<SIMD>(tmp4,v11,v12);
+    Conditional_Swap<SIMD>(tmp4,v21,v22);
+    Conditional_Swap<SIMD>(tmp4,v31,v32);
+    Conditional_Swap<SIMD>(tmp4,tmp1,tmp2);
+
+    tmp4=Conditional_Negation<SIMD>(tmp4,k);
+    a12=SIMD::Mul(a12,tmp4);
+    a22=SIMD::Mul(a22,tmp4);
+    a32=SIMD::Mul(a32,tmp4);
+    v12=SIMD::Mul(v12,tmp4);
+    v22=SIMD::Mul(v22,tmp4);
+    v32=SIMD::Mul(v32,tmp4);
+
+    // Swap columns 1-3 if necessary, then negate the 1st column of A and V
+
+    tmp4=SIMD::Cmp_Lt(tmp1,tmp3);
+    Conditional_Swap<SIMD>(tmp4,a11,a13);
+    Conditional_Swap<SIMD>(tmp4,a21,a23);
+    Conditional_Swap<SIMD>(tmp4,a31,a33);
+    Conditional_Swap<SIMD>(tmp4,v11,v13);
+    Conditional_Swap<SIMD>(tmp4,v21,v23);
+    Conditional_Swap<SIMD>(tmp4,v31,v33);
+    Conditional_Swap<SIMD>(tmp4,tmp1,tmp3);
+
+    tmp4=Conditional_Negation<SIMD>(tmp4,k);
+    a11=SIMD::Mul(a11,tmp4);
+    a21=SIMD::Mul(a21,tmp4);
+    a31=SIMD::Mul(a31,tmp4);
+    v11=SIMD::Mul(v11,tmp4);
+    v21=SIMD::Mul(v21,tmp4);
+    v31=SIMD::Mul(v31,tmp4);
+
+    // Swap columns 2-3 if necessary, then negate the 3rd column of A and V
+
+    tmp4=SIMD::Cmp_Lt(tmp2,tmp3);
+    Conditional_Swap<SIMD>(tmp4,a12,a13);
+    Conditional_Swap<SIMD>(tmp4,a22,a23);
+    Conditional_Swap<SIMD>(tmp4,a32,a33);
+    Conditional_Swap<SIMD>(tmp4,v12,v13);
+    Conditional_Swap<SIMD>(tmp4,v22,v23);
+    Conditional_Swap<SIMD>(tmp4,v32,v33);
+    Conditional_Swap<SIMD>(tmp4,tmp2,tmp3);
+
+    tmp4=Conditional_Negation<SIMD>(tmp4,k);
+    a13=SIMD::Mul(a13,tmp4);
+    a23=SIMD::Mul(a23,tmp4);
+    a33=SIMD::Mul(a33,tmp4);
+    v13=SIMD::Mul(v13,tmp4);
+    v23=SIMD::Mul(v23,tmp4);
+    v33=SIMD::Mul(v33,tmp4);
+
+    //###########################################################
+    // Construct QR factorization of A*V (=U*D) using Givens rotations
+    //###########################################################
+
+    T u11=k.one,u21=SIMD::Zero(),u31=SIMD::Zero();
+    T u12=SIMD::Zero(),u22=k.one,u32=SIMD::Zero();
+    T u13=SIMD::Zero(),u23=SIMD::Zero(),u33=k.one;
+
+    Givens_QR_Factorization<SIMD>(a11,a21,a11,a21,a12,a22,a13,a23,u11,u12,u21,u22,u31,u32,k);
+    Givens_QR_Factorization<SIMD>(a11,a31,a11,a31,a12,a32,a13,a33,u11,u13,u21,u23,u31,u33,k);
+    Givens_QR_Factorization<SIMD>(a22,a32,a21,a31,a22,a32,a23,a33,u12,u13,u22,u23,u32,u33,k);
+
+    SIMD::Store(data.u[0]+index,u11);SIMD::Store(data.u[1]+index,u12);SIMD::Store(data.u[2]+index,u13);
+    SIMD::Store(data.u[3]+index,u21);SIMD::Store(data.u[4]+index,u22);SIMD::Store(data.u[5]+index,u23);
+    SIMD::Store(data.u[6]+index,u31);SIMD::Store(data.u[7]+index,u32);SIMD::Store(data.u[8]+index,u33);
+    SIMD::Store(data.v[0]+index,v11);SIMD::Store(data.v[1]+index,v12);SIMD::Store(data.v[2]+index,v13);
+    SIMD::Store(data.v[3]+index,v21);SIMD::Store(data.v[4]+index,v22);SIMD::Store(data.v[5]+index,v23);
+    SIMD::Store(data.v[6]+index,v31);SIMD::Store(data.v[7]+index,v32);SIMD::Store(data.v[8]+index,v33);
+    SIMD::Store(data.sigma[0]+index,a11);SIMD::Store(data.sigma[1]+index,a22);SIMD::Store(data.sigma[2]+index,a33);
+    }
+
+    return jacobi_sweeps;
+}
+}
+}
+#endif
@@ -0,0 +1,43 @@
+//#####################################################################
+// Variants of the Singular Value Decomposition kernel
+//#####################################################################
+// Compiled once per instruction set with one of -DKERNEL_SCALAR,
+// -DKERNEL_SSE, -DKERNEL_AVX or -DKERNEL_AVX512 and the matching code
+// generation flags (none, -msse, -mavx, -mavx512f; /arch:AVX, /arch:AVX512
+// for Visual C++). Each object instantiates the template for its set only
+// and exports it as Kernel_<set>, see Singular_Value_Decomposition_Kernel.h.
+//#####################################################################
+
+#include "Singular_Value_Decomposition_Kernel_Template.hpp"
+
+#if defined(KERNEL_SCALAR)
+#define KERNEL_NAME Kernel_Scalar
+#define KERNEL_SIMD SIMD_SCALAR
+#elif defined(KERNEL_SSE)
+#define KERNEL_NAME Kernel_SSE
+#define KERNEL_SIMD SIMD_SSE
+#elif defined(KERNEL_AVX)
+#ifndef __AVX__
+#error "KERNEL_AVX needs the AVX code generation flags"
+#endif
+#define KERNEL_NAME Kernel_AVX
+#define KERNEL_SIMD SIMD_AVX
+#elif defined(KERNEL_AVX512)
+#ifndef __AVX512F__
+#error "KERNEL_AVX512 needs the AVX-512F code generation flags"
+#endif
+#define KERNEL_NAME Kernel_AVX512
+#define KERNEL_SIMD SIMD_AVX512
+#else
+#error "define one of KERNEL_SCALAR, KERNEL_SSE, KERNEL_AVX, KERNEL_AVX512"
+#endif
+
+//#####################################################################
+// Function Kernel_<set>
+//#####################################################################
+long long Singular_Value_Decomposition::
+KERNEL_NAME(const KERNEL_DATA& data,const int imin,const int imax_plus_one,const float jacobi_tolerance)
+{
+    return Singular_Value_Decomposition_Kernel<KERNEL_SIMD>(data,imin,imax_plus_one,jacobi_tolerance);
+}
+//#####################################################################
@@ -0,0 +1,220 @@
+//#####################################################################
+// Streaming decomposition of a file of matrices
+//#####################################################################
+// Decomposes a file of packed 3x3 matrices (9 floats, row major, matrix
+// after matrix) with the templated decomposition of wavelet_spline/include/svd
+// and writes U, Sigma and V to three files in the same packed layout. The
+// files are memory mapped one window at a time (see MAPPED_FILE.h): a thread
+// maps the input of its next window and asks for its pages while it works on
+// the current one, so the peak memory does not depend on the size of the
+// input. Inside a window the matrices are decomposed in cache sized chunks,
+// the input of the next chunk is prefetched and the results are written with
+// non temporal stores. Windows are a few MB, because the page faults of small
+// file mappings cost more than the decomposition. Reports the throughput in
+// matrices/s and GB/s (input plus output bytes), the peak resident memory and
+// the reconstruction error of a sample of every chunk. The driver is built
+// for the baseline and the kernels of the wider instruction sets are linked
+// in as objects (svd_batch_kernels.h), so it runs on any x86-64 processor.
+//
+// Usage: Singular_Value_Decomposition_Mapped_Streaming_Test generate <file> <matrices> [perturbation from identity]
+//        Singular_Value_Decomposition_Mapped_Streaming_Test <number of threads> <input file> <output prefix> [chunk matrices] [window matrices]
+//#####################################################################
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib,"psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+#include <svd/svd_batch.h>
+
+#include "MAPPED_FILE.h"
+#include "PARALLEL_FOR.h"
+#include "sys_profile_timer.h"
+
+using PhysBAM::MAPPED_FILE;
+
+// matrices decomposed at a time, the input of a chunk stays in the L2 cache
+const int default_chunk=16384;
+
+// matrices mapped at a time by a thread, 9.4 MB of input and 22 MB of output
+const int default_window=262144;
+
+// matrices of every chunk whose reconstruction error is measured
+const int checked_per_chunk=16;
+
+//#####################################################################
+// Function Peak_Resident_Megabytes
+//#####################################################################
+double Peak_Resident_Megabytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(),&counters,sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize/1048576.;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF,&usage)!=0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss/1048576.;
+#else
+    return usage.ru_maxrss/1024.;
+#endif
+#endif
+}
+
+//#####################################################################
+// Function Generate
+//#####################################################################
+// random matrices of unit Frobenius norm as in the streaming test, or I+E with the entries of E uniform in [-perturbation,perturbation].
+// every window has its own seed
+int Generate(const char* name,const uint64_t size,const float perturbation)
+{
+    MAPPED_FILE file(name,true,size*9*sizeof(float));
+    if(!file.Valid()){printf("Cannot create %s\n",name);return 1;}
+
+    for(uint64_t first=0;first<size;first+=default_window){
+        const size_t count=(size_t)std::min<uint64_t>(default_window,size-first);
+        MAPPED_FILE::WINDOW window;
+        if(!file.Map(window,first*9*sizeof(float),count*9*sizeof(float))){printf("Cannot map %s\n",name);return 1;}
+        float* a=window.Pointer<float>();
+
+        std::mt19937 generator((uint32_t)(first/default_window));
+        std::uniform_real_distribution<float> uniform(-1.f,1.f);
+        for(size_t i=0;i<count;i++){
+            float* m=a+i*9;
+            if(perturbation>0) for(int k=0;k<9;k++) m[k]=(k%4==0?1.f:0.f)+perturbation*uniform(generator);
+            else{
+                float norm2=0;
+                for(int k=0;k<9;k++){m[k]=uniform(generator);norm2+=m[k]*m[k];}
+                const float scale=norm2>0?1.f/std::sqrt(norm2):0.f;
+                for(int k=0;k<9;k++) m[k]*=scale;}}}
+
+    printf("Wrote %llu matrices to %s\n",(unsigned long long)size,name);
+    return 0;
+}
+
+//#####################################################################
+// Function Reconstruction_Error
+//#####################################################################
+// max|U*Sigma*V'-A| relative to max|A| of one packed matrix
+double Reconstruction_Error(const float* a,const float* u,const float* sigma,const float* v)
+{
+    double a_max=0,error=0;
+    for(int k=0;k<9;k++) a_max=std::max(a_max,(double)std::fabs(a[k]));
+    if(a_max==0) return 0;
+    for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+        double usv=0;
+        for(int k=0;k<3;k++) usv+=(double)u[row*3+k]*sigma[k]*v[column*3+k];
+        error=std::max(error,std::fabs(usv-a[row*3+column])/a_max);}
+    return error;
+}
+
+//#####################################################################
+// Function Decompose
+//#####################################################################
+// decomposes the count matrices of a mapped window chunk by chunk, returns the largest reconstruction error of the samples
+double Decompose(const float* a,float* u,float* sigma,float* v,const size_t count,const size_t chunk,const svd::cpu::instruction_set set)
+{
+    double error=0;
+    for(size_t first=0;first<count;first+=chunk){
+        const size_t chunk_count=std::min(chunk,count-first);
+        const size_t next_count=std::min(chunk,count-std::min(count,first+chunk));
+
+        // the input of the next chunk is fetched into the L2 cache while this one is decomposed
+        const char* next=(const char*)(a+(first+chunk_count)*9);
+        for(size_t offset=0;offset<next_count*9*sizeof(float);offset+=64) _mm_prefetch(next+offset,_MM_HINT_T1);
+
+        svd::compute_batch_streaming(a+first*9,chunk_count,u+first*9,sigma+first*3,v+first*9,svd::layout_aos,set);
+
+        for(size_t i=first;i<first+std::min<size_t>(chunk_count,checked_per_chunk);i++)
+            error=std::max(error,Reconstruction_Error(a+i*9,u+i*9,sigma+i*3,v+i*9));}
+    return error;
+}
+
+int main(int argc,char* argv[])
+{
+    if(argc>=4 && std::string(argv[1])=="generate")
+        return Generate(argv[2],strtoull(argv[3],0,10),argc>4?(float)atof(argv[4]):0.f);
+
+    if(argc<4 || argc>6){
+        printf("Usage: %s generate <file> <matrices> [perturbation from identity]\n",argv[0]);
+        printf("       %s <number of threads> <input file> <output prefix> [chunk matrices] [window matrices]\n",argv[0]);
+        return 1;}
+
+    const int number_of_threads=std::max(atoi(argv[1]),1);
+    // multiples of the widest kernel, so only the last tile of the file is masked and the outputs of every chunk are 16 byte aligned
+    const int chunk=std::max((argc>4?atoi(argv[4]):default_chunk)/16*16,16);
+    const int window=std::max((argc>5?atoi(argv[5]):default_window)/chunk*chunk,chunk);
+
+    MAPPED_FILE input(argv[2]);
+    if(!input.Valid()){printf("Cannot open %s\n",argv[2]);return 1;}
+    if(input.Size()%(9*sizeof(float))){printf("%s is not a file of packed 3x3 float matrices\n",argv[2]);return 1;}
+    const uint64_t size=input.Size()/(9*sizeof(float));
+
+    const std::string prefix=argv[3];
+    MAPPED_FILE output_u((prefix+".u").c_str(),true,size*9*sizeof(float));
+    MAPPED_FILE output_sigma((prefix+".sigma").c_str(),true,size*3*sizeof(float));
+    MAPPED_FILE output_v((prefix+".v").c_str(),true,size*9*sizeof(float));
+    if(!output_u.Valid() || !output_sigma.Valid() || !output_v.Valid()){printf("Cannot create the outputs %s.u, .sigma, .v\n",argv[3]);return 1;}
+
+    const uint64_t windows=(size+window-1)/window;
+    if(windows>(uint64_t)0x7fffffff){printf("Too many windows, use larger ones\n");return 1;}
+
+    const svd::cpu::instruction_set set=svd::batch_instruction_set();
+    printf("Using %d threads, %llu matrices in windows of %d, chunks of %d, instruction set %d\n",number_of_threads,(unsigned long long)size,window,chunk,(int)set);
+
+    std::mutex error_mutex;
+    double max_error=0;
+    bool failed=false;
+
+    PhysBAM::PARALLEL_FOR parallel_for(number_of_threads);
+    sys::profile_timer timer;
+
+    parallel_for.Run(0,(int)windows,1,[&](const int wmin,const int wmax_plus_one){
+        MAPPED_FILE::WINDOW a_windows[2];
+        for(int w=wmin;w<wmax_plus_one;w++){
+            MAPPED_FILE::WINDOW& a_window=a_windows[w&1];
+            MAPPED_FILE::WINDOW& next_window=a_windows[(w+1)&1];
+            const uint64_t first=(uint64_t)w*window;
+            const size_t count=(size_t)std::min<uint64_t>(window,size-first);
+
+            // the first window of the range is not mapped ahead
+            bool mapped=a_window.Pointer<float>()!=0;
+            if(!mapped) mapped=input.Map(a_window,first*9*sizeof(float),count*9*sizeof(float));
+            if(w+1<wmax_plus_one){
+                const uint64_t next=first+window;
+                if(input.Map(next_window,next*9*sizeof(float),(size_t)std::min<uint64_t>(window,size-next)*9*sizeof(float))) next_window.Prefetch();}
+
+            MAPPED_FILE::WINDOW u_window,sigma_window,v_window;
+            if(!mapped
+                || !output_u.Map(u_window,first*9*sizeof(float),count*9*sizeof(float))
+                || !output_sigma.Map(sigma_window,first*3*sizeof(float),count*3*sizeof(float))
+                || !output_v.Map(v_window,first*9*sizeof(float),count*9*sizeof(float))){
+                std::lock_guard<std::mutex> lock(error_mutex);failed=true;return;}
+
+            const double error=Decompose(a_window.Pointer<float>(),u_window.Pointer<float>(),sigma_window.Pointer<float>(),v_window.Pointer<float>(),count,chunk,set);
+            {std::lock_guard<std::mutex> lock(error_mutex);max_error=std::max(max_error,error);}
+
+            a_window.Unmap();}});
+
+    const double seconds=timer.seconds();
+    if(failed){printf("Cannot map a window of the files\n");return 1;}
+
+    const double bytes=(double)size*(9+9+3+9)*sizeof(float);
+    printf("Seconds: %g, %.0f matrices/s, %.3f GB/s\n",seconds,size/seconds,bytes/seconds*1e-9);
+    printf("Peak resident memory: %.1f MB\n",Peak_Resident_Megabytes());
+    printf("Max reconstruction error of %d matrices per chunk: %g\n",checked_per_chunk,max_error);
+    return 0;
+}
+//#####################################################################
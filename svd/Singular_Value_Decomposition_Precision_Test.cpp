@@ -0,0 +1,331 @@
+//#####################################################################
+// Precision test of the templated svd (wavelet_spline/include/svd)
+//#####################################################################
+// Decomposes matrices A = R1 * diag(1, 1/sqrt(k), 1/k) * R2' of growing
+// condition number k with the float, double and mixed precision modes and
+// compares them against LAPACK dgesvd. Reports the relative error of the
+// largest and the smallest singular value, the reconstruction error, the
+// orthogonality of U and V and the throughput of every mode, and fails if
+// a double or mixed precision mode reconstructs A with an error above 1e-12
+// relative to its largest entry. The polar
+// section compares the rotation of the polar decomposition of near rotations
+// against U * V' of LAPACK.
+//#####################################################################
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <svd/svd.h>
+#include <svd/svd_polar.h>
+
+#include "sys_profile_timer.h"
+
+extern "C" void dgesvd_(const char* jobu,const char* jobvt,const int* m,const int* n,double* a,const int* lda,double* s,double* u,const int* ldu,double* vt,const int* ldvt,double* work,const int* lwork,int* info);
+
+// SoA planes, element k (row major) of matrix i is at [k*size+i]
+struct DATA
+{
+    int size;
+    std::vector<double> a,u,sigma,v;
+
+    explicit DATA(const int size_input)
+        :size(size_input),a(9*size_input),u(9*size_input),sigma(3*size_input),v(9*size_input)
+    {}
+};
+
+struct ERRORS
+{
+    double sigma_largest,sigma_smallest,reconstruction,orthogonality;
+};
+
+void Random_Rotation(std::mt19937& generator,double r[9])
+{
+    std::normal_distribution<double> normal;
+    double x=normal(generator),y=normal(generator),z=normal(generator),w=normal(generator);
+    const double n=1./std::sqrt(x*x+y*y+z*z+w*w);x*=n;y*=n;z*=n;w*=n;
+    r[0]=1-2*(y*y+z*z);r[1]=2*(x*y-z*w);  r[2]=2*(x*z+y*w);
+    r[3]=2*(x*y+z*w);  r[4]=1-2*(x*x+z*z);r[5]=2*(y*z-x*w);
+    r[6]=2*(x*z-y*w);  r[7]=2*(y*z+x*w);  r[8]=1-2*(x*x+y*y);
+}
+
+void Initialize(DATA& data,const double condition,const unsigned seed)
+{
+    std::mt19937 generator(seed);
+    const double sigma[3]={1.,1./std::sqrt(condition),1./condition};
+    for(int i=0;i<data.size;i++){
+        double r1[9],r2[9];Random_Rotation(generator,r1);Random_Rotation(generator,r2);
+        for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+            double sum=0;for(int k=0;k<3;k++) sum+=r1[row*3+k]*sigma[k]*r2[column*3+k];
+            data.a[(row*3+column)*data.size+i]=sum;}}
+}
+
+// A = I + perturbation * R, entries of R uniform in [-1,1]
+void Initialize_Near_Identity(DATA& data,const double perturbation,const unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(-1.,1.);
+    for(int i=0;i<data.size;i++) for(int k=0;k<9;k++)
+        data.a[k*data.size+i]=(k%4==0?1.:0.)+perturbation*uniform(generator);
+}
+
+//#####################################################################
+// Modes
+//#####################################################################
+// from the sizes, the raw vector types drop their attributes as template arguments of a class
+template<class T,class SCALAR> struct LANES{enum{value=sizeof(T)/sizeof(SCALAR)};};
+
+template<class T,class SCALAR> inline T Load(const SCALAR* p)
+{return svd::math::load<T>(p);}
+
+template<class T> void Store(double* p,T v)
+{svd::math::store(p,v);}
+
+template<> void Store(double* p,svd::avx_vector v)
+{float f[8];svd::math::store(f,v);for(int i=0;i<8;i++) p[i]=f[i];}
+
+// float: the input is rounded to float first
+struct FLOAT_MODE
+{
+    template<class T> static void Decompose(const svd::matrix3x3<T>& a,svd::matrix3x3<T>& u,svd::vector3<T>& s,svd::matrix3x3<T>& v)
+    {svd::compute(a,u,s,v);}
+};
+
+struct DOUBLE_MODE
+{
+    template<class T> static void Decompose(const svd::matrix3x3<T>& a,svd::matrix3x3<T>& u,svd::vector3<T>& s,svd::matrix3x3<T>& v)
+    {svd::compute(a,u,s,v);}
+};
+
+// adaptive: the sweeps stop once every lane has converged to the tolerance
+struct ADAPTIVE_MODE
+{
+    static float tolerance;
+    static long long sweeps,calls;
+
+    template<class T> static void Decompose(const svd::matrix3x3<T>& a,svd::matrix3x3<T>& u,svd::vector3<T>& s,svd::matrix3x3<T>& v)
+    {sweeps+=svd::compute_adaptive(a,u,s,v,tolerance);calls++;}
+
+    static double Average_Sweeps()
+    {return calls?(double)sweeps/(double)calls:0.;}
+};
+
+float ADAPTIVE_MODE::tolerance=1e-6f;
+long long ADAPTIVE_MODE::sweeps=0,ADAPTIVE_MODE::calls=0;
+
+// mixed: the float number of the sweeps has the lanes of the double number T
+template<class T> struct MIXED_FLOAT;
+template<> struct MIXED_FLOAT<svd::cpu_scalar_double>{typedef svd::cpu_scalar type;};
+template<> struct MIXED_FLOAT<svd::avx_vector_double>{typedef svd::sse_vector type;};
+
+struct MIXED_MODE
+{
+    template<class T> static void Decompose(const svd::matrix3x3<T>& a,svd::matrix3x3<T>& u,svd::vector3<T>& s,svd::matrix3x3<T>& v)
+    {svd::compute_mixed<typename MIXED_FLOAT<T>::type,T>(a,u,s,v);}
+};
+
+template<class T,class MODE,class SCALAR> double Run(DATA& data,const std::vector<SCALAR>& a)
+{
+    const int n=data.size,width=LANES<T,SCALAR>::value;
+    sys::profile_timer timer;
+    for(int i=0;i<n;i+=width){
+        svd::matrix3x3<T> m,u,v;svd::vector3<T> s;
+        T* mm=&m.a11;for(int k=0;k<9;k++) mm[k]=Load<T>(&a[k*n+i]);
+        MODE::Decompose(m,u,s,v);
+        const T* uu=&u.a11;const T* vv=&v.a11;const T* ss=&s.x;
+        for(int k=0;k<9;k++){Store(&data.u[k*n+i],uu[k]);Store(&data.v[k*n+i],vv[k]);}
+        for(int k=0;k<3;k++) Store(&data.sigma[k*n+i],ss[k]);}
+    return timer.seconds();
+}
+
+// polar: r of A = R * S is stored in u
+enum POLAR_MODE {POLAR_USV,POLAR_ROTATION,POLAR_FULL,POLAR_NEWTON,POLAR_NEWTON_SVD};
+
+template<class T> double Run_Polar(DATA& data,const std::vector<float>& a,const POLAR_MODE mode,const float tolerance)
+{
+    const int n=data.size,width=LANES<T,float>::value;
+    sys::profile_timer timer;
+    for(int i=0;i<n;i+=width){
+        svd::matrix3x3<T> m,r,s,u,v;svd::vector3<T> sigma;
+        T* mm=&m.a11;for(int k=0;k<9;k++) mm[k]=Load<T>(&a[k*n+i]);
+        if(mode==POLAR_USV){
+            svd::compute(m,u,sigma,v);
+            T* rr=&r.a11;const T* uu=&u.a11;const T* vv=&v.a11;
+            for(int row=0;row<3;row++) for(int column=0;column<3;column++)
+                rr[row*3+column]=svd::math::dot3(uu[row*3],uu[row*3+1],uu[row*3+2],vv[column*3],vv[column*3+1],vv[column*3+2]);}
+        else if(mode==POLAR_ROTATION) r=svd::rotation_only(m,tolerance);
+        else if(mode==POLAR_FULL) svd::polar(m,r,s,tolerance);
+        else if(mode==POLAR_NEWTON) r=svd::rotation_newton(m,tolerance);
+        else r=svd::rotation_newton_svd(m,tolerance);
+        const T* rr=&r.a11;for(int k=0;k<9;k++) Store(&data.u[k*n+i],rr[k]);}
+    return timer.seconds();
+}
+
+// A = R * (I + perturbation * E), E symmetric with entries uniform in [-1,1]. the first column of every reflected-th matrix is negated
+void Initialize_Near_Rotation(DATA& data,const double perturbation,const unsigned seed,const int reflected=0)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(-1.,1.);
+    for(int i=0;i<data.size;i++){
+        double r[9],e[9];Random_Rotation(generator,r);
+        for(int row=0;row<3;row++) for(int column=row;column<3;column++)
+            e[row*3+column]=e[column*3+row]=(row==column?1.:0.)+perturbation*uniform(generator);
+        for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+            double sum=0;for(int k=0;k<3;k++) sum+=r[row*3+k]*e[k*3+column];
+            data.a[(row*3+column)*data.size+i]=(reflected && i%reflected==0 && column==0)?-sum:sum;}}
+}
+
+// sign of det(U * V') of a decomposition
+double Rotation_Sign(const DATA& data,const int i)
+{
+    const int n=data.size;
+    double m[9];
+    for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+        m[row*3+column]=0;for(int k=0;k<3;k++) m[row*3+column]+=data.u[(row*3+k)*n+i]*data.v[(column*3+k)*n+i];}
+    const double det=m[0]*(m[4]*m[8]-m[5]*m[7])-m[1]*(m[3]*m[8]-m[5]*m[6])+m[2]*(m[3]*m[7]-m[4]*m[6]);
+    return det<0?-1:1;
+}
+
+double Rotation_Error(const DATA& data,const DATA& reference)
+{
+    const int n=data.size;
+    double e=0;
+    for(int i=0;i<n;i++) for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+        // for det(A) < 0 the rotation is U * diag(1,1,-1) * V', S has a negative eigenvalue
+        double r=0;for(int k=0;k<3;k++) r+=(k==2?Rotation_Sign(reference,i):1)*reference.u[(row*3+k)*n+i]*reference.v[(column*3+k)*n+i];
+        e=std::max(e,std::fabs(r-data.u[(row*3+column)*n+i]));}
+    return e;
+}
+
+double Run_Lapack(DATA& data)
+{
+    const int n=data.size,three=3;int info=0,lwork=64;double work[64];
+    sys::profile_timer timer;
+    for(int i=0;i<n;i++){
+        double a[9],u[9],vt[9],s[3];
+        for(int row=0;row<3;row++) for(int column=0;column<3;column++) a[column*3+row]=data.a[(row*3+column)*n+i]; // column major
+        dgesvd_("A","A",&three,&three,a,&three,s,u,&three,vt,&three,work,&lwork,&info);
+        for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+            data.u[(row*3+column)*n+i]=u[column*3+row];
+            data.v[(row*3+column)*n+i]=vt[row*3+column];}
+        for(int k=0;k<3;k++) data.sigma[k*n+i]=s[k];}
+    return timer.seconds();
+}
+
+ERRORS Measure(const DATA& data,const DATA& reference)
+{
+    const int n=data.size;
+    ERRORS e={0,0,0,0};
+    for(int i=0;i<n;i++){
+        double sigma[3],sigma_reference[3];
+        for(int k=0;k<3;k++){sigma[k]=std::fabs(data.sigma[k*n+i]);sigma_reference[k]=reference.sigma[k*n+i];}
+        std::sort(sigma,sigma+3,std::greater<double>());
+        e.sigma_largest=std::max(e.sigma_largest,std::fabs(sigma[0]-sigma_reference[0])/sigma_reference[0]);
+        e.sigma_smallest=std::max(e.sigma_smallest,std::fabs(sigma[2]-sigma_reference[2])/sigma_reference[2]);
+
+        double a_max=0,r_max=0;
+        for(int row=0;row<3;row++) for(int column=0;column<3;column++){
+            double a=0,uu=0,vv=0;
+            for(int k=0;k<3;k++){
+                a+=data.u[(row*3+k)*n+i]*data.sigma[k*n+i]*data.v[(column*3+k)*n+i];
+                uu+=data.u[(k*3+row)*n+i]*data.u[(k*3+column)*n+i];
+                vv+=data.v[(k*3+row)*n+i]*data.v[(k*3+column)*n+i];}
+            a_max=std::max(a_max,std::fabs(reference.a[(row*3+column)*n+i]));
+            r_max=std::max(r_max,std::fabs(a-reference.a[(row*3+column)*n+i]));
+            const double identity=row==column?1.:0.;
+            e.orthogonality=std::max(e.orthogonality,std::max(std::fabs(uu-identity),std::fabs(vv-identity)));}
+        e.reconstruction=std::max(e.reconstruction,r_max/a_max);}
+    return e;
+}
+
+ERRORS Report(const char* name,const DATA& data,const DATA& reference,const double seconds,const double sweeps=0)
+{
+    const ERRORS e=Measure(data,reference);
+    printf("  %-22s %12.3e %12.3e %12.3e %12.3e %14.0f",name,e.sigma_largest,e.sigma_smallest,e.reconstruction,e.orthogonality,data.size/seconds);
+    if(sweeps>0) printf(" %8.3f",sweeps);
+    printf("\n");
+    return e;
+}
+
+// the double and mixed precision modes reconstruct A to about the double precision at every condition number
+const double double_reconstruction_tolerance=1e-12;
+
+// reports a double or mixed precision mode, returns 1 if its reconstruction error is above the tolerance
+int Report_Double(const char* name,const DATA& data,const DATA& reference,const double seconds)
+{
+    const ERRORS e=Report(name,data,reference,seconds);
+    if(e.reconstruction<=double_reconstruction_tolerance) return 0;
+    printf("  FAILED: %s reconstruction error %.3e above %.0e\n",name,e.reconstruction,double_reconstruction_tolerance);
+    return 1;
+}
+
+int main(int argc,char* argv[])
+{
+    const int size=argc>1?atoi(argv[1]):65536;
+    const double conditions[]={1e0,1e2,1e4,1e6,1e8,1e12};
+    int failures=0;
+
+    for(double condition:conditions){
+        DATA reference(size);Initialize(reference,condition,1);
+        std::vector<float> a_float(reference.a.begin(),reference.a.end());
+
+        printf("condition number %.0e, %d matrices\n",condition,size);
+        printf("  %-22s %12s %12s %12s %12s %14s\n","mode","sigma1 rel","sigma3 rel","recon","orthogonal","matrices/s");
+
+        DATA data(size);data.a=reference.a;
+        const double lapack_seconds=Run_Lapack(reference);
+        Report("lapack dgesvd",reference,reference,lapack_seconds);
+
+        double seconds=Run<svd::avx_vector,FLOAT_MODE>(data,a_float);Report("float avx",data,reference,seconds);
+        seconds=Run<svd::cpu_scalar_double,DOUBLE_MODE>(data,reference.a);failures+=Report_Double("double scalar",data,reference,seconds);
+        seconds=Run<svd::sse_vector_double,DOUBLE_MODE>(data,reference.a);failures+=Report_Double("double sse2",data,reference,seconds);
+        seconds=Run<svd::avx_vector_double,DOUBLE_MODE>(data,reference.a);failures+=Report_Double("double avx",data,reference,seconds);
+        seconds=Run<svd::cpu_scalar_double,MIXED_MODE>(data,reference.a);failures+=Report_Double("mixed scalar",data,reference,seconds);
+        seconds=Run<svd::avx_vector_double,MIXED_MODE>(data,reference.a);failures+=Report_Double("mixed sse/avx",data,reference,seconds);
+        printf("\n");}
+
+    // near identity matrices need fewer sweeps, the adaptive mode stops when all lanes have converged
+    const double perturbations[]={1e-1,1e-2,1e-3,1e-4};
+    const float tolerances[]={1e-6f,1e-5f,1e-4f};
+
+    for(double perturbation:perturbations){
+        DATA reference(size);Initialize_Near_Identity(reference,perturbation,1);
+        std::vector<float> a_float(reference.a.begin(),reference.a.end());
+
+        printf("near identity, perturbation %.0e, %d matrices\n",perturbation,size);
+        printf("  %-22s %12s %12s %12s %12s %14s %8s\n","mode","sigma1 rel","sigma3 rel","recon","orthogonal","matrices/s","sweeps");
+
+        DATA data(size);data.a=reference.a;
+        Run_Lapack(reference);
+
+        double seconds=Run<svd::avx_vector,FLOAT_MODE>(data,a_float);Report("float avx",data,reference,seconds);
+        for(float tolerance:tolerances){
+            char name[64];snprintf(name,sizeof(name),"float avx tol %.0e",tolerance);
+            ADAPTIVE_MODE::tolerance=tolerance;ADAPTIVE_MODE::sweeps=ADAPTIVE_MODE::calls=0;
+            seconds=Run<svd::avx_vector,ADAPTIVE_MODE>(data,a_float);Report(name,data,reference,seconds,ADAPTIVE_MODE::Average_Sweeps());}
+        printf("\n");}
+
+    // polar decomposition of near rotations, the rotation only and polar modes skip forming U and V
+    printf("polar decomposition of near rotations, %d matrices\n",size);
+    printf("  %-22s %12s %10s %12s %14s\n","mode","perturbation","reflected","rotation","matrices/s");
+
+    for(int reflected:{0,16}) for(double perturbation:perturbations){
+        DATA reference(size);Initialize_Near_Rotation(reference,perturbation,1,reflected);
+        std::vector<float> a_float(reference.a.begin(),reference.a.end());
+        DATA data(size);
+        Run_Lapack(reference);
+
+        const struct {const char* name;POLAR_MODE mode;float tolerance;} modes[]={
+            {"u * v' from usv",POLAR_USV,0.f},{"rotation only",POLAR_ROTATION,0.f},{"polar",POLAR_FULL,0.f},
+            {"rotation only tol 1e-5",POLAR_ROTATION,1e-5f},{"polar tol 1e-5",POLAR_FULL,1e-5f},
+            {"newton tol 1e-6",POLAR_NEWTON,1e-6f},{"newton 8 iterations",POLAR_NEWTON,0.f},{"newton / svd tol 1e-6",POLAR_NEWTON_SVD,1e-6f}};
+        for(const auto& mode:modes){
+            const double seconds=Run_Polar<svd::avx_vector>(data,a_float,mode.mode,mode.tolerance);
+            printf("  %-22s %12.0e %10s %12.3e %14.0f\n",mode.name,perturbation,reflected?"1/16":"none",Rotation_Error(data,reference),size/seconds);}}
+
+    if(failures) printf("%d double and mixed precision runs above the reconstruction tolerance\n",failures);
+    return failures;
+}
@@ -17,24 +17,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 
 
-
-#define PERFORM_CORRECTNESS_TEST
-
+// Defined by the Singular_Value_Decomposition_Correctness_Test target of the Makefile
 #ifdef PERFORM_CORRECTNESS_TEST
 #include <vector>
 #endif
 
 #include "sys_profile_timer.h"
+#include "sys_profile_zone.h"
+#include "sys_profile_counters.h"
 
 #include "Singular_Value_Decomposition_Helper.h"
 using namespace Singular_Value_Decomposition;
 
 
-struct timeval starttime,stoptime;
-
 sys::profile_timer g_timer;
 
 void start_timer()
@@ -64,9 +63,20 @@ int main(int argc,char *argv[]){
     T *v11,*v21,*v31,*v12,*v22,*v32,*v13,*v23,*v33;
     T *sigma1,*sigma2,*sigma3;
 
-    if(argc!=2){printf("Must specify number of threads\n");exit(1);}
+    if(argc<2 || argc>5){printf("Usage: %s <number of threads> [jacobi tolerance] [perturbation from identity] [scalar|sse|avx|avx512]\n",argv[0]);exit(1);}
     int number_of_threads=atoi(argv[1]);
-    printf("Using %d threads\n",number_of_threads);
+    // A zero tolerance runs the fixed number of Jacobi sweeps; a zero perturbation draws uniformly random matrices
+    T jacobi_tolerance=argc>2?(T)atof(argv[2]):(T)0;
+    T perturbation=argc>3?(T)atof(argv[3]):(T)0;
+    // The widest kernel the processor supports, unless one is named
+    const KERNEL_VARIANT* kernel=argc>4?Find_Kernel(argv[4]):&Select_Kernel();
+    if(!kernel){printf("Kernel %s is unknown or not supported by this processor\n",argv[4]);exit(1);}
+    printf("Using %d threads, %s kernel\n",number_of_threads,kernel->name);
+    if(jacobi_tolerance>0) printf("Jacobi iteration exits early at tolerance %g\n",jacobi_tolerance);
+    if(perturbation>0) printf("Near-identity input, perturbation %g\n",perturbation);
+
+    // Opened before the worker threads are created, so they inherit the counters
+    sys::profile::counter_group counters;
 //    pthread_queue=new PhysBAM::PTHREAD_QUEUE(number_of_threads);  
 
     // Allocate data
@@ -76,7 +86,7 @@ int main(int argc,char *argv[]){
         a11,a21,a31,a12,a22,a32,a13,a23,a33,
         u11,u21,u31,u12,u22,u32,u13,u23,u33,
         v11,v21,v31,v12,v22,v32,v13,v23,v33,
-        sigma1,sigma2,sigma3);
+        sigma1,sigma2,sigma3,number_of_threads);
 
     stop_timer();printf(" [Seconds: %g]\n",get_time());
 
@@ -87,22 +97,30 @@ int main(int argc,char *argv[]){
         a11,a21,a31,a12,a22,a32,a13,a23,a33,
         u11,u21,u31,u12,u22,u32,u13,u23,u33,
         v11,v21,v31,v12,v22,v32,v13,v23,v33,
-        sigma1,sigma2,sigma3);
+        sigma1,sigma2,sigma3,perturbation);
 
     Singular_Value_Decomposition_Size_Specific_Helper<T,size> test(
         a11,a21,a31,a12,a22,a32,a13,a23,a33,
         u11,u21,u31,u12,u22,u32,u13,u23,u33,
         v11,v21,v31,v12,v22,v32,v13,v23,v33,
         sigma1,sigma2,sigma3);
+    test.Set_Kernel(*kernel);
+    test.Set_Jacobi_Tolerance(jacobi_tolerance);
 
     stop_timer();printf(" [Seconds: %g]\n",get_time());
 
 #ifdef PERFORM_CORRECTNESS_TEST
     printf("Running correctness benchmark");
+    sys::profile::counter_values counters_begin=counters.read();
     start_timer();
-    test.Run_Parallel(number_of_threads); 
+    {SYS_PROFILE_ZONE("svd_run_parallel");
+    test.Run_Parallel(number_of_threads);}
     stop_timer();
     printf(" [Seconds: %g]\n",get_time());
+    printf("Average Jacobi sweeps: %g\n",test.Average_Jacobi_Sweeps());
+    sys::profile::write_counters(std::cout,"svd_run_parallel",counters.read()-counters_begin);
+    sys::profile::write_statistics(std::cout);
+    {std::ofstream trace("svd_trace.json");sys::profile::write_chrome_trace(trace);}
 
     T A[3][3],U[3][3],V[3][3],Sigma[3],A_rotated[3][3],A_reconstructed[3][3];
     
@@ -159,11 +177,17 @@ int main(int argc,char *argv[]){
     while(1){
         printf("Running performance benchmark");
 
+        sys::profile::counter_values counters_begin=counters.read();
         start_timer();
- 	test.Run_Parallel(number_of_threads); 
+        {SYS_PROFILE_ZONE("svd_run_parallel");
+ 	test.Run_Parallel(number_of_threads);}
         stop_timer();
 
         printf(" [Seconds: %g]\n",get_time());
+        printf("Average Jacobi sweeps: %g\n",test.Average_Jacobi_Sweeps());
+        sys::profile::write_counters(std::cout,"svd_run_parallel",counters.read()-counters_begin);
+        sys::profile::write_statistics(std::cout);
+        sys::profile::reset();
      }
 #endif
 
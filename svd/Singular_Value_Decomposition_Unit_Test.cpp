@@ -17,79 +17,69 @@
 #include <cmath>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <algorithm>
 
-#define PRINT_DEBUGGING_OUTPUT
-#define USE_SCALAR_IMPLEMENTATION
-//#define USE_SSE_IMPLEMENTATION
-// #define USE_AVX_IMPLEMENTATION
+#include "Singular_Value_Decomposition_Kernel.h"
+using namespace Singular_Value_Decomposition;
 
-#define COMPUTE_V_AS_MATRIX
-#define COMPUTE_V_AS_QUATERNION
-#define COMPUTE_U_AS_MATRIX
-#define COMPUTE_U_AS_QUATERNION
+// the widest variant decomposes this many copies of the test matrix at once
+const int lanes=16;
 
-#include "Singular_Value_Decomposition_Preamble.hpp"
-
-int main(int argc,char* argv[])
+struct UNIT_TEST_RESULT
 {
-    /*
-    if(argc!=2){printf("Must specify an integer random seed as argument\n");exit(1);}
-    srand(atoi(argv[1]));
-
-    float test_A11,test_A21,test_A31,test_A12,test_A22,test_A32,test_A13,test_A23,test_A33;
-
-    test_A11=2.*(float)rand()/(float)RAND_MAX-1.;
-    test_A21=2.*(float)rand()/(float)RAND_MAX-1.;
-    test_A31=2.*(float)rand()/(float)RAND_MAX-1.;
-    test_A12=2.*(float)rand()/(float)RAND_MAX-1.;
-    test_A22=2.*(float)rand()/(float)RAND_MAX-1.;
-    test_A32=2.*(float)rand()/(float)RAND_MAX-1.;
-    test_A13=2.*(float)rand()/(float)RAND_MAX-1.;
-    test_A23=2.*(float)rand()/(float)RAND_MAX-1.;
-    test_A33=2.*(float)rand()/(float)RAND_MAX-1.;
-    float norm_inverse=(float)(1./sqrt((double)test_A11*(double)test_A11+(double)test_A21*(double)test_A21+(double)test_A31*(double)test_A31
-            +(double)test_A12*(double)test_A12+(double)test_A22*(double)test_A22+(double)test_A32*(double)test_A32
-            +(double)test_A13*(double)test_A13+(double)test_A23*(double)test_A23+(double)test_A33*(double)test_A33));
-    test_A11*=norm_inverse;
-    test_A21*=norm_inverse;
-    test_A31*=norm_inverse;
-    test_A12*=norm_inverse;
-    test_A22*=norm_inverse;
-    test_A32*=norm_inverse;
-    test_A13*=norm_inverse;
-    test_A23*=norm_inverse;
-    test_A33*=norm_inverse;
-
-    */
+    float u[9][lanes],sigma[3][lanes],v[9][lanes];
+};
 
-    float test_A11,test_A21,test_A31,test_A12,test_A22,test_A32,test_A13,test_A23,test_A33;
+void Print_Matrix(const char* name,const float m[9][lanes])
+{
+    printf("%s =\n",name);
+    for(int row=0;row<3;row++) printf("%12g  %12g  %12g\n",m[row*3][0],m[row*3+1][0],m[row*3+2][0]);
+}
 
-    test_A11 = 2.0f;
-    test_A12 = -0.2f;
-    test_A13 = 1.0f;
+int main(int argc,char* argv[])
+{
+    float a[9][lanes];
+    float test_A[9]={2.0f,-0.2f,1.0f,-0.2f,1.0f,6.0f,15.0f,0.0f,8.0f};
 
-    test_A21 = -0.2f;
-    test_A22 = 1.0f;
-    test_A23 = 6.0f;
+    // a random matrix of unit Frobenius norm if a seed is given
+    if(argc==2){
+        srand(atoi(argv[1]));
+        double norm2=0;
+        for(int k=0;k<9;k++){test_A[k]=2.*(float)rand()/(float)RAND_MAX-1.;norm2+=(double)test_A[k]*(double)test_A[k];}
+        const float norm_inverse=(float)(1./sqrt(norm2));
+        for(int k=0;k<9;k++) test_A[k]*=norm_inverse;}
+    for(int k=0;k<9;k++) std::fill(a[k],a[k]+lanes,test_A[k]);
 
-    test_A31 = 15.0f;
-    test_A32 = 0.0f;
-    test_A33 = 8.0f;
-        
-#include "Singular_Value_Decomposition_Kernel_Declarations.hpp"
+    UNIT_TEST_RESULT results[number_of_kernel_variants];
+    for(int variant=0;variant<number_of_kernel_variants;variant++){
+        const KERNEL_VARIANT& kernel=kernel_variants[variant];
+        if(kernel.required>svd::cpu::supported_instruction_set()){printf("%s kernel: not supported by this processor\n",kernel.name);continue;}
+        UNIT_TEST_RESULT& result=results[variant];
+        KERNEL_DATA data;
+        for(int k=0;k<9;k++){data.a[k]=a[k];data.u[k]=result.u[k];data.v[k]=result.v[k];}
+        for(int k=0;k<3;k++) data.sigma[k]=result.sigma[k];
+        kernel.kernel(data,0,lanes,0);
 
-    ENABLE_SCALAR_IMPLEMENTATION(Sa11.f=test_A11;)                                        ENABLE_SSE_IMPLEMENTATION(Va11=_mm_set1_ps(test_A11);)                                    ENABLE_AVX_IMPLEMENTATION(Va11=_mm256_set1_ps(test_A11);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa21.f=test_A21;)                                        ENABLE_SSE_IMPLEMENTATION(Va21=_mm_set1_ps(test_A21);)                                    ENABLE_AVX_IMPLEMENTATION(Va21=_mm256_set1_ps(test_A21);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa31.f=test_A31;)                                        ENABLE_SSE_IMPLEMENTATION(Va31=_mm_set1_ps(test_A31);)                                    ENABLE_AVX_IMPLEMENTATION(Va31=_mm256_set1_ps(test_A31);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa12.f=test_A12;)                                        ENABLE_SSE_IMPLEMENTATION(Va12=_mm_set1_ps(test_A12);)                                    ENABLE_AVX_IMPLEMENTATION(Va12=_mm256_set1_ps(test_A12);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa22.f=test_A22;)                                        ENABLE_SSE_IMPLEMENTATION(Va22=_mm_set1_ps(test_A22);)                                    ENABLE_AVX_IMPLEMENTATION(Va22=_mm256_set1_ps(test_A22);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa32.f=test_A32;)                                        ENABLE_SSE_IMPLEMENTATION(Va32=_mm_set1_ps(test_A32);)                                    ENABLE_AVX_IMPLEMENTATION(Va32=_mm256_set1_ps(test_A32);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa13.f=test_A13;)                                        ENABLE_SSE_IMPLEMENTATION(Va13=_mm_set1_ps(test_A13);)                                    ENABLE_AVX_IMPLEMENTATION(Va13=_mm256_set1_ps(test_A13);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa23.f=test_A23;)                                        ENABLE_SSE_IMPLEMENTATION(Va23=_mm_set1_ps(test_A23);)                                    ENABLE_AVX_IMPLEMENTATION(Va23=_mm256_set1_ps(test_A23);)
-    ENABLE_SCALAR_IMPLEMENTATION(Sa33.f=test_A33;)                                        ENABLE_SSE_IMPLEMENTATION(Va33=_mm_set1_ps(test_A33);)                                    ENABLE_AVX_IMPLEMENTATION(Va33=_mm256_set1_ps(test_A33);)
+        if(!variant){
+            printf("Scalar kernel\n");
+            Print_Matrix("A",a);
+            Print_Matrix("U",result.u);
+            printf("Sigma =\n%12g  %12g  %12g\n",result.sigma[0][0],result.sigma[1][0],result.sigma[2][0]);
+            Print_Matrix("V",result.v);
+            continue;}
 
-#include "Singular_Value_Decomposition_Main_Kernel_Body.hpp"    
+        // every lane of the vector variants against the scalar result
+        float difference=0;
+        bool identical=true;
+        for(int lane=0;lane<lanes;lane++){
+            for(int k=0;k<9;k++){
+                difference=std::max(difference,std::max(std::fabs(result.u[k][lane]-results[0].u[k][0]),std::fabs(result.v[k][lane]-results[0].v[k][0])));
+                identical=identical && !memcmp(&result.u[k][lane],&results[0].u[k][0],sizeof(float)) && !memcmp(&result.v[k][lane],&results[0].v[k][0],sizeof(float));}
+            for(int k=0;k<3;k++){
+                difference=std::max(difference,std::fabs(result.sigma[k][lane]-results[0].sigma[k][0]));
+                identical=identical && !memcmp(&result.sigma[k][lane],&results[0].sigma[k][0],sizeof(float));}}
+        printf("%s kernel: largest difference from the scalar kernel %g%s\n",kernel.name,difference,identical?" (bitwise identical)":"");}
 
     return 0;
 }
@@ -0,0 +1,311 @@
+#ifndef __MEM_DEFERRED_REF_COUNTER_H__
+#define __MEM_DEFERRED_REF_COUNTER_H__
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//  Deferred reference counting for objects that are shared between threads.
+//
+//  mem::ref_counter updates the count in the object on every pointer copy. Threads that
+//  traverse the same objects (e.g. the half edges of a mesh) then keep writing to the same
+//  cache lines. An object derived from mem::deferred_ref_counter is not written on a copy.
+//  The copy adds +1 or -1 to a small hash table that is private to the thread, where a copy
+//  and its release cancel out. The table is merged into the counts in the objects only when
+//  it fills up, so a read only traversal writes no shared cache line.
+//
+//  The count in the object is therefore only exact when all threads have merged their
+//  deltas, and objects are not deleted when their last pointer goes away. They are deleted
+//  by mem::deferred_ref_collect(), which must be called at a quiescent point (the end of an
+//  epoch): no other thread may copy or release pointers to deferred counted objects while it
+//  runs. Typically it is called after the worker threads of a parallel phase have joined.
+
+namespace mem
+{
+    class deferred_ref_counter_base
+    {
+        public:
+        typedef void (*destroy_function)(const deferred_ref_counter_base*);
+
+        protected:
+        deferred_ref_counter_base() : m_count(0) {}
+        deferred_ref_counter_base(const deferred_ref_counter_base&) : m_count(0) {}
+        deferred_ref_counter_base& operator=(const deferred_ref_counter_base&) { return *this; }
+        ~deferred_ref_counter_base() {}
+
+        private:
+        template <class derived> friend class deferred_ref_counter;
+        friend class deferred_ref_log;
+
+        //sum of the merged deltas, can be transiently negative or zero while deltas are pending
+        mutable std::atomic<int32_t> m_count;
+    };
+
+    //per thread table of pending count deltas
+    class deferred_ref_log
+    {
+        public:
+
+        static const uint32_t capacity_bits = 10;
+        static const uint32_t capacity      = 1 << capacity_bits;
+        static const uint32_t merge_size    = ( capacity * 3 ) / 4;
+
+        struct candidate
+        {
+            const deferred_ref_counter_base*            m_object;
+            deferred_ref_counter_base::destroy_function m_destroy;
+
+            bool operator<(const candidate& o) const
+            {
+                return m_object < o.m_object;
+            }
+
+            bool operator==(const candidate& o) const
+            {
+                return m_object == o.m_object;
+            }
+        };
+
+        deferred_ref_log() : m_size(0)
+        {
+            clear();
+        }
+
+        inline void add(const deferred_ref_counter_base* object, deferred_ref_counter_base::destroy_function destroy, int32_t delta)
+        {
+            uint32_t slot = hash(object);
+
+            while ( m_entries[slot].m_object != object )
+            {
+                if ( m_entries[slot].m_object == nullptr )
+                {
+                    m_entries[slot].m_object  = object;
+                    m_entries[slot].m_destroy = destroy;
+
+                    if ( ++m_size == merge_size )
+                    {
+                        m_entries[slot].m_delta += delta;
+                        merge();
+                        return;
+                    }
+
+                    break;
+                }
+
+                slot = ( slot + 1 ) & ( capacity - 1 );
+            }
+
+            m_entries[slot].m_delta += delta;
+        }
+
+        //applies the pending deltas to the objects. objects whose count ends at zero are
+        //remembered as candidates for the next collection
+        void merge()
+        {
+            for (uint32_t i = 0; i < capacity; ++i)
+            {
+                entry& e = m_entries[i];
+
+                if ( e.m_object != nullptr )
+                {
+                    int32_t count = e.m_delta != 0 ? e.m_object->m_count.fetch_add( e.m_delta, std::memory_order_relaxed ) + e.m_delta : e.m_object->m_count.load( std::memory_order_relaxed );
+
+                    if (count == 0)
+                    {
+                        candidate c = { e.m_object, e.m_destroy };
+                        m_candidates.push_back( c );
+                    }
+                }
+            }
+
+            clear();
+        }
+
+        std::vector<candidate>& candidates()
+        {
+            return m_candidates;
+        }
+
+        //merged count, exact only when all logs are merged
+        static int32_t count(const deferred_ref_counter_base* object)
+        {
+            return object->m_count.load( std::memory_order_relaxed );
+        }
+
+        private:
+
+        struct entry
+        {
+            const deferred_ref_counter_base*            m_object;
+            deferred_ref_counter_base::destroy_function m_destroy;
+            int32_t                                     m_delta;
+        };
+
+        static inline uint32_t hash(const void* object)
+        {
+            uint64_t v = static_cast<uint64_t> ( reinterpret_cast<uintptr_t> (object) );
+            return static_cast<uint32_t> ( ( v * 0x9E3779B97F4A7C15ULL ) >> ( 64 - capacity_bits ) );
+        }
+
+        void clear()
+        {
+            memset( &m_entries[0], 0, sizeof(m_entries) );
+            m_size = 0;
+        }
+
+        entry                   m_entries[capacity];
+        uint32_t                m_size;
+        std::vector<candidate>  m_candidates;
+    };
+
+    namespace details
+    {
+        class deferred_ref_registry
+        {
+            public:
+
+            static deferred_ref_registry& instance()
+            {
+                static deferred_ref_registry r;
+                return r;
+            }
+
+            void add(deferred_ref_log* log)
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_logs.push_back(log);
+            }
+
+            //a thread that exits merges its deltas and hands its candidates to the next collection
+            void remove(deferred_ref_log* log)
+            {
+                log->merge();
+
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_logs.erase( std::remove( m_logs.begin(), m_logs.end(), log ), m_logs.end() );
+                m_orphans.insert( m_orphans.end(), log->candidates().begin(), log->candidates().end() );
+            }
+
+            std::size_t collect()
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                std::vector<deferred_ref_log::candidate> candidates;
+                std::swap( candidates, m_orphans );
+
+                std::size_t deleted = 0;
+
+                for (;;)
+                {
+                    for (auto log : m_logs)
+                    {
+                        log->merge();
+                        candidates.insert( candidates.end(), log->candidates().begin(), log->candidates().end() );
+                        log->candidates().clear();
+                    }
+
+                    if ( candidates.empty() )
+                    {
+                        return deleted;
+                    }
+
+                    std::sort( candidates.begin(), candidates.end() );
+                    candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+                    //the destructors release the pointers held by the objects into the log of this thread,
+                    //so the loop runs until no more objects die
+                    for (auto& c : candidates)
+                    {
+                        if ( deferred_ref_log::count( c.m_object ) == 0 )
+                        {
+                            c.m_destroy( c.m_object );
+                            ++deleted;
+                        }
+                    }
+
+                    candidates.clear();
+                }
+            }
+
+            private:
+            std::mutex                                  m_lock;
+            std::vector<deferred_ref_log*>              m_logs;
+            std::vector<deferred_ref_log::candidate>    m_orphans;
+        };
+
+        class deferred_ref_thread_log
+        {
+            public:
+
+            deferred_ref_thread_log() : m_log( new deferred_ref_log() )
+            {
+                deferred_ref_registry::instance().add( m_log.get() );
+            }
+
+            ~deferred_ref_thread_log()
+            {
+                deferred_ref_registry::instance().remove( m_log.get() );
+            }
+
+            deferred_ref_log* get() const
+            {
+                return m_log.get();
+            }
+
+            private:
+            std::unique_ptr<deferred_ref_log> m_log;
+        };
+
+        inline deferred_ref_log* this_thread_deferred_ref_log()
+        {
+            static thread_local deferred_ref_thread_log log;
+            return log.get();
+        }
+    }
+
+    //deletes the deferred counted objects that are no longer referenced, returns their number.
+    //must be called when no other thread uses deferred counted pointers
+    inline std::size_t deferred_ref_collect()
+    {
+        details::this_thread_deferred_ref_log();    //the destructors may release pointers from this thread
+        return details::deferred_ref_registry::instance().collect();
+    }
+
+    template <class derived>
+    class deferred_ref_counter : public deferred_ref_counter_base
+    {
+        private:
+        typedef deferred_ref_counter<derived> this_type;
+
+        static void destroy(const deferred_ref_counter_base* pointer)
+        {
+            typedef char type_must_be_complete[ sizeof(derived)? 1: -1 ];
+            (void) sizeof(type_must_be_complete);
+
+            delete static_cast< const derived* > ( static_cast< const this_type* > ( pointer ) );
+        }
+
+    public:
+
+        friend void intrusive_ptr_add_ref(const derived* pointer)
+        {
+            details::this_thread_deferred_ref_log()->add( static_cast< const this_type* > ( pointer ), &this_type::destroy, 1 );
+        }
+
+        friend void intrusive_ptr_release(const derived* pointer)
+        {
+            details::this_thread_deferred_ref_log()->add( static_cast< const this_type* > ( pointer ), &this_type::destroy, -1 );
+        }
+
+    protected:
+        deferred_ref_counter() {}
+        deferred_ref_counter(const deferred_ref_counter& o) : deferred_ref_counter_base(o) {}
+        deferred_ref_counter& operator=(const deferred_ref_counter&) { return *this; }
+        ~deferred_ref_counter() {}
+    };
+}
+
+#endif
@@ -0,0 +1,307 @@
+#ifndef __SYS_PROFILE_ZONE_H__
+#define __SYS_PROFILE_ZONE_H__
+
+#include <algorithm>
+#include <cstdio>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "sys_profile_timer.h"
+
+//  Scoped profiling zones.
+//
+//  void build_mesh()
+//  {
+//      SYS_PROFILE_ZONE("build_mesh");
+//      ...
+//  }
+//
+//  Every thread records into its own ring buffer, so recording is two reads of the
+//  tick counter and three stores, without locks or shared cache lines. When the buffer
+//  wraps, the oldest zones are overwritten. The recorded zones can be written as a Chrome
+//  trace (chrome://tracing, about:tracing) or summarized as per zone statistics.
+//
+//  Zone names must be string literals (or otherwise outlive the profiler).
+//  Define SYS_PROFILE_DISABLE to compile the zones out.
+
+namespace sys
+{
+    namespace profile
+    {
+        struct zone_event
+        {
+            const char* m_name;
+            uint64_t    m_begin;
+            uint64_t    m_end;
+        };
+
+        struct zone_statistics
+        {
+            std::string m_name;
+            uint64_t    m_count;
+            double      m_min;      //milliseconds
+            double      m_p50;
+            double      m_p99;
+            double      m_max;
+            double      m_total;
+        };
+
+        namespace details
+        {
+            //single writer (the owning thread), many readers ring buffer of zone events
+            class thread_ring_buffer
+            {
+                public:
+                static const uint32_t capacity = 1 << 16;
+
+                explicit thread_ring_buffer( uint32_t thread_id ) throw() : m_thread_id(thread_id), m_write(0), m_events( new zone_event[capacity] )
+                {
+
+                }
+
+                inline void record(const char* name, uint64_t begin, uint64_t end) throw()
+                {
+                    const uint64_t write = m_write.load( std::memory_order_relaxed );
+                    zone_event& e = m_events[ write & ( capacity - 1 ) ];
+                    e.m_name  = name;
+                    e.m_begin = begin;
+                    e.m_end   = end;
+                    m_write.store( write + 1, std::memory_order_release );
+                }
+
+                //copies the zones that are still in the buffer. zones recorded concurrently with
+                //the copy may be torn if the buffer wraps meanwhile, so snapshot when quiet
+                void snapshot( std::vector<zone_event>& events ) const
+                {
+                    const uint64_t write = m_write.load( std::memory_order_acquire );
+                    const uint64_t begin = write > capacity ? write - capacity : 0;
+
+                    for (uint64_t i = begin; i < write; ++i)
+                    {
+                        events.push_back( m_events[ i & ( capacity - 1 ) ] );
+                    }
+                }
+
+                void clear() throw()
+                {
+                    m_write.store( 0, std::memory_order_release );
+                }
+
+                uint32_t thread_id() const throw()
+                {
+                    return m_thread_id;
+                }
+
+                private:
+                const uint32_t                  m_thread_id;
+                std::atomic<uint64_t>           m_write;
+                std::unique_ptr<zone_event[]>   m_events;
+            };
+
+            class registry
+            {
+                public:
+
+                static registry& instance()
+                {
+                    static registry r;
+                    return r;
+                }
+
+                //buffers are never freed, threads that exit keep their zones for the export
+                thread_ring_buffer* create_buffer()
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    m_buffers.push_back( std::unique_ptr<thread_ring_buffer>( new thread_ring_buffer( static_cast<uint32_t> ( m_buffers.size() ) ) ) );
+                    return m_buffers.back().get();
+                }
+
+                template <typename functor> void for_each_buffer(functor f)
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    for (auto& b : m_buffers)
+                    {
+                        f(*b);
+                    }
+                }
+
+                private:
+                std::mutex                                          m_lock;
+                std::vector< std::unique_ptr<thread_ring_buffer> >  m_buffers;
+            };
+
+            inline thread_ring_buffer* this_thread_buffer()
+            {
+                static thread_local thread_ring_buffer* buffer = registry::instance().create_buffer();
+                return buffer;
+            }
+
+            inline void write_json_string( std::ostream& s, const char* v )
+            {
+                s << '"';
+                for (; *v; ++v)
+                {
+                    if ( *v == '"' || *v == '\\' )
+                    {
+                        s << '\\';
+                    }
+                    s << *v;
+                }
+                s << '"';
+            }
+        }
+
+        class scoped_zone
+        {
+            public:
+            explicit scoped_zone(const char* name) throw() : m_name(name), m_buffer( details::this_thread_buffer() ), m_begin( profile_ticks() )
+            {
+
+            }
+
+            ~scoped_zone()
+            {
+                m_buffer->record( m_name, m_begin, profile_ticks() );
+            }
+
+            private:
+            scoped_zone(const scoped_zone&);
+            scoped_zone& operator=(const scoped_zone&);
+
+            const char*                     m_name;
+            details::thread_ring_buffer*    m_buffer;
+            uint64_t                        m_begin;
+        };
+
+        //drops all recorded zones
+        inline void reset()
+        {
+            details::registry::instance().for_each_buffer( [] ( details::thread_ring_buffer& b )
+            {
+                b.clear();
+            });
+        }
+
+        //writes the recorded zones in the chrome trace event format
+        inline void write_chrome_trace(std::ostream& s)
+        {
+            const double to_microseconds = 1.0e6 / profile_ticks_per_second();
+
+            std::vector< std::pair< uint32_t, std::vector<zone_event> > > threads;
+            uint64_t origin = UINT64_MAX;
+
+            details::registry::instance().for_each_buffer( [&] ( const details::thread_ring_buffer& b )
+            {
+                threads.push_back( std::make_pair( b.thread_id(), std::vector<zone_event>() ) );
+                b.snapshot( threads.back().second );
+
+                for (auto& e : threads.back().second)
+                {
+                    origin = std::min( origin, e.m_begin );
+                }
+            });
+
+            const std::ios_base::fmtflags flags = s.flags();
+            const std::streamsize precision = s.precision();
+            s << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+            bool first = true;
+            for (auto& t : threads)
+            {
+                for (auto& e : t.second)
+                {
+                    s << ( first ? "\n" : ",\n" ) << "{\"name\":";
+                    details::write_json_string( s, e.m_name );
+                    s << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << t.first
+                      << ",\"ts\":" << ( e.m_begin - origin ) * to_microseconds
+                      << ",\"dur\":" << ( e.m_end - e.m_begin ) * to_microseconds << "}";
+                    first = false;
+                }
+            }
+
+            s << "\n],\"displayTimeUnit\":\"ms\"}\n";
+            s.flags( flags );
+            s.precision( precision );
+        }
+
+        //per zone count, min, median, 99th percentile, max and total duration in milliseconds
+        inline std::vector<zone_statistics> collect_statistics()
+        {
+            const double to_milliseconds = 1.0e3 / profile_ticks_per_second();
+
+            std::map< std::string, std::vector<uint64_t> > durations;
+            std::vector<zone_event> events;
+
+            details::registry::instance().for_each_buffer( [&] ( const details::thread_ring_buffer& b )
+            {
+                events.clear();
+                b.snapshot( events );
+
+                for (auto& e : events)
+                {
+                    durations[ e.m_name ].push_back( e.m_end - e.m_begin );
+                }
+            });
+
+            std::vector<zone_statistics> r;
+            r.reserve( durations.size() );
+
+            for (auto& d : durations)
+            {
+                auto& v = d.second;
+                std::sort( v.begin(), v.end() );
+
+                zone_statistics z;
+                z.m_name  = d.first;
+                z.m_count = v.size();
+                z.m_min   = v.front() * to_milliseconds;
+                z.m_p50   = v[ ( v.size() - 1 ) / 2 ] * to_milliseconds;
+                z.m_p99   = v[ ( ( v.size() - 1 ) * 99 ) / 100 ] * to_milliseconds;
+                z.m_max   = v.back() * to_milliseconds;
+
+                uint64_t total = 0;
+                for (auto t : v)
+                {
+                    total += t;
+                }
+                z.m_total = total * to_milliseconds;
+
+                r.push_back( z );
+            }
+
+            return r;
+        }
+
+        inline void write_statistics(std::ostream& s)
+        {
+            auto statistics = collect_statistics();
+
+            s << "zone                                     count        min(ms)        p50(ms)        p99(ms)        max(ms)      total(ms)\n";
+
+            for (auto& z : statistics)
+            {
+                char line[256];
+                snprintf( line, sizeof(line), "%-32.32s %14llu %14.6f %14.6f %14.6f %14.6f %14.3f\n", z.m_name.c_str(), static_cast<unsigned long long>(z.m_count), z.m_min, z.m_p50, z.m_p99, z.m_max, z.m_total );
+                s << line;
+            }
+        }
+    }
+}
+
+#define SYS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SYS_PROFILE_CONCAT(a, b)      SYS_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(SYS_PROFILE_DISABLE)
+    #define SYS_PROFILE_ZONE(name)
+#else
+    #define SYS_PROFILE_ZONE(name) ::sys::profile::scoped_zone SYS_PROFILE_CONCAT(sys_profile_zone_, __LINE__) ( name )
+#endif
+
+#endif
@@ -2,10 +2,79 @@
 #define __SYS_PROFILE_TIMER_H__
 
 #include <cstdint>
-#include <windows.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <intrin.h>
+#else
+    #include <time.h>
+    #if defined(__i386__) || defined(__x86_64__)
+        #include <x86intrin.h>
+    #endif
+#endif
 
 namespace sys
 {
+    namespace details
+    {
+        /// monotonic wall clock in nanoseconds (QueryPerformanceCounter / clock_gettime)
+        inline uint64_t wall_clock_nanoseconds() throw()
+        {
+            #if defined(_WIN32)
+                static const double to_nanoseconds = []
+                {
+                    LARGE_INTEGER f;
+                    QueryPerformanceFrequency( &f );
+                    return 1.0e9 / static_cast<double>( f.QuadPart );
+                }();
+
+                LARGE_INTEGER c;
+                QueryPerformanceCounter( &c );
+                return static_cast<uint64_t> ( static_cast<double>( c.QuadPart ) * to_nanoseconds );
+            #else
+                timespec t;
+                clock_gettime( CLOCK_MONOTONIC, &t );
+                return static_cast<uint64_t>( t.tv_sec ) * 1000000000ULL + static_cast<uint64_t>( t.tv_nsec );
+            #endif
+        }
+    }
+
+    /// cheapest monotonic tick source of the platform: the time stamp counter on x86,
+    /// the wall clock elsewhere. ticks are converted to seconds with profile_ticks_per_second()
+    inline uint64_t profile_ticks() throw()
+    {
+        #if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+            return __rdtsc();
+        #else
+            return details::wall_clock_nanoseconds();
+        #endif
+    }
+
+    /// frequency of profile_ticks(), calibrated once against the wall clock
+    inline double profile_ticks_per_second() throw()
+    {
+        static const double frequency = []
+        {
+            #if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+                const uint64_t wall_begin = details::wall_clock_nanoseconds();
+                const uint64_t tick_begin = profile_ticks();
+
+                uint64_t wall_end = wall_begin;
+                while ( wall_end - wall_begin < 10000000 )  // 10ms
+                {
+                    wall_end = details::wall_clock_nanoseconds();
+                }
+
+                const uint64_t tick_end = profile_ticks();
+                return static_cast<double> ( tick_end - tick_begin ) * 1.0e9 / static_cast<double>( wall_end - wall_begin );
+            #else
+                return 1.0e9;
+            #endif
+        }();
+
+        return frequency;
+    }
+
     /// Create a Timer, which will immediately begin counting
     /// up from 0.0 seconds.
     /// You can call reset() to make it start over.
@@ -20,22 +89,16 @@ namespace sys
         /// reset() makes the timer start over counting from 0.0 seconds.
         void reset()
         {
-            uint64_t pf = 1;
-            QueryPerformanceFrequency( (LARGE_INTEGER *)&pf );
-            m_freq = 1.0 / (double)pf;
-            m_base_time = 0;
-            QueryPerformanceCounter( (LARGE_INTEGER *)&m_base_time );
+            m_base_time = details::wall_clock_nanoseconds();
         }
-        
+
         /// seconds() returns the number of seconds (to very high resolution)
         /// elapsed since the timer was last created or reset().
         double seconds() const
         {
-            uint64_t val = m_base_time;
-            QueryPerformanceCounter( (LARGE_INTEGER *)&val );
-            return (val - m_base_time) * m_freq;
+            return ( details::wall_clock_nanoseconds() - m_base_time ) * 1.0e-9;
         }
-        
+
         /// seconds() returns the number of milliseconds (to very high resolution)
         /// elapsed since the timer was last created or reset().
         double milliseconds() const
@@ -44,7 +107,6 @@ namespace sys
         }
 
         private:
-        double      m_freq;
         uint64_t    m_base_time;
     };
 
@@ -22,6 +22,7 @@ See the License for the specific language governing permissions and limitations
 #include "ImfArray.h"
 #include "targa.h"
 #include "avpcl.h"
+#include "sys_profile_counters.h"
 
 using namespace std;
 
@@ -249,7 +250,8 @@ static void usage()
 	"-p     use a metric based on AR AG AB A (note: if the image has alpha constant 255 this option is overridden)" << endl <<
 	"-n     use a non-uniformly-weighed metric (weights .299 .587 .114)" << endl <<
 	"-na	use a non-uniformly-weighed metric (ATI weights .3086 .6094 .0820)" << endl <<
-	"-e     dump squared errors for each tile to outroot-errors.bin" << endl;
+	"-e     dump squared errors for each tile to outroot-errors.bin" << endl <<
+	"-c     report the hardware performance counters of the compressor (linux only)" << endl;
 }
 
 bool AVPCL::flag_premult = false;
@@ -261,6 +263,7 @@ bool AVPCL::mode_rgb = false;
 int main(int argc, char* argv[])
 {
 	bool noerrfile = true;
+	bool counters = false;
 #ifdef EXTERNAL_RELEASE
 	cout << "avpcl/BC7L Targa RGBA Compressor/Decompressor version 1.41 (May 27, 2010)." << endl <<
 			"Bug reports, questions, and suggestions to wdonovan a t nvidia d o t com." << endl;
@@ -279,6 +282,7 @@ int main(int argc, char* argv[])
 							  else { AVPCL::flag_nonuniform = true; AVPCL::flag_nonuniform_ati = false; }
 							  break;
 					case 'e': noerrfile = false; break;
+					case 'c': counters = true; break;
 					default:  throw "bad flag arg";
 				}
 			else
@@ -310,7 +314,16 @@ int main(int argc, char* argv[])
 				}
 				else
 					errf = "";
-				AVPCL::compress(inf, avpclf, errf);
+				if (counters)
+				{
+					sys::profile::counter_group group;
+					if (!group.available())
+						cout << "Hardware counters unavailable (" << strerror(group.error()) << ")" << endl;
+					SYS_PROFILE_COUNTERS(group, "compress");
+					AVPCL::compress(inf, avpclf, errf);
+				}
+				else
+					AVPCL::compress(inf, avpclf, errf);
 				cout << "Decompressing " << avpclf << " to " << outf << endl;
 				AVPCL::decompress(avpclf, outf);
 				analyze(inf, outf);
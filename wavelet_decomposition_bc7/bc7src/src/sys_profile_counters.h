@@ -0,0 +1,285 @@
+#ifndef __SYS_PROFILE_COUNTERS_H__
+#define __SYS_PROFILE_COUNTERS_H__
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "sys_profile_timer.h"
+
+#if defined(__linux__)
+    #include <errno.h>
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+//  Hardware performance counters for a named region.
+//
+//  sys::profile::counter_group counters;    //create before the worker threads, they inherit the counters
+//  ...
+//  {
+//      SYS_PROFILE_COUNTERS(counters, "svd");
+//      kernel();
+//  }
+//
+//  prints cycles, instructions, instructions per cycle and the L1D, LLC, branch and dTLB misses
+//  per thousand instructions of the region, which is usually enough to tell if a kernel is
+//  compute or memory bound. The counters come from perf_event_open, so they are only available
+//  on linux (and there only when perf_event_paranoid allows user space counting). Elsewhere the
+//  region reports that the counters are unavailable.
+//  Define SYS_PROFILE_DISABLE to compile the regions out.
+
+namespace sys
+{
+    namespace profile
+    {
+        enum counter
+        {
+            counter_cycles,
+            counter_instructions,
+            counter_l1d_misses,
+            counter_llc_misses,
+            counter_branch_misses,
+            counter_dtlb_misses,
+            counter_count
+        };
+
+        inline const char* counter_name( counter c ) throw()
+        {
+            static const char* names[ counter_count ] =
+            {
+                "cycles",
+                "instructions",
+                "l1d misses",
+                "llc misses",
+                "branch misses",
+                "dtlb misses"
+            };
+
+            return names[c];
+        }
+
+        struct counter_values
+        {
+            double  m_values[ counter_count ];      //scaled for multiplexing
+            bool    m_valid [ counter_count ];
+            double  m_seconds;
+
+            counter_values() throw() : m_seconds(0.0)
+            {
+                for (uint32_t i = 0; i < counter_count; ++i)
+                {
+                    m_values[i] = 0.0;
+                    m_valid[i]  = false;
+                }
+            }
+        };
+
+        //counts the calling thread and every thread it creates after the construction
+        class counter_group
+        {
+            public:
+
+            counter_group() throw() : m_error(0)
+            {
+                for (uint32_t i = 0; i < counter_count; ++i)
+                {
+                    m_fd[i] = -1;
+                }
+
+                #if defined(__linux__)
+                    for (uint32_t i = 0; i < counter_count; ++i)
+                    {
+                        m_fd[i] = open_counter( static_cast<counter> (i) );
+                        if ( m_fd[i] == -1 && m_error == 0 )
+                        {
+                            m_error = errno;
+                        }
+                    }
+                #endif
+            }
+
+            ~counter_group()
+            {
+                #if defined(__linux__)
+                    for (uint32_t i = 0; i < counter_count; ++i)
+                    {
+                        if ( m_fd[i] != -1 )
+                        {
+                            close( m_fd[i] );
+                        }
+                    }
+                #endif
+            }
+
+            bool available() const throw()
+            {
+                return m_fd[ counter_cycles ] != -1;
+            }
+
+            //errno of the first counter that failed to open, 0 if all were opened
+            int error() const throw()
+            {
+                return m_error;
+            }
+
+            //totals since the construction
+            counter_values read() const throw()
+            {
+                counter_values r;
+
+                #if defined(__linux__)
+                    for (uint32_t i = 0; i < counter_count; ++i)
+                    {
+                        uint64_t v[3];  //value, time enabled, time running
+
+                        if ( m_fd[i] != -1 && ::read( m_fd[i], v, sizeof(v) ) == sizeof(v) )
+                        {
+                            r.m_values[i] = v[2] != 0 ? static_cast<double> ( v[0] ) * static_cast<double> ( v[1] ) / static_cast<double> ( v[2] ) : 0.0;
+                            r.m_valid[i]  = true;
+                        }
+                    }
+                #endif
+
+                r.m_seconds = ::sys::details::wall_clock_nanoseconds() * 1.0e-9;
+                return r;
+            }
+
+            private:
+
+            counter_group( const counter_group& );
+            counter_group& operator=( const counter_group& );
+
+            #if defined(__linux__)
+            static int open_counter( counter c ) throw()
+            {
+                perf_event_attr a;
+                memset( &a, 0, sizeof(a) );
+
+                a.size           = sizeof(a);
+                a.disabled       = 0;
+                a.inherit        = 1;
+                a.exclude_kernel = 1;
+                a.exclude_hv     = 1;
+                a.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                switch (c)
+                {
+                    case counter_cycles:        a.type = PERF_TYPE_HARDWARE; a.config = PERF_COUNT_HW_CPU_CYCLES;       break;
+                    case counter_instructions:  a.type = PERF_TYPE_HARDWARE; a.config = PERF_COUNT_HW_INSTRUCTIONS;     break;
+                    case counter_llc_misses:    a.type = PERF_TYPE_HARDWARE; a.config = PERF_COUNT_HW_CACHE_MISSES;     break;
+                    case counter_branch_misses: a.type = PERF_TYPE_HARDWARE; a.config = PERF_COUNT_HW_BRANCH_MISSES;    break;
+                    case counter_l1d_misses:
+                        a.type   = PERF_TYPE_HW_CACHE;
+                        a.config = PERF_COUNT_HW_CACHE_L1D | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+                        break;
+                    case counter_dtlb_misses:
+                        a.type   = PERF_TYPE_HW_CACHE;
+                        a.config = PERF_COUNT_HW_CACHE_DTLB | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+                        break;
+                    default:
+                        return -1;
+                }
+
+                return static_cast<int> ( syscall( __NR_perf_event_open, &a, 0, -1, -1, 0 ) );
+            }
+            #endif
+
+            int m_fd[ counter_count ];
+            int m_error;
+        };
+
+        inline counter_values operator-( const counter_values& a, const counter_values& b ) throw()
+        {
+            counter_values r;
+
+            for (uint32_t i = 0; i < counter_count; ++i)
+            {
+                r.m_values[i] = a.m_values[i] - b.m_values[i];
+                r.m_valid[i]  = a.m_valid[i] && b.m_valid[i];
+            }
+
+            r.m_seconds = a.m_seconds - b.m_seconds;
+            return r;
+        }
+
+        inline void write_counters( std::ostream& s, const char* name, const counter_values& v )
+        {
+            char line[256];
+
+            if ( !v.m_valid[ counter_cycles ] )
+            {
+                snprintf( line, sizeof(line), "%s: %.6f seconds, hardware counters unavailable\n", name, v.m_seconds );
+                s << line;
+                return;
+            }
+
+            snprintf( line, sizeof(line), "%s: %.6f seconds\n", name, v.m_seconds );
+            s << line;
+
+            const double instructions = v.m_valid[ counter_instructions ] ? v.m_values[ counter_instructions ] : 0.0;
+
+            for (uint32_t i = 0; i < counter_count; ++i)
+            {
+                if ( !v.m_valid[i] )
+                {
+                    snprintf( line, sizeof(line), "    %-16s %20s\n", counter_name( static_cast<counter> (i) ), "n/a" );
+                }
+                else if ( i > counter_instructions && instructions > 0.0 )
+                {
+                    snprintf( line, sizeof(line), "    %-16s %20.0f  %10.3f per 1k instructions\n", counter_name( static_cast<counter> (i) ), v.m_values[i], v.m_values[i] * 1000.0 / instructions );
+                }
+                else
+                {
+                    snprintf( line, sizeof(line), "    %-16s %20.0f\n", counter_name( static_cast<counter> (i) ), v.m_values[i] );
+                }
+
+                s << line;
+            }
+
+            if ( instructions > 0.0 && v.m_values[ counter_cycles ] > 0.0 )
+            {
+                snprintf( line, sizeof(line), "    %-16s %20.3f\n", "ipc", instructions / v.m_values[ counter_cycles ] );
+                s << line;
+            }
+        }
+
+        //writes the counters of the enclosing scope on destruction
+        class scoped_counters
+        {
+            public:
+
+            scoped_counters( const counter_group& group, const char* name, std::ostream& s ) : m_group(group), m_name(name), m_stream(s), m_begin( group.read() )
+            {
+
+            }
+
+            ~scoped_counters()
+            {
+                write_counters( m_stream, m_name, m_group.read() - m_begin );
+            }
+
+            private:
+            scoped_counters( const scoped_counters& );
+            scoped_counters& operator=( const scoped_counters& );
+
+            const counter_group&    m_group;
+            const char*             m_name;
+            std::ostream&           m_stream;
+            counter_values          m_begin;
+        };
+    }
+}
+
+#if defined(SYS_PROFILE_DISABLE)
+    #define SYS_PROFILE_COUNTERS(group, name)
+#else
+    #define SYS_PROFILE_COUNTERS(group, name) ::sys::profile::scoped_counters SYS_PROFILE_COUNTERS_CONCAT(sys_profile_counters_, __LINE__) ( group, name, std::cout )
+#endif
+
+#define SYS_PROFILE_COUNTERS_CONCAT_IMPL(a, b) a##b
+#define SYS_PROFILE_COUNTERS_CONCAT(a, b)      SYS_PROFILE_COUNTERS_CONCAT_IMPL(a, b)
+
+#endif
@@ -2,12 +2,34 @@
 #define __bezier_fit_curve_h__
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <numeric>
+#include <tuple>
 #include <vector>
 
 #include <glm/glm.hpp>
 
+//fit_curve_batch.h gives the cubics of fit_curve only if neither contracts a * b + c into one fma, which gcc does by
+//default when fma is enabled. both headers turn the contraction off for their own functions
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define BEZIER_FP_CONTRACT_OFF_BEGIN    __pragma( float_control( precise, on, push ) ) __pragma( fp_contract( off ) )
+    #define BEZIER_FP_CONTRACT_OFF_END      __pragma( float_control( pop ) )
+#elif defined(__clang__)
+    #define BEZIER_FP_CONTRACT_OFF_BEGIN    _Pragma( "float_control( push )" ) _Pragma( "clang fp contract( off )" )
+    #define BEZIER_FP_CONTRACT_OFF_END      _Pragma( "float_control( pop )" )
+#elif defined(__GNUC__)
+    #define BEZIER_FP_CONTRACT_OFF_BEGIN    _Pragma( "GCC push_options" ) _Pragma( "GCC optimize( \"fp-contract=off\" )" )
+    #define BEZIER_FP_CONTRACT_OFF_END      _Pragma( "GCC pop_options" )
+#else
+    #define BEZIER_FP_CONTRACT_OFF_BEGIN
+    #define BEZIER_FP_CONTRACT_OFF_END
+#endif
+
+BEZIER_FP_CONTRACT_OFF_BEGIN
+
 namespace bezier
 {
     typedef glm::vec3   point3;
@@ -55,20 +77,28 @@ namespace bezier
         return glm::dot(a,b);
     }
 
+    namespace details
+    {
+        template <typename point> struct components;
+
+        template <> struct components<point2> { static const size_t value = 2; };
+        template <> struct components<point3> { static const size_t value = 3; };
+    }
+
     template <typename point> point zero();
     template <typename point> point one();
 
-    template <> point3 zero<point3>()
+    template <> inline point3 zero<point3>()
     {
         return point3(0.0f, 0.0f, 0.0f);
     }
 
-    template <> point2 zero<point2>()
+    template <> inline point2 zero<point2>()
     {
         return point2(0.0f, 0.0f);
     }
 
-    template <> float zero<float>()
+    template <> inline float zero<float>()
     {
         return 0.0f;
     }
@@ -125,8 +155,8 @@ namespace bezier
         typedef typename std::iterator_traits< const_point_iterator >::value_type point;
 
         point q_u, q1_u, q2_u;                    // u evaluated for q, q', q''
-        std::tr1::array< point, 3 > q1;           // q'   control points
-        std::tr1::array< point, 2 > q2;           // q''  control points
+        std::array< point, 3 > q1;           // q'   control points
+        std::array< point, 2 > q2;           // q''  control points
 
         //generate q'
         for ( int32_t i = 0 ; i <= 2; ++i )
@@ -141,8 +171,8 @@ namespace bezier
         }
 
         q_u  = evaluate<const_point_iterator, 3>  ( control_points,  u );
-        q1_u = evaluate<std::tr1::array< point, 3 >::const_iterator, 2>  ( std::begin(q1), u );
-        q2_u = evaluate<std::tr1::array< point, 2 >::const_iterator, 1>  ( std::begin(q2), u );
+        q1_u = evaluate<typename std::array< point, 3 >::const_iterator, 2>  ( std::begin(q1), u );
+        q2_u = evaluate<typename std::array< point, 2 >::const_iterator, 1>  ( std::begin(q2), u );
 
         //compute f(u) / f'(u) ( q(u) - p ) dot q'(u)
         float numerator = dot ( q_u - p, q1_u );
@@ -249,7 +279,7 @@ namespace bezier
     //find maximum of squared distance of points to a curve
     template <typename const_iterator_points, typename const_iterator_bezier, typename const_iterator_curve > 
     auto compute_max_error( const_iterator_points begin, const_iterator_points end, const_iterator_bezier bezier, const_iterator_curve curve_params )
-         -> std::tuple< float, typename const_iterator_points > 
+         -> std::tuple< float, const_iterator_points > 
     {
         typedef typename std::iterator_traits< const_iterator_points >::value_type point;
 
@@ -413,7 +443,7 @@ namespace bezier
         auto alpha_l = (det_c0_c1 == 0.0f) ? 0.0f : det_x_c1 / det_c0_c1;
         auto alpha_r = (det_c0_c1 == 0.0f) ? 0.0f : det_c0_x / det_c0_c1;
 
-        std::tr1::array< point, 4 > bezier;
+        std::array< point, 4 > bezier;
 
         // If alpha negative, use the Wu/Barsky heuristic (see text) (if alpha is 0, you get coincident control points that lead to
         // divide by zero in any subsequent NewtonRaphsonRootFind() call. 
@@ -465,7 +495,7 @@ namespace bezier
             auto v3 = *(end_points - 1 );
 
             auto d = distance ( v0, v3 ) / 3.0f;
-            std::tr1::array< point, 4 > bezier;
+            std::array< point, 4 > bezier;
 
             bezier[0] = v0;            
             bezier[1] = v0 + (d * hat1);
@@ -480,10 +510,10 @@ namespace bezier
             u.resize( point_count );
             chord_length_parametrize( begin_points, end_points, std::begin(u) );
 
-            std::tr1::array< point, 4 > bezier;
+            std::array< point, 4 > bezier;
             bezier::generate_bezier( begin_points, end_points, std::begin(u), std::end(u), hat1, hat2, std::begin(bezier) );
 
-            auto max_error = bezier::compute_max_error< const_iterator_points, std::tr1::array< point, 4 >::iterator> ( begin_points, end_points, std::begin(bezier), std::begin(u) );
+            auto max_error = bezier::compute_max_error< const_iterator_points, typename std::array< point, 4 >::iterator> ( begin_points, end_points, std::begin(bezier), std::begin(u) );
 
             // Find max deviation of points to fitted curve
             if ( std::get<0>(max_error) < error )
@@ -565,6 +595,6 @@ namespace bezier
     }
 }
 
-
+BEZIER_FP_CONTRACT_OFF_END
 
 #endif
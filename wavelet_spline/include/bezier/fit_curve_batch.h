@@ -0,0 +1,647 @@
+#ifndef __bezier_fit_curve_batch_h__
+#define __bezier_fit_curve_batch_h__
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#include "fit_curve.h"
+
+//fit_curve for batches of polylines: the polylines are spread over threads, and the loops over the points of a
+//segment (chord lengths, basis polynomials and the terms of generate_bezier, max error, newton_raphson) run 8 points
+//at a time with avx over a structure of arrays copy of the polyline. every point sees the operations of the scalar
+//functions in the same order and the sums still run in point order, so the cubics equal the ones of fit_curve. both
+//headers keep the compiler from contracting a * b + c into fma, see BEZIER_FP_CONTRACT_OFF_BEGIN
+BEZIER_FP_CONTRACT_OFF_BEGIN
+
+namespace bezier
+{
+    //the cubics of a batch, 4 control points each. the ones of polyline i are [ m_offsets[i], m_offsets[i + 1] )
+    template <typename point> struct curve_batch
+    {
+        std::vector<point>      m_control_points;
+        std::vector<uint32_t>   m_offsets;
+    };
+
+    namespace details
+    {
+        //points per thread below which more threads do not pay off
+        static const size_t fit_grain = 16384;
+
+        //the float lanes of the kernels, one float or 8 with avx, with the same operators
+        template <typename t> struct lanes;
+
+        template <> struct lanes<float>
+        {
+            static const size_t size = 1;
+
+            static float load( const float* p )             { return *p; }
+            static void  store( float* p, float v )         { *p = v; }
+            static float splat( float v )                   { return v; }
+            static float sqrt( float v )                    { return std::sqrt( v ); }
+
+            //a if c == 0 else b
+            static float select_zero( float c, float a, float b )
+            {
+                return c == 0.0f ? a : b;
+            }
+        };
+
+        #if defined(__AVX__)
+        struct avx_lanes
+        {
+            __m256 m_v;
+        };
+
+        inline avx_lanes operator+( avx_lanes a, avx_lanes b ) { avx_lanes r = { _mm256_add_ps( a.m_v, b.m_v ) }; return r; }
+        inline avx_lanes operator-( avx_lanes a, avx_lanes b ) { avx_lanes r = { _mm256_sub_ps( a.m_v, b.m_v ) }; return r; }
+        inline avx_lanes operator*( avx_lanes a, avx_lanes b ) { avx_lanes r = { _mm256_mul_ps( a.m_v, b.m_v ) }; return r; }
+        inline avx_lanes operator/( avx_lanes a, avx_lanes b ) { avx_lanes r = { _mm256_div_ps( a.m_v, b.m_v ) }; return r; }
+
+        template <> struct lanes<avx_lanes>
+        {
+            static const size_t size = 8;
+
+            static avx_lanes load( const float* p )         { avx_lanes r = { _mm256_loadu_ps( p ) }; return r; }
+            static void      store( float* p, avx_lanes v ) { _mm256_storeu_ps( p, v.m_v ); }
+            static avx_lanes splat( float v )               { avx_lanes r = { _mm256_set1_ps( v ) }; return r; }
+            static avx_lanes sqrt( avx_lanes v )            { avx_lanes r = { _mm256_sqrt_ps( v.m_v ) }; return r; }
+
+            static avx_lanes select_zero( avx_lanes c, avx_lanes a, avx_lanes b )
+            {
+                avx_lanes r = { _mm256_blendv_ps( b.m_v, a.m_v, _mm256_cmp_ps( c.m_v, _mm256_setzero_ps(), _CMP_EQ_OQ ) ) };
+                return r;
+            }
+        };
+
+        typedef avx_lanes   wide_lanes;
+        #else
+        typedef float       wide_lanes;
+        #endif
+
+        //a point of the lanes, the components in the order of glm
+        template <typename t, size_t n> struct lane_point
+        {
+            t m_c[ n ];
+        };
+
+        template <typename t, size_t n> inline lane_point<t, n> load_point( const float* const* planes, size_t i )
+        {
+            lane_point<t, n> r;
+
+            for ( size_t k = 0; k < n; ++k )
+            {
+                r.m_c[k] = lanes<t>::load( planes[k] + i );
+            }
+
+            return r;
+        }
+
+        template <typename t, typename point> inline lane_point<t, components<point>::value> splat_point( const point& p )
+        {
+            lane_point<t, components<point>::value> r;
+
+            for ( size_t k = 0; k < components<point>::value; ++k )
+            {
+                r.m_c[k] = lanes<t>::splat( p[ static_cast<int> ( k ) ] );
+            }
+
+            return r;
+        }
+
+        template <typename t, size_t n> inline lane_point<t, n> operator+( const lane_point<t, n>& a, const lane_point<t, n>& b )
+        {
+            lane_point<t, n> r;
+
+            for ( size_t k = 0; k < n; ++k )
+            {
+                r.m_c[k] = a.m_c[k] + b.m_c[k];
+            }
+
+            return r;
+        }
+
+        template <typename t, size_t n> inline lane_point<t, n> operator-( const lane_point<t, n>& a, const lane_point<t, n>& b )
+        {
+            lane_point<t, n> r;
+
+            for ( size_t k = 0; k < n; ++k )
+            {
+                r.m_c[k] = a.m_c[k] - b.m_c[k];
+            }
+
+            return r;
+        }
+
+        template <typename t, size_t n> inline lane_point<t, n> operator*( const lane_point<t, n>& a, t s )
+        {
+            lane_point<t, n> r;
+
+            for ( size_t k = 0; k < n; ++k )
+            {
+                r.m_c[k] = a.m_c[k] * s;
+            }
+
+            return r;
+        }
+
+        template <typename t, size_t n> inline lane_point<t, n> operator*( t s, const lane_point<t, n>& a )
+        {
+            lane_point<t, n> r;
+
+            for ( size_t k = 0; k < n; ++k )
+            {
+                r.m_c[k] = s * a.m_c[k];
+            }
+
+            return r;
+        }
+
+        //glm: the products, then summed from the first component on
+        template <typename t, size_t n> inline t dot( const lane_point<t, n>& a, const lane_point<t, n>& b )
+        {
+            t r = a.m_c[0] * b.m_c[0];
+
+            for ( size_t k = 1; k < n; ++k )
+            {
+                r = r + a.m_c[k] * b.m_c[k];
+            }
+
+            return r;
+        }
+
+        //evaluate: de casteljau of the control points c[0] .. c[degree]
+        template <typename t, size_t n, size_t degree> inline lane_point<t, n> evaluate( const lane_point<t, n>* c, t u )
+        {
+            lane_point<t, n> b[ degree + 1 ];
+
+            std::copy( c, c + degree + 1, b );
+
+            const t one = lanes<t>::splat( 1.0f );
+
+            for ( size_t i = 1; i <= degree; ++i )
+            {
+                for ( size_t j = 0; j <= degree - i; ++j )
+                {
+                    b[j] = ( one - u ) * b[j] + u * b[ j + 1 ];
+                }
+            }
+
+            return b[0];
+        }
+
+        template <typename t> inline t b0( t u ) { const t tmp = lanes<t>::splat( 1.0f ) - u; return tmp * tmp * tmp; }
+        template <typename t> inline t b1( t u ) { const t tmp = lanes<t>::splat( 1.0f ) - u; return lanes<t>::splat( 3.0f ) * u * ( tmp * tmp ); }
+        template <typename t> inline t b2( t u ) { const t tmp = lanes<t>::splat( 1.0f ) - u; return lanes<t>::splat( 3.0f ) * u * u * tmp; }
+        template <typename t> inline t b3( t u ) { return u * u * u; }
+
+        //runs kernel over [ begin, end ): 8 points at a time, the rest one by one
+        template <typename kernel> inline void for_points( size_t begin, size_t end, const kernel& k )
+        {
+            size_t i = begin;
+
+            for ( ; i + lanes<wide_lanes>::size <= end; i += lanes<wide_lanes>::size )
+            {
+                k.template run<wide_lanes>( i );
+            }
+
+            for ( ; i < end; ++i )
+            {
+                k.template run<float>( i );
+            }
+        }
+
+        //distance( p[i], p[i - 1] )
+        template <size_t n> struct chord_kernel
+        {
+            const float* const* m_planes;
+            float*              m_out;
+
+            template <typename t> void run( size_t i ) const
+            {
+                const auto d = load_point<t, n>( m_planes, i - 1 ) - load_point<t, n>( m_planes, i );
+                lanes<t>::store( m_out + i, lanes<t>::sqrt( dot( d, d ) ) );
+            }
+        };
+
+        struct divide_kernel
+        {
+            float*  m_u;
+            float   m_length;
+
+            template <typename t> void run( size_t i ) const
+            {
+                lanes<t>::store( m_u + i, lanes<t>::load( m_u + i ) / lanes<t>::splat( m_length ) );
+            }
+        };
+
+        //the terms of the sums of generate_bezier
+        template <typename point> struct generate_kernel
+        {
+            static const size_t n = components<point>::value;
+
+            const float* const* m_planes;
+            const float*        m_u;
+            float*              m_terms[5];     //c00, c11, c01, x0, x1
+            point               m_hat1;
+            point               m_hat2;
+            point               m_v0;
+            point               m_v3;
+
+            template <typename t> void run( size_t i ) const
+            {
+                const t    u   = lanes<t>::load( m_u + i );
+                const auto v0  = splat_point<t>( m_v0 );
+                const auto v3  = splat_point<t>( m_v3 );
+                const auto a0  = splat_point<t>( m_hat1 ) * b1( u );
+                const auto a1  = splat_point<t>( m_hat2 ) * b2( u );
+                const auto r   = load_point<t, n>( m_planes, i ) - ( v0 * b0( u ) + v0 * b1( u ) + v3 * b2( u ) + v3 * b3( u ) );
+
+                lanes<t>::store( m_terms[0] + i, dot( a0, a0 ) );
+                lanes<t>::store( m_terms[1] + i, dot( a1, a1 ) );
+                lanes<t>::store( m_terms[2] + i, dot( a0, a1 ) );
+                lanes<t>::store( m_terms[3] + i, dot( a0, r ) );
+                lanes<t>::store( m_terms[4] + i, dot( a1, r ) );
+            }
+        };
+
+        //squared distance of the points to the curve at u
+        template <typename point> struct error_kernel
+        {
+            static const size_t n = components<point>::value;
+
+            const float* const*     m_planes;
+            const float*            m_u;
+            float*                  m_out;
+            std::array<point, 4>    m_bezier;
+
+            template <typename t> void run( size_t i ) const
+            {
+                const lane_point<t, n> c[4] = { splat_point<t>( m_bezier[0] ), splat_point<t>( m_bezier[1] ), splat_point<t>( m_bezier[2] ), splat_point<t>( m_bezier[3] ) };
+
+                const auto p = evaluate<t, n, 3>( c, lanes<t>::load( m_u + i ) );
+                const auto d = p - load_point<t, n>( m_planes, i );
+
+                lanes<t>::store( m_out + i, dot( d, d ) );
+            }
+        };
+
+        template <typename point> struct newton_raphson_kernel
+        {
+            static const size_t n = components<point>::value;
+
+            const float* const*     m_planes;
+            const float*            m_u;
+            float*                  m_out;
+            std::array<point, 4>    m_bezier;
+            std::array<point, 3>    m_q1;
+            std::array<point, 2>    m_q2;
+
+            template <typename t> void run( size_t i ) const
+            {
+                const lane_point<t, n> c[4]  = { splat_point<t>( m_bezier[0] ), splat_point<t>( m_bezier[1] ), splat_point<t>( m_bezier[2] ), splat_point<t>( m_bezier[3] ) };
+                const lane_point<t, n> q1[3] = { splat_point<t>( m_q1[0] ), splat_point<t>( m_q1[1] ), splat_point<t>( m_q1[2] ) };
+                const lane_point<t, n> q2[2] = { splat_point<t>( m_q2[0] ), splat_point<t>( m_q2[1] ) };
+
+                const t    u    = lanes<t>::load( m_u + i );
+                const auto p    = load_point<t, n>( m_planes, i );
+                const auto q_u  = evaluate<t, n, 3>( c, u );
+                const auto q1_u = evaluate<t, n, 2>( q1, u );
+                const auto q2_u = evaluate<t, n, 1>( q2, u );
+
+                const t numerator   = dot( q_u - p, q1_u );
+                const t denomerator = dot( q1_u - p, q1_u - p ) + dot( q_u - p, q2_u );
+
+                lanes<t>::store( m_out + i, lanes<t>::select_zero( denomerator, u, u - numerator / denomerator ) );
+            }
+        };
+
+        //fit_cubic over a structure of arrays copy of one polyline, the buffers are indexed by the point of the polyline
+        template <typename point> class fitter
+        {
+            static const size_t n = components<point>::value;
+
+            const point*                m_points;
+            float                       m_error;
+            std::vector<float>          m_planes[ n ];
+            std::vector<float>          m_u;
+            std::vector<float>          m_u_prime;
+            std::vector<float>          m_terms[ 5 ];
+            std::vector<point>*         m_out;
+
+            const float* m_plane_pointers[ n ];
+
+            void chord_length_parametrize( size_t begin, size_t end, float* u ) const
+            {
+                chord_kernel<n> k = { m_plane_pointers, u };
+
+                for_points( begin + 1, end, k );
+
+                u[ begin ] = 0.0f;
+
+                for ( size_t i = begin + 1; i < end; ++i )
+                {
+                    u[i] = u[ i - 1 ] + u[i];
+                }
+
+                divide_kernel d = { u, u[ end - 1 ] };
+
+                for_points( begin + 1, end, d );
+            }
+
+            std::array<point, 4> generate_bezier( size_t begin, size_t end, const float* u, const point& hat1, const point& hat2 )
+            {
+                const point v0 = m_points[ begin ];
+                const point v3 = m_points[ end - 1 ];
+
+                generate_kernel<point> k = { m_plane_pointers, u, { m_terms[0].data(), m_terms[1].data(), m_terms[2].data(), m_terms[3].data(), m_terms[4].data() }, hat1, hat2, v0, v3 };
+
+                for_points( begin, end, k );
+
+                //std::accumulate order
+                float c00 = 0.0f;
+                float c11 = 0.0f;
+                float c01 = 0.0f;
+                float x0  = 0.0f;
+                float x1  = 0.0f;
+
+                for ( size_t i = begin; i < end; ++i )
+                {
+                    c00 = c00 + m_terms[0][i];
+                    c11 = c11 + m_terms[1][i];
+                    c01 = c01 + m_terms[2][i];
+                    x0  = x0  + m_terms[3][i];
+                    x1  = x1  + m_terms[4][i];
+                }
+
+                const float c10 = c01;
+
+                const float det_c0_c1 = c00 * c11 - c01 * c10;
+                const float det_c0_x  = c00 * x1  - c10 * x0;
+                const float det_x_c1  = c11 * x0  - c01 * x1;
+
+                const float alpha_l = ( det_c0_c1 == 0.0f ) ? 0.0f : det_x_c1 / det_c0_c1;
+                const float alpha_r = ( det_c0_c1 == 0.0f ) ? 0.0f : det_c0_x / det_c0_c1;
+
+                const float segment_length = distance( v0, v3 );
+
+                float scale_l = alpha_l;
+                float scale_r = alpha_r;
+
+                if ( alpha_l < segment_length || alpha_r < segment_length )
+                {
+                    scale_l = segment_length / 3.0f;
+                    scale_r = scale_l;
+                }
+
+                std::array<point, 4> bezier = { { v0, v0 + ( scale_l * hat1 ), v3 + ( scale_r * hat2 ), v3 } };
+                return bezier;
+            }
+
+            //compute_max_error: the largest squared distance and the last point with it, the middle if there is none
+            std::tuple<float, size_t> compute_max_error( size_t begin, size_t end, const std::array<point, 4>& bezier, const float* u )
+            {
+                error_kernel<point> k = { m_plane_pointers, u, m_terms[0].data(), bezier };
+
+                for_points( begin, end, k );
+
+                float  max_distance = 0.0f;
+                size_t split        = begin + ( end - begin ) / 2;
+
+                for ( size_t i = begin; i < end; ++i )
+                {
+                    if ( m_terms[0][i] >= max_distance )
+                    {
+                        max_distance = m_terms[0][i];
+                        split        = i;
+                    }
+                }
+
+                return std::make_tuple( max_distance, split );
+            }
+
+            void reparameterize( size_t begin, size_t end, const std::array<point, 4>& bezier, const float* u, float* out ) const
+            {
+                newton_raphson_kernel<point> k;
+
+                k.m_planes  = m_plane_pointers;
+                k.m_u       = u;
+                k.m_out     = out;
+                k.m_bezier  = bezier;
+
+                for ( int32_t i = 0 ; i <= 2; ++i )
+                {
+                    k.m_q1[i] = ( bezier[ i + 1 ] - bezier[i] ) / 3.0f;
+                }
+
+                for ( int32_t i = 0 ; i <= 1; ++i )
+                {
+                    k.m_q2[i] = ( k.m_q1[ i + 1 ] - k.m_q1[i] ) / 2.0f;
+                }
+
+                for_points( begin, end, k );
+            }
+
+            void emit( const std::array<point, 4>& bezier )
+            {
+                m_out->insert( m_out->end(), std::begin( bezier ), std::end( bezier ) );
+            }
+
+            void fit_cubic( size_t begin, size_t end, const point& hat1, const point& hat2 )
+            {
+                if ( end - begin == 2 )
+                {
+                    const point v0 = m_points[ begin ];
+                    const point v3 = m_points[ end - 1 ];
+                    const float d  = distance( v0, v3 ) / 3.0f;
+
+                    const std::array<point, 4> bezier = { { v0, v0 + ( d * hat1 ), v3 + ( d * hat2 ), v3 } };
+                    emit( bezier );
+                    return;
+                }
+
+                float* u       = m_u.data();
+                float* u_prime = m_u_prime.data();
+
+                chord_length_parametrize( begin, end, u );
+
+                auto bezier    = generate_bezier( begin, end, u, hat1, hat2 );
+                auto max_error = compute_max_error( begin, end, bezier, u );
+
+                if ( std::get<0>( max_error ) < m_error )
+                {
+                    emit( bezier );
+                    return;
+                }
+
+                if ( std::get<0>( max_error ) < m_error * m_error )
+                {
+                    for ( int32_t i = 0; i < 4; ++i )
+                    {
+                        reparameterize( begin, end, bezier, u, u_prime );
+                        bezier = generate_bezier( begin, end, u_prime, hat1, hat2 );
+
+                        //as fit_cubic, the error is measured at the previous parameters
+                        if ( std::get<0>( compute_max_error( begin, end, bezier, u ) ) < m_error )
+                        {
+                            emit( bezier );
+                            return;
+                        }
+
+                        std::copy( u_prime + begin, u_prime + end, u + begin );
+                    }
+                }
+
+                const size_t split = std::get<1>( max_error );
+
+                //the ends of a segment have no error unless the points are not finite, fit_cubic would read past them
+                if ( split == begin || split + 1 == end )
+                {
+                    emit( bezier );
+                    return;
+                }
+
+                const auto tangents = compute_center_tangents< point, point >( m_points[ split - 1 ], m_points[ split ], m_points[ split + 1 ] );
+
+                fit_cubic( begin, split + 1, hat1, std::get<0>( tangents ) );
+                fit_cubic( split, end, std::get<1>( tangents ), hat2 );
+            }
+
+            public:
+
+            explicit fitter( float error ) : m_points( nullptr ), m_error( error ), m_out( nullptr )
+            {
+
+            }
+
+            //appends the cubics of the polyline [ begin, end ), at least 2 points
+            void fit( const point* begin, const point* end, std::vector<point>& out )
+            {
+                const size_t count = end - begin;
+
+                for ( size_t k = 0; k < n; ++k )
+                {
+                    m_planes[k].resize( count );
+
+                    for ( size_t i = 0; i < count; ++i )
+                    {
+                        m_planes[k][i] = begin[i][ static_cast<int> ( k ) ];
+                    }
+
+                    m_plane_pointers[k] = m_planes[k].data();
+                }
+
+                m_u.resize( count );
+                m_u_prime.resize( count );
+
+                for ( auto& t : m_terms )
+                {
+                    t.resize( count );
+                }
+
+                m_points = begin;
+                m_out    = &out;
+
+                const auto hat1 = left_tangent<point, point>( begin[0], begin[1] );
+                const auto hat2 = right_tangent<point, point>( end[ -2 ], end[ -1 ] );
+
+                fit_cubic( 0, count, hat1, hat2 );
+            }
+        };
+
+        template <typename point> inline void fit_polylines( const point* points, const uint32_t* offsets, size_t begin, size_t end, float error, std::vector<point>& out, uint32_t* counts )
+        {
+            fitter<point> f( error );
+
+            for ( size_t i = begin; i < end; ++i )
+            {
+                const size_t before = out.size();
+
+                if ( offsets[ i + 1 ] - offsets[i] >= 2 )
+                {
+                    f.fit( points + offsets[i], points + offsets[ i + 1 ], out );
+                }
+
+                counts[i] = static_cast<uint32_t> ( out.size() - before );
+            }
+        }
+    }
+
+    //fits the polylines points[ offsets[i], offsets[i + 1] ), i < count, like fit_curve on thread_count threads (0 picks
+    //the hardware concurrency). the threads take runs of polylines with about the same number of points. polylines of
+    //fewer than 2 points get no cubics
+    template <typename point> inline curve_batch<point> fit_curve_batch( const point* points, const uint32_t* offsets, size_t count, float error, uint32_t thread_count = 0 )
+    {
+        curve_batch<point> r;
+
+        r.m_offsets.resize( count + 1 );
+
+        if ( count == 0 )
+        {
+            return r;
+        }
+
+        const size_t total   = offsets[ count ] - offsets[0];
+        size_t       threads = thread_count != 0 ? thread_count : std::max( std::thread::hardware_concurrency(), 1u );
+
+        threads = std::max<size_t>( std::min( { threads, total / details::fit_grain, count } ), 1 );
+
+        //the first polyline of every thread, by points
+        std::vector<size_t> first( threads + 1 );
+
+        for ( size_t k = 0; k <= threads; ++k )
+        {
+            const uint32_t target = static_cast<uint32_t> ( offsets[0] + total * k / threads );
+            first[k] = k == threads ? count : static_cast<size_t> ( std::lower_bound( offsets, offsets + count, target ) - offsets );
+        }
+
+        std::vector< std::vector<point> > parts( threads );
+        std::vector<std::thread>          workers;
+
+        workers.reserve( threads - 1 );
+
+        for ( size_t k = 1; k < threads; ++k )
+        {
+            workers.push_back( std::thread( [&, k]
+            {
+                details::fit_polylines( points, offsets, first[k], first[ k + 1 ], error, parts[k], r.m_offsets.data() + 1 );
+            } ) );
+        }
+
+        details::fit_polylines( points, offsets, first[0], first[1], error, parts[0], r.m_offsets.data() + 1 );
+
+        for ( auto& w : workers )
+        {
+            w.join();
+        }
+
+        //counts to offsets, then the parts in order
+        r.m_offsets[0] = 0;
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            r.m_offsets[ i + 1 ] += r.m_offsets[i];
+        }
+
+        r.m_control_points.reserve( r.m_offsets[ count ] );
+
+        for ( const auto& p : parts )
+        {
+            r.m_control_points.insert( r.m_control_points.end(), p.begin(), p.end() );
+        }
+
+        return r;
+    }
+}
+
+BEZIER_FP_CONTRACT_OFF_END
+
+#endif
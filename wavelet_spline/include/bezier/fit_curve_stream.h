@@ -0,0 +1,430 @@
+#ifndef __bezier_fit_curve_stream_h__
+#define __bezier_fit_curve_stream_h__
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "fit_curve.h"
+
+//fit_curve for points that arrive one at a time (pen, telemetry). the open segment starts at the end of the last
+//committed cubic and grows with every point. its cubic is the least squares fit of generate_bezier at chord length
+//parameters, solved in o( 1 ) from power sums of the chord lengths and the points, so appending a point does not
+//touch the others. a fit whose mean squared distance reaches the error is rejected right away, the max of
+//compute_max_error is checked whenever the segment has grown by a quarter. a rejected segment commits its last
+//checked cubic, the next one starts at its end with the opposite tangent (g1) and takes the points after it again.
+//committed points are not read any more
+namespace bezier
+{
+    template <typename point, typename out_iterator_curve> class curve_stream
+    {
+        static const size_t n = details::components<point>::value;
+
+        //the max error is checked again when the segment has grown by 1 / check_growth, amortized o( 1 ) per point
+        static const size_t check_growth = 4;
+
+        struct fit
+        {
+            std::array<point, 4>    m_bezier;
+            point                   m_hat2;
+            size_t                  m_points;
+            double                  m_squared_error;    //the sum over the points
+        };
+
+        float                   m_error;
+        out_iterator_curve      m_out;
+
+        //the open segment, the first point is the end of the last committed cubic
+        std::vector<point>      m_points;
+        std::vector<double>     m_chord;
+
+        //sums of s^k and s^k * ( p - first point ) over the points, s the chord length. the sums of the fit are
+        //polynomials of degree 6 and 3 in u = s / length
+        double                  m_power[7];
+        double                  m_moment[4][ n ];
+        double                  m_norm;
+
+        point                   m_hat1;
+        bool                    m_continued;        //m_hat1 comes from the last committed cubic
+        fit                     m_checked;          //the last cubic within the error at all of its points
+        fit                     m_current;
+        size_t                  m_next_check;
+
+        //b0 .. b3 in the power basis
+        static double bernstein( size_t j, size_t k )
+        {
+            static const double c[4][4] =
+            {
+                { 1.0, -3.0,  3.0, -1.0 },
+                { 0.0,  3.0, -6.0,  3.0 },
+                { 0.0,  0.0,  3.0, -3.0 },
+                { 0.0,  0.0,  0.0,  1.0 }
+            };
+
+            return c[j][k];
+        }
+
+        static double dot( const double* a, const double* b )
+        {
+            double r = 0.0;
+
+            for ( size_t k = 0; k < n; ++k )
+            {
+                r += a[k] * b[k];
+            }
+
+            return r;
+        }
+
+        void start( const point& p )
+        {
+            m_points.assign( 1, p );
+            m_chord.assign( 1, 0.0 );
+
+            std::fill( m_power, m_power + 7, 0.0 );
+            std::fill( &m_moment[0][0], &m_moment[0][0] + 4 * n, 0.0 );
+
+            m_power[0]          = 1.0;
+            m_norm              = 0.0;
+            m_next_check        = 3;
+            m_checked.m_points  = 0;
+            m_current.m_points  = 0;
+        }
+
+        void append( const point& p, double s )
+        {
+            m_points.push_back( p );
+            m_chord.push_back( s );
+
+            double q[ n ];
+
+            for ( size_t k = 0; k < n; ++k )
+            {
+                q[k] = double( p[ static_cast<int> ( k ) ] ) - m_points[0][ static_cast<int> ( k ) ];
+            }
+
+            double w = 1.0;
+
+            for ( size_t k = 0; k < 7; ++k, w *= s )
+            {
+                m_power[k] += w;
+
+                if ( k < 4 )
+                {
+                    for ( size_t c = 0; c < n; ++c )
+                    {
+                        m_moment[k][c] += w * q[c];
+                    }
+                }
+            }
+
+            m_norm += dot( q, q );
+        }
+
+        //generate_bezier over the open segment from the sums, with the epsilon of the wu / barsky heuristic
+        fit solve() const
+        {
+            fit f;
+
+            const size_t count = m_points.size();
+            const point  v0    = m_points[0];
+            const point  v3    = m_points[ count - 1 ];
+
+            f.m_points = count;
+            f.m_hat2   = right_tangent<point, point>( m_points[ count - 2 ], v3 );
+
+            if ( count == 2 )
+            {
+                //fit_cubic for two points, both are on the cubic
+                const float d = distance( v0, v3 ) / 3.0f;
+
+                f.m_bezier[0]       = v0;
+                f.m_bezier[1]       = v0 + ( d * m_hat1 );
+                f.m_bezier[2]       = v3 + ( d * f.m_hat2 );
+                f.m_bezier[3]       = v3;
+                f.m_squared_error   = 0.0;
+
+                return f;
+            }
+
+            const double length = m_chord[ count - 1 ];
+
+            //sums of u^k and of b_j( u ) * q
+            double u[7];
+            double scale = 1.0;
+
+            for ( size_t k = 0; k < 7; ++k, scale /= length )
+            {
+                u[k] = m_power[k] * scale;
+            }
+
+            //p0 is the origin, only b1 .. b3 matter
+            double bq[4][ n ];
+            double bb[4][4];
+
+            for ( size_t j = 1; j < 4; ++j )
+            {
+                for ( size_t c = 0; c < n; ++c )
+                {
+                    double r = 0.0;
+                    double s = 1.0;
+
+                    for ( size_t k = 0; k < 4; ++k, s /= length )
+                    {
+                        r += bernstein( j, k ) * m_moment[k][c] * s;
+                    }
+
+                    bq[j][c] = r;
+                }
+
+                for ( size_t l = j; l < 4; ++l )
+                {
+                    double r = 0.0;
+
+                    for ( size_t a = 0; a < 4; ++a )
+                    {
+                        for ( size_t b = 0; b < 4; ++b )
+                        {
+                            r += bernstein( j, a ) * bernstein( l, b ) * u[ a + b ];
+                        }
+                    }
+
+                    bb[j][l] = r;
+                    bb[l][j] = r;
+                }
+            }
+
+            double h1[ n ];
+            double h2[ n ];
+            double e[ n ];
+
+            for ( size_t c = 0; c < n; ++c )
+            {
+                h1[c] = m_hat1[ static_cast<int> ( c ) ];
+                h2[c] = f.m_hat2[ static_cast<int> ( c ) ];
+                e[c]  = double( v3[ static_cast<int> ( c ) ] ) - v0[ static_cast<int> ( c ) ];
+            }
+
+            const double c00 = dot( h1, h1 ) * bb[1][1];
+            const double c11 = dot( h2, h2 ) * bb[2][2];
+            const double c01 = dot( h1, h2 ) * bb[1][2];
+            const double x0  = dot( h1, bq[1] ) - dot( h1, e ) * ( bb[1][2] + bb[1][3] );
+            const double x1  = dot( h2, bq[2] ) - dot( h2, e ) * ( bb[2][2] + bb[2][3] );
+
+            const double det_c0_c1 = c00 * c11 - c01 * c01;
+
+            double alpha_l = det_c0_c1 == 0.0 ? 0.0 : ( c11 * x0 - c01 * x1 ) / det_c0_c1;
+            double alpha_r = det_c0_c1 == 0.0 ? 0.0 : ( c00 * x1 - c01 * x0 ) / det_c0_c1;
+
+            const double segment_length = std::sqrt( dot( e, e ) );
+            const double epsilon        = 1.0e-6 * segment_length;
+
+            if ( alpha_l < epsilon || alpha_r < epsilon )
+            {
+                //a closed segment has no chord, its length keeps the tangents of the neighbours
+                alpha_l = ( segment_length > 0.0 ? segment_length : length ) / 3.0;
+                alpha_r = alpha_l;
+            }
+
+            //control points relative to v0
+            double p[4][ n ];
+
+            for ( size_t c = 0; c < n; ++c )
+            {
+                p[0][c] = 0.0;
+                p[1][c] = alpha_l * h1[c];
+                p[2][c] = e[c] + alpha_r * h2[c];
+                p[3][c] = e[c];
+            }
+
+            //sum of | q - b( u ) |^2 = sum q.q - 2 sum_j p_j . sum b_j q + sum_j,l p_j . p_l sum b_j b_l
+            double squared_error = m_norm;
+
+            for ( size_t j = 1; j < 4; ++j )
+            {
+                squared_error -= 2.0 * dot( p[j], bq[j] );
+
+                for ( size_t l = 1; l < 4; ++l )
+                {
+                    squared_error += dot( p[j], p[l] ) * bb[j][l];
+                }
+            }
+
+            f.m_squared_error = std::max( squared_error, 0.0 );
+
+            for ( size_t j = 0; j < 4; ++j )
+            {
+                f.m_bezier[j] = v0;
+
+                for ( size_t c = 0; c < n; ++c )
+                {
+                    f.m_bezier[j][ static_cast<int> ( c ) ] = static_cast<float> ( v0[ static_cast<int> ( c ) ] + p[j][c] );
+                }
+            }
+
+            f.m_bezier[0] = v0;
+            f.m_bezier[3] = v3;
+
+            return f;
+        }
+
+        //compute_max_error at the chord length parameters is below the error
+        bool within_error( const fit& f ) const
+        {
+            const double length = m_chord[ f.m_points - 1 ];
+
+            for ( size_t i = 1; i + 1 < f.m_points; ++i )
+            {
+                const float u = static_cast<float> ( m_chord[i] / length );
+                const point p = f.m_bezier[0] * b0( u ) + f.m_bezier[1] * b1( u ) + f.m_bezier[2] * b2( u ) + f.m_bezier[3] * b3( u );
+
+                if ( !( bezier::dot( p - m_points[i], p - m_points[i] ) < m_error ) )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void emit( const fit& f )
+        {
+            for ( const auto& p : f.m_bezier )
+            {
+                *m_out++ = p;
+            }
+        }
+
+        //emits the last checked cubic and starts the next segment at its end, the points after it are taken again
+        void commit()
+        {
+            const fit                f = m_checked;
+            const std::vector<point> rest( m_points.begin() + f.m_points, m_points.end() );
+
+            emit( f );
+            start( f.m_bezier[3] );
+
+            m_hat1      = -1.0f * f.m_hat2;
+            m_continued = true;
+
+            for ( const auto& p : rest )
+            {
+                push( p );
+            }
+        }
+
+        public:
+
+        //error bounds the squared distance of the points to their cubic, as in fit_curve
+        curve_stream( float error, out_iterator_curve out ) :
+        m_error( error )
+        , m_out( out )
+        , m_continued( false )
+        , m_next_check( 3 )
+        {
+
+        }
+
+        void push( const point& p )
+        {
+            if ( m_points.empty() )
+            {
+                start( p );
+                return;
+            }
+
+            //a repeated sample has no chord and no tangent
+            const float d = distance( m_points.back(), p );
+
+            if ( d == 0.0f )
+            {
+                return;
+            }
+
+            append( p, m_chord.back() + d );
+
+            const size_t count = m_points.size();
+
+            if ( count == 2 && !m_continued )
+            {
+                m_hat1 = left_tangent<point, point>( m_points[0], p );
+            }
+
+            const fit f = solve();
+
+            if ( count == 2 )
+            {
+                m_checked = f;
+                m_current = f;
+                return;
+            }
+
+            //the mean squared distance bounds the max from below
+            bool rejected = !( f.m_squared_error < m_error * double( count ) );
+
+            if ( !rejected && count >= m_next_check )
+            {
+                rejected = !within_error( f );
+
+                if ( !rejected )
+                {
+                    m_checked    = f;
+                    m_next_check = count + std::max<size_t>( count / check_growth, 1 );
+                }
+            }
+
+            if ( rejected )
+            {
+                commit();
+            }
+            else
+            {
+                m_current = f;
+            }
+        }
+
+        //commits the open segment, the next point starts a new curve
+        void finish()
+        {
+            while ( m_points.size() >= 2 )
+            {
+                const bool complete = m_current.m_points == m_points.size();
+
+                if ( complete && ( m_checked.m_points == m_points.size() || within_error( m_current ) ) )
+                {
+                    emit( m_current );
+                    break;
+                }
+
+                commit();
+            }
+
+            m_points.clear();
+            m_chord.clear();
+            m_continued = false;
+        }
+
+        //the cubic of the open segment so far, not checked against the error, for previews. valid with 2 points or more
+        const std::array<point, 4>& current() const
+        {
+            return m_current.m_bezier;
+        }
+
+        //points of the open segment, its first is the end of the last committed cubic
+        size_t pending() const
+        {
+            return m_points.size();
+        }
+    };
+
+    template <typename point, typename out_iterator_curve> inline curve_stream<point, out_iterator_curve> make_curve_stream( float error, out_iterator_curve out )
+    {
+        return curve_stream<point, out_iterator_curve>( error, out );
+    }
+}
+
+#endif
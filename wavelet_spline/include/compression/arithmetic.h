@@ -96,6 +96,25 @@ namespace compression
                     frequency[symbol] +=1;
                 });
 
+                //longer inputs are scaled below max_frequency, symbols that occur keep a frequency of at least 1
+                int64_t total = 0;
+
+                for ( auto f : frequency )
+                {
+                    total += f;
+                }
+
+                if ( total > max_frequency )
+                {
+                    for ( auto& f : frequency )
+                    {
+                        if ( f > 0 )
+                        {
+                            f = static_cast<int32_t> ( std::max<int64_t>( 1, f * int64_t( max_frequency - no_of_symbols - 1 ) / total ) );
+                        }
+                    }
+                }
+
                 int freq[ no_of_symbols + 1] = 
                 { 
               
@@ -109,6 +128,182 @@ namespace compression
                 context s;
                 return intialize_frequencies( &s, frequency );
             }
+
+            //largest power of two not above n, the first step of a descent over a binary indexed tree
+            inline constexpr uint32_t highest_power_of_two( uint32_t n, uint32_t p = 1 )
+            {
+                return p * 2 > n ? p : highest_power_of_two( n, p * 2 );
+            }
+
+            //adaptive model of the alphabet [1, symbols]: no analysis pass and no table to transmit, encoder and decoder
+            //start from a frequency of 1 per symbol and add increment to every coded symbol. the cumulative frequencies
+            //are a binary indexed (fenwick) tree, reading, searching and updating them is o( log symbols ). the
+            //frequencies are halved once the total passes limit, which forgets old statistics. the range coder needs
+            //totals below 2^16
+            //
+            //the interface of a model of range::encoder / range::decoder: total(), interval( symbol, low, frequency ),
+            //find( value, low, frequency ) for the symbol with low <= value < low + frequency, update( symbol )
+            template <uint32_t symbols, uint32_t limit = ( 1 << 15 ), uint32_t increment = 32> struct fenwick_context
+            {
+                static const uint32_t top    = highest_power_of_two( symbols );
+                static const uint32_t beyond = 1u << 28;    //the nodes past symbols, a search never steps on them
+
+                uint32_t    m_tree[ 2 * top ];              //m_tree[i] sums the frequencies of ( i - lowbit( i ), i ]
+                uint32_t    m_frequency[ symbols + 1 ];
+                uint32_t    m_total;
+
+                fenwick_context()
+                {
+                    std::fill( std::begin( m_frequency ), std::end( m_frequency ), 1 );
+                    build();
+                }
+
+                void build()
+                {
+                    m_frequency[0] = 0;
+                    m_total        = 0;
+
+                    std::copy( std::begin( m_frequency ), std::end( m_frequency ), std::begin( m_tree ) );
+                    std::fill( std::begin( m_tree ) + symbols + 1, std::end( m_tree ), uint32_t( beyond ) );
+
+                    for ( uint32_t i = 1; i <= symbols; ++i )
+                    {
+                        const uint32_t parent = i + ( i & ( 0u - i ) );
+
+                        if ( parent <= symbols )
+                        {
+                            m_tree[ parent ] += m_tree[i];
+                        }
+
+                        m_total += m_frequency[i];
+                    }
+                }
+
+                uint32_t total() const
+                {
+                    return m_total;
+                }
+
+                //sum of the frequencies of the symbols below symbol
+                uint32_t low( int32_t symbol ) const
+                {
+                    uint32_t r = 0;
+
+                    for ( uint32_t i = symbol - 1; i > 0; i &= i - 1 )
+                    {
+                        r += m_tree[i];
+                    }
+
+                    return r;
+                }
+
+                void interval( int32_t symbol, uint32_t& low_frequency, uint32_t& frequency ) const
+                {
+                    low_frequency = low( symbol );
+                    frequency     = m_frequency[ symbol ];
+                }
+
+                //descent from the root, the steps are conditional moves
+                int32_t find( uint32_t value, uint32_t& low_frequency, uint32_t& frequency ) const
+                {
+                    uint32_t position = 0;
+                    uint32_t sum      = 0;
+
+                    for ( uint32_t step = top; step != 0; step >>= 1 )
+                    {
+                        const uint32_t t    = sum + m_tree[ position + step ];
+                        const bool     take = t <= value;
+
+                        position = take ? position + step : position;
+                        sum      = take ? t : sum;
+                    }
+
+                    low_frequency = sum;
+                    frequency     = m_frequency[ position + 1 ];
+
+                    return position + 1;
+                }
+
+                void update( int32_t symbol )
+                {
+                    m_frequency[ symbol ] += increment;
+                    m_total               += increment;
+
+                    for ( uint32_t i = symbol; i <= symbols; i += i & ( 0u - i ) )
+                    {
+                        m_tree[i] += increment;
+                    }
+
+                    if ( m_total > limit )
+                    {
+                        for ( uint32_t i = 1; i <= symbols; ++i )
+                        {
+                            m_frequency[i] = ( m_frequency[i] + 1 ) / 2;
+                        }
+
+                        build();
+                    }
+                }
+            };
+
+            //order-1 model: a fenwick_context per previous symbol, mixed with an order-0 one. the frequencies of a
+            //symbol are order1_weight * order-1 + order-0, both trees have the same shape, so the mixed tree is
+            //searched in one descent. the order-0 part lets symbols not yet seen after a context code cheaply
+            template <uint32_t symbols, uint32_t order1_weight = 2> struct order1_context
+            {
+                typedef fenwick_context<symbols, ( 1 << 16 ) / ( order1_weight + 1 ) - 64> model;
+
+                model               m_order0;
+                std::vector<model>  m_order1;
+                int32_t             m_previous;
+
+                order1_context() : m_order1( symbols + 1 ), m_previous(0)
+                {
+
+                }
+
+                uint32_t total() const
+                {
+                    return order1_weight * m_order1[ m_previous ].m_total + m_order0.m_total;
+                }
+
+                void interval( int32_t symbol, uint32_t& low_frequency, uint32_t& frequency ) const
+                {
+                    const model& o1 = m_order1[ m_previous ];
+
+                    low_frequency = order1_weight * o1.low( symbol ) + m_order0.low( symbol );
+                    frequency     = order1_weight * o1.m_frequency[ symbol ] + m_order0.m_frequency[ symbol ];
+                }
+
+                int32_t find( uint32_t value, uint32_t& low_frequency, uint32_t& frequency ) const
+                {
+                    const model& o1 = m_order1[ m_previous ];
+
+                    uint32_t position = 0;
+                    uint32_t sum      = 0;
+
+                    for ( uint32_t step = model::top; step != 0; step >>= 1 )
+                    {
+                        const uint32_t t    = sum + order1_weight * o1.m_tree[ position + step ] + m_order0.m_tree[ position + step ];
+                        const bool     take = t <= value;
+
+                        position = take ? position + step : position;
+                        sum      = take ? t : sum;
+                    }
+
+                    low_frequency = sum;
+                    frequency     = order1_weight * o1.m_frequency[ position + 1 ] + m_order0.m_frequency[ position + 1 ];
+
+                    return position + 1;
+                }
+
+                void update( int32_t symbol )
+                {
+                    m_order1[ m_previous ].update( symbol );
+                    m_order0.update( symbol );
+                    m_previous = symbol;
+                }
+            };
         }
 
         namespace encoder
@@ -484,6 +679,459 @@ namespace compression
                 return t;
             }
         };
+
+        //range coder with the models of the cacm87 coder above, it renormalizes a byte at a time instead of a bit. low
+        //has 33 bits, a carry out of the low 32 is added to the bytes that are not written yet: the last one is cached,
+        //a run of 0xff after it is counted (subbotin / schindler with carry, as in lzma). the output is a preallocated
+        //buffer, coding past its end raises an error
+        namespace range
+        {
+            static const uint32_t top_value     = 1u << 24;     //the range is renormalized to [2^24, 2^32)
+
+            //a statistics::context is scaled to a total of 2^total_bits, the coder divides the range by a shift. the
+            //frequencies of the cacm87 model stay below 2^14, scaling up keeps every symbol at least as likely and the
+            //most frequent one gets the rounding
+            static const uint32_t total_bits    = 14;
+
+            inline statistics::context scale_context( const statistics::context& stat )
+            {
+                statistics::context r( stat );
+
+                const int64_t total    = stat.m_cum_frequency[0];
+                int32_t       sum      = 0;
+                uint32_t      largest  = 1;
+
+                for ( uint32_t symbol = 1; symbol <= no_of_symbols; ++symbol )
+                {
+                    const int64_t f = stat.m_cum_frequency[ symbol - 1 ] - stat.m_cum_frequency[ symbol ];
+
+                    r.m_frequency[ symbol ] = static_cast<int32_t> ( ( f << total_bits ) / total );
+                    sum += r.m_frequency[ symbol ];
+
+                    if ( r.m_frequency[ symbol ] > r.m_frequency[ largest ] )
+                    {
+                        largest = symbol;
+                    }
+                }
+
+                r.m_frequency[ largest ] += ( 1 << total_bits ) - sum;
+                r.m_cum_frequency[ no_of_symbols ] = 0;
+
+                for ( int32_t i = no_of_symbols; i > 0; --i )
+                {
+                    r.m_cum_frequency[ i - 1 ] = r.m_cum_frequency[ i ] + r.m_frequency[ i ];
+                }
+
+                return r;
+            }
+
+            namespace encoder
+            {
+                struct context
+                {
+                    statistics::context m_stat;
+
+                    uint64_t            m_low;
+                    uint32_t            m_range;
+                    uint8_t             m_cache;
+                    uint64_t            m_cache_size;
+
+                    uint8_t*            m_output;
+                    uint8_t*            m_begin;
+                    uint8_t*            m_end;
+
+                    context( const statistics::context& stat, uint8_t* begin, uint8_t* end ) :
+                    m_stat( scale_context( stat ) )
+                    , m_begin(begin)
+                    , m_end(end)
+                    {
+                        start_encoding();
+                    }
+
+                    //for coding with models passed to every encode
+                    context( uint8_t* begin, uint8_t* end ) :
+                    m_begin(begin)
+                    , m_end(end)
+                    {
+                        start_encoding();
+                    }
+
+                    void start_encoding()
+                    {
+                        m_low           = 0;
+                        m_range         = 0xFFFFFFFF;
+                        m_cache         = 0;
+                        m_cache_size    = 1;
+                        m_output        = m_begin;
+                    }
+
+                    void put_byte( uint32_t v )
+                    {
+                        if ( m_output == m_end )
+                        {
+                            raise_error();
+                        }
+
+                        *m_output++ = static_cast<uint8_t> ( v );
+                    }
+
+                    //writes the cached byte and the 0xff run once a carry can no longer reach them
+                    void shift_low()
+                    {
+                        if ( static_cast<uint32_t> ( m_low ) < 0xFF000000 || ( m_low >> 32 ) != 0 )
+                        {
+                            const uint32_t carry = static_cast<uint32_t> ( m_low >> 32 );
+                            uint32_t       v     = m_cache;
+
+                            do
+                            {
+                                put_byte( v + carry );
+                                v = 0xFF;
+                            }
+                            while ( --m_cache_size != 0 );
+
+                            m_cache = static_cast<uint8_t> ( m_low >> 24 );
+                        }
+
+                        m_cache_size++;
+                        m_low = ( m_low & 0x00FFFFFF ) << 8;
+                    }
+
+                    void normalize()
+                    {
+                        while ( m_range < top_value )
+                        {
+                            m_range <<= 8;
+                            shift_low();
+                        }
+                    }
+
+                    void encode_symbol( int32_t symbol )
+                    {
+                        const uint32_t r = m_range >> total_bits;
+
+                        m_low   += static_cast<uint64_t> ( r ) * static_cast<uint32_t> ( m_stat.m_cum_frequency[ symbol ] );
+                        m_range  = r * static_cast<uint32_t> ( m_stat.m_cum_frequency[ symbol - 1 ] - m_stat.m_cum_frequency[ symbol ] );
+
+                        normalize();
+                    }
+
+                    //[low, low + frequency) of total, total below 2^16
+                    void encode_interval( uint32_t low, uint32_t frequency, uint32_t total )
+                    {
+                        const uint32_t r = m_range / total;
+
+                        m_low   += static_cast<uint64_t> ( r ) * low;
+                        m_range  = r * frequency;
+
+                        normalize();
+                    }
+
+                    //codes symbol with an adaptive model (statistics::fenwick_context, order1_context) and updates it
+                    template <typename model> void encode( model& m, int32_t symbol )
+                    {
+                        uint32_t low;
+                        uint32_t frequency;
+
+                        m.interval( symbol, low, frequency );
+                        encode_interval( low, frequency, m.total() );
+                        m.update( symbol );
+                    }
+
+                    //the low bits bits of v, equiprobable, most significant first
+                    void encode_bits( uint32_t v, uint32_t bits )
+                    {
+                        for ( ; bits-- > 0; )
+                        {
+                            m_range >>= 1;
+
+                            if ( ( v >> bits ) & 1 )
+                            {
+                                m_low += m_range;
+                            }
+
+                            normalize();
+                        }
+                    }
+
+                    //returns the number of bytes written
+                    size_t done_encoding()
+                    {
+                        for ( uint32_t i = 0; i < 5; ++i )
+                        {
+                            shift_low();
+                        }
+
+                        return m_output - m_begin;
+                    }
+
+                    //streaming: the bytes written to the output are final, a carry only reaches the cached byte and the
+                    //0xff run behind it. once they are taken, coding goes on into a new buffer
+                    size_t written() const
+                    {
+                        return m_output - m_begin;
+                    }
+
+                    size_t available() const
+                    {
+                        return m_end - m_output;
+                    }
+
+                    //bytes the next symbol or done_encoding can write at most: the cached byte, the 0xff run and 4 more
+                    size_t max_output() const
+                    {
+                        return static_cast<size_t> ( m_cache_size ) + 4;
+                    }
+
+                    void set_output( uint8_t* begin, uint8_t* end )
+                    {
+                        m_begin  = begin;
+                        m_end    = end;
+                        m_output = begin;
+                    }
+                };
+
+                //bytes encode_symbol can write at most, with the 5 of done_encoding: the total of a model is below 2^16,
+                //a symbol takes at most 16 bits and a rounding loss below 1 / 256 of a bit
+                inline size_t max_encoded_size( size_t symbols )
+                {
+                    return 2 * symbols + symbols / 256 + 8;
+                }
+
+                //one pass over [begin, end) for the frequencies, a second one to code the bytes and eof_symbol
+                inline size_t encode( const uint8_t* begin, const uint8_t* end, std::vector<uint8_t>& out, statistics::context& stat )
+                {
+                    stat = statistics::create_context( begin, end );
+
+                    out.resize( max_encoded_size( ( end - begin ) + 1 ) );
+
+                    context c( stat, out.data(), out.data() + out.size() );
+
+                    for ( auto it = begin; it != end; ++it )
+                    {
+                        c.encode_symbol( c.m_stat.m_char_to_index[ *it ] );
+                    }
+
+                    c.encode_symbol( eof_symbol );
+
+                    out.resize( c.done_encoding() );
+                    return out.size();
+                }
+            }
+
+            namespace encoder
+            {
+                //single pass over [begin, end) and eof_symbol with an adaptive model of the bytes, nothing to transmit
+                //besides the output. out grows by chunks while coding, the input can be of any length
+                template <typename model> inline size_t encode_adaptive( const uint8_t* begin, const uint8_t* end, std::vector<uint8_t>& out )
+                {
+                    static const size_t chunk = 64 * 1024;
+
+                    model   m;
+                    size_t  done = 0;
+
+                    out.resize( chunk );
+
+                    context c( out.data(), out.data() + out.size() );
+
+                    for ( auto it = begin; ; ++it )
+                    {
+                        if ( c.available() < c.max_output() )
+                        {
+                            done += c.written();
+                            out.resize( std::max( out.size() + chunk, done + c.max_output() ) );
+                            c.set_output( out.data() + done, out.data() + out.size() );
+                        }
+
+                        if ( it == end )
+                        {
+                            break;
+                        }
+
+                        c.encode( m, static_cast<int32_t> ( *it ) + 1 );
+                    }
+
+                    c.encode( m, eof_symbol );
+
+                    if ( c.available() < c.max_output() )
+                    {
+                        done += c.written();
+                        out.resize( done + c.max_output() );
+                        c.set_output( out.data() + done, out.data() + out.size() );
+                    }
+
+                    out.resize( done + c.done_encoding() );
+                    return out.size();
+                }
+            }
+
+            namespace decoder
+            {
+                struct context
+                {
+                    statistics::context     m_stat;
+                    std::vector<uint16_t>   m_symbol;   //symbol of every cumulative frequency of m_stat
+
+                    uint32_t                m_code;
+                    uint32_t                m_range;
+
+                    const uint8_t*          m_input;
+                    const uint8_t*          m_end;
+
+                    context( const statistics::context& stat, const uint8_t* begin, const uint8_t* end ) :
+                    m_stat( scale_context( stat ) )
+                    , m_symbol( 1 << total_bits )
+                    {
+                        for ( uint32_t symbol = 1; symbol <= no_of_symbols; ++symbol )
+                        {
+                            std::fill( m_symbol.begin() + m_stat.m_cum_frequency[ symbol ], m_symbol.begin() + m_stat.m_cum_frequency[ symbol - 1 ], static_cast<uint16_t> ( symbol ) );
+                        }
+
+                        start_decoding( begin, end );
+                    }
+
+                    context( const uint8_t* begin, const uint8_t* end )
+                    {
+                        start_decoding( begin, end );
+                    }
+
+                    //the encoder writes every byte the decoder reads, reading past the end is a corrupt stream
+                    uint32_t get_byte()
+                    {
+                        if ( m_input == m_end )
+                        {
+                            raise_error();
+                        }
+
+                        return *m_input++;
+                    }
+
+                    void start_decoding( const uint8_t* begin, const uint8_t* end )
+                    {
+                        m_input = begin;
+                        m_end   = end;
+                        m_code  = 0;
+                        m_range = 0xFFFFFFFF;
+
+                        //the first byte is the empty cache of the encoder
+                        for ( uint32_t i = 0; i < 5; ++i )
+                        {
+                            m_code = ( m_code << 8 ) | get_byte();
+                        }
+                    }
+
+                    void normalize()
+                    {
+                        while ( m_range < top_value )
+                        {
+                            m_range <<= 8;
+                            m_code  = ( m_code << 8 ) | get_byte();
+                        }
+                    }
+
+                    int32_t decode_symbol()
+                    {
+                        const uint32_t r      = m_range >> total_bits;
+                        const int32_t  symbol = m_symbol[ std::min( m_code / r, ( 1u << total_bits ) - 1 ) ];
+
+                        m_code  -= r * static_cast<uint32_t> ( m_stat.m_cum_frequency[ symbol ] );
+                        m_range  = r * static_cast<uint32_t> ( m_stat.m_cum_frequency[ symbol - 1 ] - m_stat.m_cum_frequency[ symbol ] );
+
+                        normalize();
+
+                        return symbol;
+                    }
+
+                    //decodes a symbol of an adaptive model and updates it, see encoder::context::encode
+                    template <typename model> int32_t decode( model& m )
+                    {
+                        const uint32_t total = m.total();
+                        const uint32_t r     = m_range / total;
+
+                        uint32_t low;
+                        uint32_t frequency;
+
+                        const int32_t symbol = m.find( std::min( m_code / r, total - 1 ), low, frequency );
+
+                        m_code  -= r * low;
+                        m_range  = r * frequency;
+
+                        normalize();
+
+                        m.update( symbol );
+                        return symbol;
+                    }
+
+                    //streaming: a symbol reads at most 2 bytes and a bit at most 1, input refilled to hold that many
+                    //before each of them (or the end of the stream) never runs out
+                    size_t available() const
+                    {
+                        return m_end - m_input;
+                    }
+
+                    void set_input( const uint8_t* begin, const uint8_t* end )
+                    {
+                        m_input = begin;
+                        m_end   = end;
+                    }
+
+                    uint32_t decode_bits( uint32_t bits )
+                    {
+                        uint32_t v = 0;
+
+                        for ( ; bits-- > 0; )
+                        {
+                            m_range >>= 1;
+
+                            const uint32_t bit = m_code >= m_range ? 1 : 0;
+
+                            m_code -= m_range & ( 0u - bit );
+                            v       = 2 * v + bit;
+
+                            normalize();
+                        }
+
+                        return v;
+                    }
+                };
+
+                template < typename model, typename iterator >
+                void decode_adaptive ( const uint8_t* begin, const uint8_t* end, iterator output )
+                {
+                    model   m;
+                    context c( begin, end );
+
+                    for ( ;; )
+                    {
+                        int32_t symbol = c.decode( m );
+
+                        if ( symbol == eof_symbol )
+                        {
+                            break;
+                        }
+
+                        *output++ = static_cast<uint8_t> ( symbol - 1 );
+                    }
+                }
+
+                template < typename iterator >
+                void decode ( context& c, iterator output )
+                {
+                    for ( ;; )
+                    {
+                        int32_t symbol = c.decode_symbol();
+
+                        if ( symbol == eof_symbol )
+                        {
+                            break;
+                        }
+
+                        *output++ = static_cast<uint8_t> ( c.m_stat.m_index_to_char[ symbol ] );
+                    }
+                }
+            }
+        }
+
         namespace helpers
         {
             struct encoded_result
@@ -496,13 +1144,11 @@ namespace compression
             {
                 encoded_result r;
 
-                typedef std::back_insert_iterator < std::vector< uint8_t > > back_iterator;
+                statistics::context stat;
 
-                arithmetic::output_bit_stream< back_iterator  >  s( std::back_inserter( r.m_result ) );
+                arithmetic::range::encoder::encode( begin, end, r.m_result, stat );
 
-                auto context = arithmetic::encoder::encode( begin, end, s );
-
-                std::copy(std::begin(context.m_frequency), std::end(context.m_frequency), std::begin( r.m_frequency_table ) );
+                std::copy(std::begin(stat.m_frequency), std::end(stat.m_frequency), std::begin( r.m_frequency_table ) );
 
                 return r;
             }
@@ -511,11 +1157,31 @@ namespace compression
             {
                 std::vector<uint8_t> r;
 
-                arithmetic::input_bit_stream< std::vector<uint8_t>::const_iterator >  i( encoded.m_result.begin(), encoded.m_result.end()  );
-  
-                arithmetic::decoder::context decode_context ( arithmetic::statistics::create_context( encoded.m_frequency_table ) ) ;
+                arithmetic::range::decoder::context decode_context ( arithmetic::statistics::create_context( encoded.m_frequency_table ), encoded.m_result.data(), encoded.m_result.data() + encoded.m_result.size() ) ;
+
+                arithmetic::range::decoder::decode( decode_context, std::back_inserter( r ) );
+
+                return r;
+            }
+
+            //adaptive coding in one pass, no frequency table: statistics::fenwick_context<no_of_symbols> is order-0,
+            //statistics::order1_context<no_of_symbols> conditions on the previous byte
+            template <typename model = statistics::fenwick_context<no_of_symbols> >
+            inline std::vector<uint8_t> encode_adaptive( const uint8_t* begin, const uint8_t* end )
+            {
+                std::vector<uint8_t> r;
+
+                arithmetic::range::encoder::encode_adaptive<model>( begin, end, r );
+
+                return r;
+            }
+
+            template <typename model = statistics::fenwick_context<no_of_symbols> >
+            inline std::vector<uint8_t> decode_adaptive( const std::vector<uint8_t>& encoded )
+            {
+                std::vector<uint8_t> r;
 
-                arithmetic::decoder::decode( decode_context, i, std::back_inserter( r ) );
+                arithmetic::range::decoder::decode_adaptive<model>( encoded.data(), encoded.data() + encoded.size(), std::back_inserter( r ) );
 
                 return r;
             }
@@ -0,0 +1,436 @@
+#ifndef __compression_rans_h__
+#define __compression_rans_h__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//the avx2 decoder of the 8 lane streams is opt in, define RANS_AVX2_DECODER. the gathers make it slower than the scalar
+//loop over the 8 lanes, which keeps the states of the lanes in registers (280 against 450 MB/s on skewed bytes)
+#if defined(__AVX2__) && defined(RANS_AVX2_DECODER)
+    #define RANS_DECODE_AVX2
+#endif
+
+#if defined(RANS_DECODE_AVX2)
+#include <immintrin.h>
+#endif
+
+#include "arithmetic.h"
+
+//interleaved rans, the alternative to the coders of arithmetic.h with the same models. lanes states (4 or 8) of 32 bits
+//code the symbols round robin, symbol i goes to state i % lanes, so the decoder runs lanes independent dependency
+//chains. a state stays in [2^16, 2^32) and moves 16 bits at a time, a symbol reads or writes at most one word per state.
+//the encoder runs backwards over the symbols and the words
+//
+//stream layout: the final states of the encoder (u32 per lane), then the words (u16), little endian
+namespace compression
+{
+    namespace rans
+    {
+        static const uint32_t lower_bound   = 1u << 16;     //states live in [lower_bound, 2^32)
+        static const uint32_t word_bits     = 16;
+
+        //a statistics::context of the bytes, scaled to 2^scale_bits like the range coder does, and the tables of the
+        //decoder. a symbol takes the slots [start, start + frequency) of 2^scale_bits
+        struct static_model
+        {
+            static const uint32_t scale_bits = arithmetic::range::total_bits;
+            static const uint32_t slots      = 1u << scale_bits;
+
+            uint32_t                m_start[ arithmetic::no_of_symbols + 1 ];
+            uint32_t                m_frequency[ arithmetic::no_of_symbols + 1 ];
+            int32_t                 m_char_to_index[ arithmetic::no_of_chars ];
+
+            std::vector<uint32_t>   m_slot;     //frequency << 16 | slot - start
+            std::vector<uint8_t>    m_char;     //the byte of a slot, 3 bytes of padding for 32 bit gathers
+
+            explicit static_model( const arithmetic::statistics::context& stat ) :
+            m_slot( slots )
+            , m_char( slots + 3 )
+            {
+                const auto s = arithmetic::range::scale_context( stat );
+
+                std::copy( std::begin( s.m_char_to_index ), std::end( s.m_char_to_index ), std::begin( m_char_to_index ) );
+
+                for ( uint32_t symbol = 1; symbol <= arithmetic::no_of_symbols; ++symbol )
+                {
+                    m_start[ symbol ]     = s.m_cum_frequency[ symbol ];
+                    m_frequency[ symbol ] = s.m_cum_frequency[ symbol - 1 ] - s.m_cum_frequency[ symbol ];
+
+                    const uint8_t c = static_cast<uint8_t> ( symbol < arithmetic::no_of_symbols ? s.m_index_to_char[ symbol ] : 0 );
+
+                    for ( uint32_t slot = m_start[ symbol ]; slot < m_start[ symbol ] + m_frequency[ symbol ]; ++slot )
+                    {
+                        m_slot[ slot ] = ( m_frequency[ symbol ] << 16 ) | ( slot - m_start[ symbol ] );
+                        m_char[ slot ] = c;
+                    }
+                }
+            }
+        };
+
+        namespace details
+        {
+            inline void put_word( uint32_t w, uint8_t*& words )
+            {
+                *--words = static_cast<uint8_t> ( w >> 8 );
+                *--words = static_cast<uint8_t> ( w );
+            }
+
+            inline uint32_t get_word( const uint8_t* words )
+            {
+                return words[0] | ( uint32_t( words[1] ) << 8 );
+            }
+
+            //x_max: a state at or above it would leave [lower_bound, 2^32) after coding a symbol of frequency
+            inline uint32_t encode_step( uint32_t x, uint32_t start, uint32_t frequency, uint32_t scale_bits, uint8_t*& words )
+            {
+                if ( x >= ( ( lower_bound >> scale_bits ) << word_bits ) * frequency )
+                {
+                    put_word( x & 0xFFFF, words );
+                    x >>= word_bits;
+                }
+
+                return ( ( x / frequency ) << scale_bits ) + ( x % frequency ) + start;
+            }
+
+            //reads a word when the state fell below lower_bound, with masks rather than a branch: which lanes read is close
+            //to random. checked reads words past the end as 0, the final check of the states finds them
+            template <bool checked> inline uint32_t normalize( uint32_t x, const uint8_t*& words, const uint8_t* end )
+            {
+                const uint32_t w     = !checked || words < end ? get_word( words ) : 0u;
+                const uint32_t below = x < lower_bound;
+                const uint32_t mask  = 0u - below;
+
+                words += 2 * below;
+                return ( x << ( word_bits & mask ) ) | ( w & mask );
+            }
+
+            inline void put_states( const uint32_t* x, uint32_t lanes, uint8_t*& words )
+            {
+                for ( uint32_t lane = lanes; lane-- > 0; )
+                {
+                    put_word( x[ lane ] >> 16, words );
+                    put_word( x[ lane ] & 0xFFFF, words );
+                }
+            }
+
+            //the stream holds at least the states and whole words
+            inline void get_states( uint32_t* x, uint32_t lanes, const uint8_t*& words, const uint8_t* end )
+            {
+                if ( ( end - words ) & 1 || static_cast<size_t> ( end - words ) < 4 * lanes )
+                {
+                    arithmetic::raise_error();
+                }
+
+                for ( uint32_t lane = 0; lane < lanes; ++lane, words += 4 )
+                {
+                    x[ lane ] = get_word( words ) | ( get_word( words + 2 ) << 16 );
+                }
+            }
+
+            //the encoder starts every state at lower_bound, a decoder that used all words and ends there is done right
+            inline void check_end( const uint32_t* x, uint32_t lanes, const uint8_t* words, const uint8_t* end )
+            {
+                bool ok = words == end;
+
+                for ( uint32_t lane = 0; lane < lanes; ++lane )
+                {
+                    ok = ok && x[ lane ] == lower_bound;
+                }
+
+                if ( !ok )
+                {
+                    arithmetic::raise_error();
+                }
+            }
+
+            //the tables come as pointers, the stores of the bytes could alias the members of the model
+            template <bool checked> inline uint8_t decode_step( const uint32_t* slots, const uint8_t* chars, uint32_t& x, const uint8_t*& words, const uint8_t* end )
+            {
+                const uint32_t slot = x & ( static_model::slots - 1 );
+                const uint32_t e    = slots[ slot ];
+
+                x = normalize<checked>( ( e >> 16 ) * ( x >> static_model::scale_bits ) + ( e & 0xFFFF ), words, end );
+                return chars[ slot ];
+            }
+
+            #if defined(RANS_DECODE_AVX2)
+            //for every mask of the lanes that read a word, lane j takes word rank( j ) of the 8 loaded
+            struct lane_permutations
+            {
+                uint32_t m_index[256][8];
+
+                lane_permutations()
+                {
+                    for ( uint32_t mask = 0; mask < 256; ++mask )
+                    {
+                        uint32_t rank = 0;
+
+                        for ( uint32_t lane = 0; lane < 8; ++lane )
+                        {
+                            m_index[ mask ][ lane ] = ( mask >> lane ) & 1 ? rank++ : 0;
+                        }
+                    }
+                }
+            };
+
+            inline const lane_permutations& permutations()
+            {
+                static const lane_permutations p;
+                return p;
+            }
+
+            //groups of 8 symbols with the 8 states in one register: two gathers for the slot entries and the bytes, a
+            //multiply, and a permutation that hands the loaded words to the lanes below lower_bound. it stops with fewer
+            //than 8 words left, the scalar loop does the rest
+            inline size_t decode_avx2( const static_model& m, uint32_t* states, const uint8_t*& words, const uint8_t* end, uint8_t* out, size_t count )
+            {
+                const auto& p        = permutations();
+                const auto  mask     = _mm256_set1_epi32( static_model::slots - 1 );
+                const auto  low16    = _mm256_set1_epi32( 0xFFFF );
+                const auto  bytes    = _mm256_setr_epi8( 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 );
+                const int*  slot     = reinterpret_cast<const int*> ( m.m_slot.data() );
+                const int*  chars    = reinterpret_cast<const int*> ( m.m_char.data() );
+
+                auto x = _mm256_loadu_si256( reinterpret_cast<const __m256i*> ( states ) );
+
+                size_t i = 0;
+
+                for ( ; i + 8 <= count && end - words >= 16; i += 8 )
+                {
+                    const auto s  = _mm256_and_si256( x, mask );
+                    const auto e  = _mm256_i32gather_epi32( slot, s, 4 );
+                    const auto c  = _mm256_i32gather_epi32( chars, s, 1 );
+
+                    //x = frequency * ( x >> scale_bits ) + slot - start
+                    x = _mm256_add_epi32( _mm256_mullo_epi32( _mm256_srli_epi32( e, 16 ), _mm256_srli_epi32( x, static_model::scale_bits ) ), _mm256_and_si256( e, low16 ) );
+
+                    const auto packed = _mm256_shuffle_epi8( c, bytes );
+                    const uint32_t lo = static_cast<uint32_t> ( _mm256_extract_epi32( packed, 0 ) );
+                    const uint32_t hi = static_cast<uint32_t> ( _mm256_extract_epi32( packed, 4 ) );
+                    std::memcpy( out + i,     &lo, 4 );
+                    std::memcpy( out + i + 4, &hi, 4 );
+
+                    //states below 2^16 take the next words in lane order
+                    const auto     below = _mm256_cmpeq_epi32( _mm256_srli_epi32( x, 16 ), _mm256_setzero_si256() );
+                    const uint32_t lanes = static_cast<uint32_t> ( _mm256_movemask_ps( _mm256_castsi256_ps( below ) ) );
+
+                    const auto w  = _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*> ( words ) ) );
+                    const auto pw = _mm256_permutevar8x32_epi32( w, _mm256_loadu_si256( reinterpret_cast<const __m256i*> ( p.m_index[ lanes ] ) ) );
+
+                    x      = _mm256_blendv_epi8( x, _mm256_or_si256( _mm256_slli_epi32( x, 16 ), pw ), below );
+                    words += 2 * _mm_popcnt_u32( lanes );
+                }
+
+                _mm256_storeu_si256( reinterpret_cast<__m256i*> ( states ), x );
+
+                return i;
+            }
+            #endif
+        }
+
+        namespace encoder
+        {
+            //lanes is 4 or 8. returns the size of out
+            template <uint32_t lanes> inline size_t encode( const static_model& m, const uint8_t* begin, const uint8_t* end, std::vector<uint8_t>& out )
+            {
+                const size_t count = end - begin;
+
+                std::vector<uint8_t> buffer( 2 * count + 4 * lanes );
+
+                uint8_t* words = buffer.data() + buffer.size();
+                uint32_t  x[ lanes ];
+
+                std::fill( x, x + lanes, lower_bound );
+
+                for ( size_t i = count; i-- > 0; )
+                {
+                    const int32_t symbol = m.m_char_to_index[ begin[i] ];
+                    auto&         state  = x[ i % lanes ];
+
+                    state = details::encode_step( state, m.m_start[ symbol ], m.m_frequency[ symbol ], static_model::scale_bits, words );
+                }
+
+                details::put_states( x, lanes, words );
+
+                out.assign( words, buffer.data() + buffer.size() );
+                return out.size();
+            }
+
+            //adaptive rans over the bytes: a model of arithmetic::statistics (fenwick_context, order1_context) gives the
+            //interval of every symbol in a forward pass, scaled from its total to 2^16, the states code them backwards.
+            //the decoder runs the model forward in step
+            template <typename model, uint32_t lanes> inline size_t encode_adaptive( const uint8_t* begin, const uint8_t* end, std::vector<uint8_t>& out )
+            {
+                static const uint32_t scale_bits = 16;
+
+                const size_t count = end - begin;
+
+                std::vector<uint32_t> intervals( count );     //start << 16 | frequency - 1
+                model                 m;
+
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    const int32_t symbol = static_cast<int32_t> ( begin[i] ) + 1;
+                    const uint32_t total = m.total();
+
+                    uint32_t low;
+                    uint32_t frequency;
+
+                    m.interval( symbol, low, frequency );
+                    m.update( symbol );
+
+                    const uint32_t start = ( low << scale_bits ) / total;
+                    const uint32_t stop  = ( ( low + frequency ) << scale_bits ) / total;
+
+                    intervals[i] = ( start << 16 ) | ( stop - start - 1 );
+                }
+
+                std::vector<uint8_t> buffer( 2 * count + 4 * lanes );
+
+                uint8_t* words = buffer.data() + buffer.size();
+                uint32_t  x[ lanes ];
+
+                std::fill( x, x + lanes, lower_bound );
+
+                for ( size_t i = count; i-- > 0; )
+                {
+                    auto& state = x[ i % lanes ];
+
+                    state = details::encode_step( state, intervals[i] >> 16, ( intervals[i] & 0xFFFF ) + 1, scale_bits, words );
+                }
+
+                details::put_states( x, lanes, words );
+
+                out.assign( words, buffer.data() + buffer.size() );
+                return out.size();
+            }
+        }
+
+        //gcc vectorizes the arithmetic of the lanes of the scalar decoder across them with avx2, with inserts, extracts and
+        //spills that halve its speed
+        #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC push_options
+        #pragma GCC optimize("no-tree-slp-vectorize")
+        #endif
+
+        namespace decoder
+        {
+            //count bytes of a stream of encoder::encode<lanes> with the same model. with RANS_AVX2_DECODER and avx2 the
+            //8 lane streams are decoded 8 symbols at a time
+            template <uint32_t lanes> inline void decode( const static_model& m, const uint8_t* begin, const uint8_t* end, uint8_t* out, size_t count )
+            {
+                const uint8_t*  words = begin;
+                const uint32_t* slots = m.m_slot.data();
+                const uint8_t*  chars = m.m_char.data();
+                uint32_t        x[ lanes ];
+
+                details::get_states( x, lanes, words, end );
+
+                size_t i = 0;
+
+                #if defined(RANS_DECODE_AVX2)
+                if ( lanes == 8 )
+                {
+                    i = details::decode_avx2( m, x, words, end, out, count );
+                }
+                #endif
+
+                //whole groups while every lane can read a word, then one symbol at a time with checked reads
+                for ( ; i + lanes <= count && static_cast<size_t> ( end - words ) >= 2 * lanes; i += lanes )
+                {
+                    for ( uint32_t lane = 0; lane < lanes; ++lane )
+                    {
+                        out[ i + lane ] = details::decode_step<false>( slots, chars, x[ lane ], words, end );
+                    }
+                }
+
+                for ( ; i < count; ++i )
+                {
+                    out[i] = details::decode_step<true>( slots, chars, x[ i % lanes ], words, end );
+                }
+
+                details::check_end( x, lanes, words, end );
+            }
+
+            template <typename model, uint32_t lanes> inline void decode_adaptive( const uint8_t* begin, const uint8_t* end, uint8_t* out, size_t count )
+            {
+                static const uint32_t scale_bits = 16;
+
+                const uint8_t* words = begin;
+                uint32_t       x[ lanes ];
+                model          m;
+
+                details::get_states( x, lanes, words, end );
+
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    auto&          state = x[ i % lanes ];
+                    const uint32_t total = m.total();
+                    const uint32_t slot  = state & 0xFFFF;
+
+                    //the symbol whose scaled interval holds slot: floor( low * 2^16 / total ) <= slot < floor( high * 2^16 / total )
+                    uint32_t low;
+                    uint32_t frequency;
+
+                    const int32_t  symbol = m.find( ( ( slot + 1 ) * total + 0xFFFF ) / 0x10000 - 1, low, frequency );
+                    const uint32_t start  = ( low << scale_bits ) / total;
+                    const uint32_t stop   = ( ( low + frequency ) << scale_bits ) / total;
+
+                    if ( symbol > static_cast<int32_t> ( arithmetic::no_of_chars ) )
+                    {
+                        arithmetic::raise_error();
+                    }
+
+                    m.update( symbol );
+
+                    out[i] = static_cast<uint8_t> ( symbol - 1 );
+                    state  = details::normalize<true>( ( stop - start ) * ( state >> scale_bits ) + slot - start, words, end );
+                }
+
+                details::check_end( x, lanes, words, end );
+            }
+        }
+
+        #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC pop_options
+        #endif
+
+        namespace helpers
+        {
+            struct encoded_result
+            {
+                std::vector<uint8_t> m_result;
+                int32_t              m_frequency_table[ arithmetic::no_of_symbols + 1 ];
+                size_t               m_size;
+            };
+
+            //the frequency table is the one of arithmetic::helpers::encode, the lanes are 8
+            inline encoded_result encode( const uint8_t* begin, const uint8_t* end )
+            {
+                encoded_result r;
+
+                const auto stat = arithmetic::statistics::create_context( begin, end );
+
+                encoder::encode<8>( static_model( stat ), begin, end, r.m_result );
+
+                std::copy( std::begin( stat.m_frequency ), std::end( stat.m_frequency ), std::begin( r.m_frequency_table ) );
+                r.m_size = end - begin;
+
+                return r;
+            }
+
+            inline std::vector<uint8_t> decode( const encoded_result& encoded )
+            {
+                std::vector<uint8_t> r( encoded.m_size );
+
+                decoder::decode<8>( static_model( arithmetic::statistics::create_context( encoded.m_frequency_table ) ), encoded.m_result.data(), encoded.m_result.data() + encoded.m_result.size(), r.data(), r.size() );
+
+                return r;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,586 @@
+#ifndef __compression_wavelet_codec_h__
+#define __compression_wavelet_codec_h__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "arithmetic.h"
+
+#include "../wavelet/lwt_2d.h"
+
+//lossy image codec of 8 bit images with 1 to 4 interleaved channels: the image is cut into tiles that are coded
+//independently (and in parallel). a tile is level shifted, the first three channels go through the irreversible color
+//transform of jpeg 2000, every channel gets a multi-level cdf 9/7 transform (lwt_2d.h) and a dead-zone quantization
+//with one step per subband. the quantized coefficients are coded with the range coder of arithmetic.h: the magnitude
+//class of a coefficient with an adaptive model picked by the subband orientation and the classes of the coded
+//neighbours, then the sign and the bits below the leading one.
+//
+//lwt.h expects thrust::distance and thrust::iterator_value, include thrust before this header
+//
+//stream layout, little endian:
+//  'w' 'l' 't' '1', width, height (u32), channels, levels (u8), 2 bytes zero, tile size (u32), step (f32)
+//  the byte size of every tile (u32, tiles in row order)
+//  the tiles
+namespace compression
+{
+    namespace wavelet
+    {
+        class exception : public std::exception
+        {
+
+        };
+
+        inline void raise_error()
+        {
+            throw exception();
+        }
+
+        struct parameters
+        {
+            uint32_t    m_tile_size;    //side of a tile in pixels
+            uint32_t    m_levels;       //decomposition levels, at most log2( m_tile_size )
+            float       m_step;         //quantization step of a coefficient of unit synthesis norm, larger is smaller
+            uint32_t    m_threads;      //0 is std::thread::hardware_concurrency()
+
+            parameters() :
+            m_tile_size(256)
+            , m_levels(5)
+            , m_step(8.0f)
+            , m_threads(0)
+            {
+
+            }
+        };
+
+        //pixels are interleaved, m_width * m_channels bytes per row
+        struct image
+        {
+            uint32_t                m_width;
+            uint32_t                m_height;
+            uint32_t                m_channels;
+            std::vector<uint8_t>    m_pixels;
+
+            image() : m_width(0), m_height(0), m_channels(0)
+            {
+
+            }
+        };
+
+        namespace details
+        {
+            static const uint32_t header_size           = 24;
+
+            //class 0 is a zero coefficient, class k a magnitude in [2^(k-1), 2^k), magnitudes are clamped to 24 bits
+            static const uint32_t magnitude_classes     = 25;
+            static const uint32_t max_magnitude         = ( 1u << ( magnitude_classes - 1 ) ) - 1;
+
+            static const uint32_t neighbour_contexts    = 8;
+            static const uint32_t orientations          = 3;        //low-low, one high pass direction, high-high
+
+            //dequantized magnitudes are placed below the middle of the bin, the coefficients are laplacian
+            static const float    reconstruction_bias   = 0.375f;
+
+            //bytes a coefficient can take: a magnitude class and a sign below 14 bits each, at most 23 bits more
+            static const size_t   max_coefficient_size  = 8;
+
+            struct models
+            {
+                arithmetic::statistics::fenwick_context<magnitude_classes>   m_magnitude[ orientations ][ neighbour_contexts ];
+                arithmetic::statistics::fenwick_context<2>                   m_sign[ orientations ];
+            };
+
+            struct subband
+            {
+                uint32_t    m_x;
+                uint32_t    m_y;
+                uint32_t    m_width;
+                uint32_t    m_height;
+                uint32_t    m_orientation;
+                float       m_step;
+            };
+
+            struct layout
+            {
+                uint32_t    m_width;
+                uint32_t    m_height;
+                uint32_t    m_channels;
+                uint32_t    m_levels;
+                uint32_t    m_tile_size;
+                float       m_step;
+
+                uint32_t tiles_x() const
+                {
+                    return ( m_width + m_tile_size - 1 ) / m_tile_size;
+                }
+
+                uint32_t tiles_y() const
+                {
+                    return ( m_height + m_tile_size - 1 ) / m_tile_size;
+                }
+            };
+
+            inline uint32_t magnitude_class( uint32_t magnitude )
+            {
+                uint32_t k = 0;
+
+                for ( ; magnitude != 0; magnitude >>= 1 )
+                {
+                    ++k;
+                }
+
+                return k;
+            }
+
+            //buckets of 2 * ( left + top ) + top left + top right over the classes of the coded neighbours
+            inline uint32_t neighbour_context( const uint8_t* classes, uint32_t x, uint32_t y, uint32_t width )
+            {
+                const uint8_t* row         = classes + size_t( y ) * width;
+                const uint8_t* above       = y > 0 ? row - width : nullptr;
+
+                const uint32_t left        = x > 0 ? row[ x - 1 ] : 0;
+                const uint32_t top         = above ? above[ x ] : 0;
+                const uint32_t top_left    = above && x > 0 ? above[ x - 1 ] : 0;
+                const uint32_t top_right   = above && x + 1 < width ? above[ x + 1 ] : 0;
+
+                const uint32_t s = 2 * ( left + top ) + top_left + top_right;
+
+                static const uint32_t limits[ neighbour_contexts - 1 ] = { 1, 3, 5, 8, 12, 18, 26 };
+
+                uint32_t context = 0;
+
+                while ( context < neighbour_contexts - 1 && s >= limits[ context ] )
+                {
+                    ++context;
+                }
+
+                return context;
+            }
+
+            //l2 norm of the synthesis of a unit coefficient of the 1d cdf 9/7 transform, in the low or high band of level
+            //1 .. levels. the subband norms are the products of a row and a column norm
+            inline float synthesis_norm( uint32_t level, bool high )
+            {
+                const size_t n = size_t( 16 ) << level;
+
+                std::vector<float> x( n, 0.0f );
+
+                x[ ( high ? n >> level : 0 ) + ( n >> ( level + 1 ) ) ] = 1.0f;
+
+                for ( uint32_t i = level; i > 0; --i )
+                {
+                    lwt::cdf97::kernel::inv( x.data(), x.data() + ( n >> ( i - 1 ) ) );
+                }
+
+                double e = 0.0;
+
+                for ( auto v : x )
+                {
+                    e += double( v ) * v;
+                }
+
+                return static_cast<float> ( std::sqrt( e ) );
+            }
+
+            //coarsest first: low-low of the last level, then high-low, low-high and high-high of every level. the steps
+            //make the error of every subband weigh the same in the image
+            inline std::vector<subband> subbands( uint32_t width, uint32_t height, uint32_t levels, float step )
+            {
+                std::vector<subband> r;
+
+                const float low  = synthesis_norm( levels, false );
+
+                subband ll = { 0, 0, width >> levels, height >> levels, 0, step / ( low * low ) };
+                r.push_back( ll );
+
+                for ( uint32_t level = levels; level > 0; --level )
+                {
+                    const uint32_t w  = width  >> level;
+                    const uint32_t h  = height >> level;
+                    const float    l  = synthesis_norm( level, false );
+                    const float    hi = synthesis_norm( level, true );
+
+                    subband hl = { w, 0, w, h, 1, step / ( hi * l ) };
+                    subband lh = { 0, h, w, h, 1, step / ( l * hi ) };
+                    subband hh = { w, h, w, h, 2, step / ( hi * hi ) };
+
+                    r.push_back( hl );
+                    r.push_back( lh );
+                    r.push_back( hh );
+                }
+
+                return r;
+            }
+
+            inline uint32_t padded( uint32_t size, uint32_t levels )
+            {
+                const uint32_t block = 1u << levels;
+                return ( size + block - 1 ) / block * block;
+            }
+
+            inline void put_u32( std::vector<uint8_t>& out, uint32_t v )
+            {
+                out.push_back( static_cast<uint8_t> ( v ) );
+                out.push_back( static_cast<uint8_t> ( v >> 8 ) );
+                out.push_back( static_cast<uint8_t> ( v >> 16 ) );
+                out.push_back( static_cast<uint8_t> ( v >> 24 ) );
+            }
+
+            inline uint32_t get_u32( const uint8_t* p )
+            {
+                return uint32_t( p[0] ) | ( uint32_t( p[1] ) << 8 ) | ( uint32_t( p[2] ) << 16 ) | ( uint32_t( p[3] ) << 24 );
+            }
+
+            //the planes of a tile, padded to a multiple of 2^levels by repeating the last row and column
+            inline void load_tile( const uint8_t* pixels, const layout& l, uint32_t x0, uint32_t y0, uint32_t w, uint32_t h, uint32_t pw, uint32_t ph, float* planes )
+            {
+                const size_t plane = size_t( pw ) * ph;
+
+                for ( uint32_t y = 0; y < ph; ++y )
+                {
+                    const uint8_t* row = pixels + ( size_t( y0 ) + std::min( y, h - 1 ) ) * l.m_width * l.m_channels;
+
+                    for ( uint32_t x = 0; x < pw; ++x )
+                    {
+                        const uint8_t* p = row + ( size_t( x0 ) + std::min( x, w - 1 ) ) * l.m_channels;
+                        const size_t   i = size_t( y ) * pw + x;
+
+                        for ( uint32_t c = 0; c < l.m_channels; ++c )
+                        {
+                            planes[ c * plane + i ] = p[c] - 128.0f;
+                        }
+
+                        if ( l.m_channels >= 3 )
+                        {
+                            const float r = planes[ i ];
+                            const float g = planes[ plane + i ];
+                            const float b = planes[ 2 * plane + i ];
+
+                            planes[ i ]             =  0.299f   * r + 0.587f   * g + 0.114f   * b;
+                            planes[ plane + i ]     = -0.16875f * r - 0.33126f * g + 0.5f     * b;
+                            planes[ 2 * plane + i ] =  0.5f     * r - 0.41869f * g - 0.08131f * b;
+                        }
+                    }
+                }
+            }
+
+            inline void store_tile( const float* planes, const layout& l, uint32_t x0, uint32_t y0, uint32_t w, uint32_t h, uint32_t pw, uint32_t ph, uint8_t* pixels )
+            {
+                const size_t plane = size_t( pw ) * ph;
+
+                for ( uint32_t y = 0; y < h; ++y )
+                {
+                    uint8_t* row = pixels + ( size_t( y0 ) + y ) * l.m_width * l.m_channels;
+
+                    for ( uint32_t x = 0; x < w; ++x )
+                    {
+                        uint8_t*     p = row + ( size_t( x0 ) + x ) * l.m_channels;
+                        const size_t i = size_t( y ) * pw + x;
+
+                        float v[4];
+
+                        for ( uint32_t c = 0; c < l.m_channels; ++c )
+                        {
+                            v[c] = planes[ c * plane + i ];
+                        }
+
+                        if ( l.m_channels >= 3 )
+                        {
+                            const float luma = v[0];
+                            const float cb   = v[1];
+                            const float cr   = v[2];
+
+                            v[0] = luma + 1.402f * cr;
+                            v[1] = luma - 0.34413f * cb - 0.71414f * cr;
+                            v[2] = luma + 1.772f * cb;
+                        }
+
+                        for ( uint32_t c = 0; c < l.m_channels; ++c )
+                        {
+                            p[c] = static_cast<uint8_t> ( std::min( std::max( v[c] + 128.5f, 0.0f ), 255.0f ) );
+                        }
+                    }
+                }
+            }
+
+            inline std::vector<uint8_t> encode_tile( const float* planes, const layout& l, uint32_t pw, uint32_t ph, const std::vector<subband>& bands )
+            {
+                //the bound is far above the usual size, the buffer is left uninitialized and only the written pages are
+                //touched
+                const size_t                                size = size_t( pw ) * ph * l.m_channels * max_coefficient_size + 16;
+                std::unique_ptr<uint8_t[]>                  buffer( new uint8_t[ size ] );
+
+                arithmetic::range::encoder::context         coder( buffer.get(), buffer.get() + size );
+                models                                      m;
+                std::vector<uint8_t>                        classes;
+
+                for ( uint32_t c = 0; c < l.m_channels; ++c )
+                {
+                    const float* plane = planes + size_t( c ) * pw * ph;
+
+                    for ( auto& b : bands )
+                    {
+                        const float scale = 1.0f / b.m_step;
+
+                        classes.resize( size_t( b.m_width ) * b.m_height );
+
+                        for ( uint32_t y = 0; y < b.m_height; ++y )
+                        {
+                            const float* row = plane + size_t( b.m_y + y ) * pw + b.m_x;
+
+                            for ( uint32_t x = 0; x < b.m_width; ++x )
+                            {
+                                const float    v         = row[x];
+                                const uint32_t magnitude = static_cast<uint32_t> ( std::min( std::fabs( v ) * scale, float( max_magnitude ) ) );
+                                const uint32_t k         = magnitude_class( magnitude );
+
+                                coder.encode( m.m_magnitude[ b.m_orientation ][ neighbour_context( classes.data(), x, y, b.m_width ) ], k + 1 );
+
+                                classes[ size_t( y ) * b.m_width + x ] = static_cast<uint8_t> ( k );
+
+                                if ( k > 0 )
+                                {
+                                    coder.encode( m.m_sign[ b.m_orientation ], v < 0.0f ? 2 : 1 );
+                                    coder.encode_bits( magnitude, k - 1 );
+                                }
+                            }
+                        }
+                    }
+                }
+
+                return std::vector<uint8_t>( buffer.get(), buffer.get() + coder.done_encoding() );
+            }
+
+            inline void decode_tile( const uint8_t* begin, const uint8_t* end, const layout& l, uint32_t pw, uint32_t ph, const std::vector<subband>& bands, float* planes )
+            {
+                arithmetic::range::decoder::context         coder( begin, end );
+                models                                      m;
+                std::vector<uint8_t>                        classes;
+
+                for ( uint32_t c = 0; c < l.m_channels; ++c )
+                {
+                    float* plane = planes + size_t( c ) * pw * ph;
+
+                    for ( auto& b : bands )
+                    {
+                        classes.resize( size_t( b.m_width ) * b.m_height );
+
+                        for ( uint32_t y = 0; y < b.m_height; ++y )
+                        {
+                            float* row = plane + size_t( b.m_y + y ) * pw + b.m_x;
+
+                            for ( uint32_t x = 0; x < b.m_width; ++x )
+                            {
+                                const uint32_t k = coder.decode( m.m_magnitude[ b.m_orientation ][ neighbour_context( classes.data(), x, y, b.m_width ) ] ) - 1;
+
+                                classes[ size_t( y ) * b.m_width + x ] = static_cast<uint8_t> ( k );
+
+                                if ( k == 0 )
+                                {
+                                    row[x] = 0.0f;
+                                    continue;
+                                }
+
+                                const int32_t  negative  = coder.decode( m.m_sign[ b.m_orientation ] );
+                                const uint32_t magnitude = ( 1u << ( k - 1 ) ) | coder.decode_bits( k - 1 );
+
+                                const float v = ( magnitude + reconstruction_bias ) * b.m_step;
+                                row[x] = negative == 2 ? -v : v;
+                            }
+                        }
+                    }
+                }
+            }
+
+            //calls f( tile, x0, y0, w, h ) for every tile on up to threads threads
+            template <typename function> inline void for_each_tile( const layout& l, uint32_t threads, const function& f )
+            {
+                const uint32_t tiles_x = l.tiles_x();
+                const uint32_t tiles   = tiles_x * l.tiles_y();
+
+                lwt::details::parallel_blocks( tiles, threads != 0 ? threads : std::max( std::thread::hardware_concurrency(), 1u ), 1, [&]( size_t begin, size_t end )
+                {
+                    for ( size_t t = begin; t < end; ++t )
+                    {
+                        const uint32_t x0 = static_cast<uint32_t> ( t % tiles_x ) * l.m_tile_size;
+                        const uint32_t y0 = static_cast<uint32_t> ( t / tiles_x ) * l.m_tile_size;
+
+                        f( t, x0, y0, std::min( l.m_tile_size, l.m_width - x0 ), std::min( l.m_tile_size, l.m_height - y0 ) );
+                    }
+                });
+            }
+        }
+
+        inline std::vector<uint8_t> encode( const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, const parameters& p = parameters() )
+        {
+            if ( width == 0 || height == 0 || channels == 0 || channels > 4 || p.m_tile_size == 0 || !( p.m_step > 0.0f ) )
+            {
+                raise_error();
+            }
+
+            details::layout l;
+
+            l.m_width       = width;
+            l.m_height      = height;
+            l.m_channels    = channels;
+            l.m_tile_size   = p.m_tile_size;
+            l.m_levels      = std::min( p.m_levels, details::magnitude_class( p.m_tile_size ) - 1 );
+            l.m_step        = p.m_step;
+
+            std::vector< std::vector<uint8_t> > tiles( size_t( l.tiles_x() ) * l.tiles_y() );
+
+            details::for_each_tile( l, p.m_threads, [&]( size_t t, uint32_t x0, uint32_t y0, uint32_t w, uint32_t h )
+            {
+                const uint32_t pw = details::padded( w, l.m_levels );
+                const uint32_t ph = details::padded( h, l.m_levels );
+
+                std::vector<float> planes( size_t( pw ) * ph * channels );
+
+                details::load_tile( pixels, l, x0, y0, w, h, pw, ph, planes.data() );
+
+                for ( uint32_t c = 0; c < channels; ++c )
+                {
+                    lwt::fwd::transform2d<lwt::cdf97::kernel>( planes.data() + size_t( c ) * pw * ph, pw, ph, pw, l.m_levels, 1 );
+                }
+
+                tiles[t] = details::encode_tile( planes.data(), l, pw, ph, details::subbands( pw, ph, l.m_levels, l.m_step ) );
+            });
+
+            std::vector<uint8_t> r;
+
+            r.push_back( 'w' );
+            r.push_back( 'l' );
+            r.push_back( 't' );
+            r.push_back( '1' );
+
+            details::put_u32( r, width );
+            details::put_u32( r, height );
+
+            r.push_back( static_cast<uint8_t> ( channels ) );
+            r.push_back( static_cast<uint8_t> ( l.m_levels ) );
+            r.push_back( 0 );
+            r.push_back( 0 );
+
+            uint32_t step;
+            std::memcpy( &step, &l.m_step, sizeof( step ) );
+
+            details::put_u32( r, l.m_tile_size );
+            details::put_u32( r, step );
+
+            for ( auto& t : tiles )
+            {
+                details::put_u32( r, static_cast<uint32_t> ( t.size() ) );
+            }
+
+            for ( auto& t : tiles )
+            {
+                r.insert( r.end(), t.begin(), t.end() );
+            }
+
+            return r;
+        }
+
+        //threads 0 is std::thread::hardware_concurrency()
+        inline image decode( const uint8_t* begin, const uint8_t* end, uint32_t threads = 0 )
+        {
+            const size_t size = end - begin;
+
+            if ( size < details::header_size || std::memcmp( begin, "wlt1", 4 ) != 0 )
+            {
+                raise_error();
+            }
+
+            details::layout l;
+
+            l.m_width       = details::get_u32( begin + 4 );
+            l.m_height      = details::get_u32( begin + 8 );
+            l.m_channels    = begin[12];
+            l.m_levels      = begin[13];
+            l.m_tile_size   = details::get_u32( begin + 16 );
+
+            const uint32_t step = details::get_u32( begin + 20 );
+            std::memcpy( &l.m_step, &step, sizeof( step ) );
+
+            if ( l.m_width == 0 || l.m_height == 0 || l.m_channels == 0 || l.m_channels > 4 || l.m_tile_size == 0 || l.m_levels >= details::magnitude_class( l.m_tile_size ) || !( l.m_step > 0.0f ) )
+            {
+                raise_error();
+            }
+
+            const size_t tiles = size_t( l.tiles_x() ) * l.tiles_y();
+
+            if ( ( size - details::header_size ) / 4 < tiles )
+            {
+                raise_error();
+            }
+
+            std::vector<size_t> offsets( tiles + 1 );
+
+            offsets[0] = details::header_size + 4 * tiles;
+
+            for ( size_t t = 0; t < tiles; ++t )
+            {
+                offsets[ t + 1 ] = offsets[t] + details::get_u32( begin + details::header_size + 4 * t );
+            }
+
+            if ( offsets[ tiles ] > size )
+            {
+                raise_error();
+            }
+
+            image r;
+
+            r.m_width    = l.m_width;
+            r.m_height   = l.m_height;
+            r.m_channels = l.m_channels;
+            r.m_pixels.resize( size_t( l.m_width ) * l.m_height * l.m_channels );
+
+            //errors of the arithmetic decoder on a tile are passed to the caller once all threads are done
+            std::vector<char> failed( tiles, 0 );
+
+            details::for_each_tile( l, threads, [&]( size_t t, uint32_t x0, uint32_t y0, uint32_t w, uint32_t h )
+            {
+                const uint32_t pw = details::padded( w, l.m_levels );
+                const uint32_t ph = details::padded( h, l.m_levels );
+
+                std::vector<float> planes( size_t( pw ) * ph * l.m_channels );
+
+                try
+                {
+                    details::decode_tile( begin + offsets[t], begin + offsets[ t + 1 ], l, pw, ph, details::subbands( pw, ph, l.m_levels, l.m_step ), planes.data() );
+                }
+                catch ( const arithmetic::exception& )
+                {
+                    failed[t] = 1;
+                    return;
+                }
+
+                for ( uint32_t c = 0; c < l.m_channels; ++c )
+                {
+                    lwt::inv::transform2d<lwt::cdf97::kernel>( planes.data() + size_t( c ) * pw * ph, pw, ph, pw, l.m_levels, 1 );
+                }
+
+                details::store_tile( planes.data(), l, x0, y0, w, h, pw, ph, r.m_pixels.data() );
+            });
+
+            if ( std::find( failed.begin(), failed.end(), 1 ) != failed.end() )
+            {
+                raise_error();
+            }
+
+            return r;
+        }
+
+        inline image decode( const std::vector<uint8_t>& stream, uint32_t threads = 0 )
+        {
+            return decode( stream.data(), stream.data() + stream.size(), threads );
+        }
+    }
+}
+
+#endif
@@ -25,6 +25,44 @@ Notes: For production usage please consider inlining all functions into one. Thi
 
 namespace svd
 {
+    //jacobi sweeps of the decomposition. float runs a fixed number of them. double runs them until every lane has converged
+    //to the tolerance of the number type and then refines v (see refine_v), the number is only a cap for lanes that do not
+    //get there
+    template <typename t> struct jacobi_sweeps
+    {
+        static const int32_t value = 4;
+        static const bool refine = false;
+
+        //0 runs all the sweeps
+        static float tolerance() { return 0.0f; }
+    };
+
+    //a few ulp of double. a fixed 6 sweeps left the off diagonal part of ill conditioned A'A at about 1e-7
+    template <typename t> struct jacobi_sweeps_double
+    {
+        static const int32_t value = 20;
+        static const bool refine = true;
+
+        static float tolerance() { return 1.0e-15f; }
+    };
+
+    template <> struct jacobi_sweeps<cpu_scalar_double> : jacobi_sweeps_double<cpu_scalar_double>
+    {
+
+    };
+
+    template <> struct jacobi_sweeps<sse_vector_double> : jacobi_sweeps_double<sse_vector_double>
+    {
+
+    };
+
+#if defined(SVD_MATH_AVX)
+    template <> struct jacobi_sweeps<avx_vector_double> : jacobi_sweeps_double<avx_vector_double>
+    {
+
+    };
+#endif
+
     template <typename t>
     struct givens_quaternion_t
     {
@@ -37,10 +75,10 @@ namespace svd
         using namespace math;
         auto half = splat<t> ( 0.5f );
         auto sh = a12 * half;
-        auto id  = cmp_ge( sh * sh,  splat<t> ( tiny_number ) );
+        auto id  = cmp_ge( sh * sh,  constants<t>::tiny_number() );
         
         //if sh squared is tiny, make sh = 0 and ch = 1. this comes from the several jacobi iterations
-        sh = and( id, sh );
+        sh = bit_and( id, sh );
         auto ch = blend ( one<t>(), a11 - a22, id );
 
         auto sh_2 = sh * sh;
@@ -57,8 +95,8 @@ namespace svd
 
         auto b = cmp_le( ch_2, sh_2 * splat<t>( four_gamma_squared ) ) ;
 
-        sh = blend ( sh, splat<t>( sine_pi_over_eight ), b );
-        ch = blend ( ch, splat<t>( cosine_pi_over_eight ), b );
+        sh = blend ( sh, constants<t>::sine_pi_over_eight(), b );
+        ch = blend ( ch, constants<t>::cosine_pi_over_eight(), b );
 
         return { ch, sh };
     }
@@ -81,8 +119,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -96,8 +134,8 @@ namespace svd
             auto t1 = a31;
             auto t2 = a32;
 
-            a31 = c * t1 + s * t2;
-            a32 = c * t2 - s * t1;
+            a31 = madd( c, t1, s * t2 );
+            a32 = nmadd( s, t1, c * t2 );
             a33 = a33;
 
             auto t3 = a11;
@@ -120,10 +158,10 @@ namespace svd
             auto r2 = 0;
             auto r3 = sh;
 
-            qw = r0 * q0 - r3 * q3;
-            qx = r0 * q1 + r3 * q2;
-            qy = r0 * q2 - r3 * q1;
-            qz = r0 * q3 + r3 * q0;
+            qw = nmadd( r3, q3, r0 * q0 );
+            qx = madd( r0, q1, r3 * q2 );
+            qy = nmadd( r3, q1, r0 * q2 );
+            qz = madd( r0, q3, r3 * q0 );
 
         }
         else if ( p == 2 && q == 3 )
@@ -132,8 +170,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -147,8 +185,8 @@ namespace svd
             auto t1 = a21;
             auto t2 = a31;
 
-            a21 = c * t1 + s * t2;
-            a31 = c * t2 - s * t1;
+            a21 = madd( c, t1, s * t2 );
+            a31 = nmadd( s, t1, c * t2 );
             a11 = a11;
 
             auto t3 = a22;
@@ -170,10 +208,10 @@ namespace svd
             auto r2 = 0;
             auto r3 = 0;
 
-            qw = r0 * q0 - r1 * q1;
-            qx = r0 * q1 + r1 * q0;
-            qy = r0 * q2 + r1 * q3;
-            qz = r0 * q3 - r1 * q2;
+            qw = nmadd( r1, q1, r0 * q0 );
+            qx = madd( r0, q1, r1 * q0 );
+            qy = madd( r0, q2, r1 * q3 );
+            qz = nmadd( r1, q2, r0 * q3 );
         }
         else if ( p == 1 && q == 3 )
         {
@@ -181,8 +219,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -196,8 +234,8 @@ namespace svd
             auto t1 = a32;
             auto t2 = a21;
 
-            a32 = c * t1 + s * t2;
-            a21 = c * t2 - s * t1;
+            a32 = madd( c, t1, s * t2 );
+            a21 = nmadd( s, t1, c * t2 );
             a22 = a22;
 
             auto t3 = a33;
@@ -219,10 +257,10 @@ namespace svd
             auto r2 = sh;
             auto r3 = 0;
 
-            qw = r0 * q0 - r2 * q2;
-            qx = r0 * q1 - r2 * q3;
-            qy = r0 * q2 + r2 * q0;
-            qz = r0 * q3 + r2 * q1;
+            qw = nmadd( r2, q2, r0 * q0 );
+            qx = nmadd( r2, q3, r0 * q1 );
+            qy = madd( r0, q2, r2 * q0 );
+            qz = madd( r0, q3, r2 * q1 );
         }
     }
 
@@ -237,17 +275,17 @@ namespace svd
     {
         using namespace svd::math;
 
-        auto a11 = in.a11 * in.a11 + in.a21 * in.a21 + in.a31 * in.a31;
-        auto a12 = in.a11 * in.a12 + in.a21 * in.a22 + in.a31 * in.a32;
-        auto a13 = in.a11 * in.a13 + in.a21 * in.a23 + in.a31 * in.a33;
+        auto a11 = dot3( in.a11, in.a21, in.a31, in.a11, in.a21, in.a31 );
+        auto a12 = dot3( in.a11, in.a21, in.a31, in.a12, in.a22, in.a32 );
+        auto a13 = dot3( in.a11, in.a21, in.a31, in.a13, in.a23, in.a33 );
 
         auto a21 = a12;
-        auto a22 = in.a12 * in.a12 + in.a22 * in.a22 + in.a32 * in.a32;
-        auto a23 = in.a12 * in.a13 + in.a22 * in.a23 + in.a32 * in.a33;
+        auto a22 = dot3( in.a12, in.a22, in.a32, in.a12, in.a22, in.a32 );
+        auto a23 = dot3( in.a12, in.a22, in.a32, in.a13, in.a23, in.a33 );
 
         auto a31 = a13;
         auto a32 = a23;
-        auto a33 = in.a13 * in.a13 + in.a23 * in.a23 + in.a33 * in.a33;
+        auto a33 = dot3( in.a13, in.a23, in.a33, in.a13, in.a23, in.a33 );
 
         symmetric_matrix3x3<t> r = { a11, a21, a22, a31, a32, a33 };
         return r;
@@ -288,22 +326,22 @@ namespace svd
         q.w = q.w * w;
     }
 
-    template <typename t> inline void conditional_swap( t c, t& x, t& y )
+    template <typename t, typename mask> inline void conditional_swap( mask c, t& x, t& y )
     {
         using namespace math;
-        auto t = xor( x, y );
-        auto m = and( c, t );
-        x = xor ( x, m );
-        y = xor ( y, m );
+        auto d = bit_xor( x, y );
+        auto m = bit_and( c, d );
+        x = bit_xor( x, m );
+        y = bit_xor( y, m );
     }
 
     //returns -1.0f or 1.0f depending on c
     //used for conditional_negative_swap
-    template <typename t> inline t negative_conditional_swap_multiplier( t c )
+    template <typename t, typename mask> inline t negative_conditional_swap_multiplier( mask c )
     {
         using namespace math;
         auto two = splat<t>(-2.0f);
-        auto m = and( c, two );
+        auto m = bit_and( c, two );
         return one<t>() + m;
     }
 
@@ -321,10 +359,10 @@ namespace svd
             auto y = v.y;
             auto z = v.z;
 
-            v.w = w + c * z;
-            v.x = x - c * y;
-            v.y = y + c * x;
-            v.z = z - c * w;
+            v.w = madd( c, z, w );
+            v.x = nmadd( c, y, x );
+            v.y = madd( c, x, y );
+            v.z = nmadd( c, w, z );
         }
         else if ( axis == 2 )
         {
@@ -336,10 +374,10 @@ namespace svd
             auto y = v.y;
             auto z = v.z;
 
-            v.w = w + c * y;
-            v.x = x + c * z;
-            v.y = y - c * w;
-            v.z = z - c * x;
+            v.w = madd( c, y, w );
+            v.x = madd( c, z, x );
+            v.y = nmadd( c, w, y );
+            v.z = nmadd( c, x, z );
 
         }
         else if ( axis == 1 )
@@ -352,10 +390,10 @@ namespace svd
             auto y = v.y;
             auto z = v.z;
 
-            v.w = w + c * x;
-            v.x = x - c * w;
-            v.y = y - c * z;
-            v.z = z + c * y;
+            v.w = madd( c, x, w );
+            v.x = nmadd( c, w, x );
+            v.y = nmadd( c, z, y );
+            v.z = madd( c, y, z );
         }
     }
 
@@ -365,15 +403,15 @@ namespace svd
 
         auto half = splat<t> ( 0.5f );
 
-        auto id = cmp_ge( a2 * a2,  splat<t> ( small_number ) );
-        auto sh = and( id, a2 );
+        auto id = cmp_ge( a2 * a2,  constants<t>::small_number() );
+        auto sh = bit_and( id, a2 );
 
         auto ch = max ( a1, zero<t>() - a1 );
         auto c = cmp_le( a1, zero<t>() );
-        ch = max ( ch, splat<t>(small_number ) );
+        ch = max ( ch, constants<t>::small_number() );
 
         // compute sqrt(ch * ch + sh * sh )
-        auto x = ch * ch + sh * sh;
+        auto x = madd( ch, ch, sh * sh );
         auto w = rsqrt( x );
         //one iteration of newton rhapson.
         w = w + ( w * half ) - ( ( w * half )  *  w * w * x  );
@@ -384,7 +422,7 @@ namespace svd
 
         conditional_swap(c, ch, sh );
 
-        x = ch * ch + sh * sh;
+        x = madd( ch, ch, sh * sh );
         w = rsqrt( x );
         //one iteration of newton rhapson.
         w = w + ( w * half ) - ( ( w * half )  *  w * w * x  );
@@ -413,8 +451,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -433,14 +471,14 @@ namespace svd
             auto t22 = a22;
             auto t23 = a23;
 
-            a11 = c * t11 + s * t21;
-            a21 = c * t21 - s * t11;   
+            a11 = madd( c, t11, s * t21 );
+            a21 = nmadd( s, t11, c * t21 );   
 
-            a12 = c * t12 + s * t22;
-            a22 = c * t22 - s * t12;
+            a12 = madd( c, t12, s * t22 );
+            a22 = nmadd( s, t12, c * t22 );
             
-            a13 = c * t13 + s * t23;
-            a23 = c * t23 - s * t13;
+            a13 = madd( c, t13, s * t23 );
+            a23 = nmadd( s, t13, c * t23 );
 
             //now create the apply the total quaternion transformation7
             auto w = qw;
@@ -461,8 +499,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -481,14 +519,14 @@ namespace svd
             auto t22 = a32;
             auto t23 = a33;
 
-            a21 = c * t11 + s * t21;
-            a31 = c * t21 - s * t11;   
+            a21 = madd( c, t11, s * t21 );
+            a31 = nmadd( s, t11, c * t21 );   
 
-            a22 = c * t12 + s * t22;
-            a32 = c * t22 - s * t12;
+            a22 = madd( c, t12, s * t22 );
+            a32 = nmadd( s, t12, c * t22 );
             
-            a23 = c * t13 + s * t23;
-            a33 = c * t23 - s * t13;
+            a23 = madd( c, t13, s * t23 );
+            a33 = nmadd( s, t13, c * t23 );
 
             //now create the apply the total quaternion transformation7
             auto w = qw;
@@ -497,10 +535,10 @@ namespace svd
             auto z = qz;
 
             //Quaternion[ ch, sh, 0, 0] -> q * r
-            qw = ch * w - sh * x;
-            qx = ch * x + sh * w;
-            qy = ch * y + sh * z;
-            qz = ch * z - sh * y;
+            qw = nmadd( sh, x, ch * w );
+            qx = madd( ch, x, sh * w );
+            qy = madd( ch, y, sh * z );
+            qz = nmadd( sh, y, ch * z );
 
         }
         else if ( p == 1 && q == 3 )
@@ -509,8 +547,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -529,14 +567,14 @@ namespace svd
             auto t22 = a32;
             auto t23 = a33;
 
-            a11 = c * t11 + s * t21;
-            a31 = c * t21 - s * t11;   
+            a11 = madd( c, t11, s * t21 );
+            a31 = nmadd( s, t11, c * t21 );   
 
-            a12 = c * t12 + s * t22;
-            a32 = c * t22 - s * t12;
+            a12 = madd( c, t12, s * t22 );
+            a32 = nmadd( s, t12, c * t22 );
             
-            a13 = c * t13 + s * t23;
-            a33 = c * t23 - s * t13;
+            a13 = madd( c, t13, s * t23 );
+            a33 = nmadd( s, t13, c * t23 );
 
             //now create the apply the total quaternion transformation
             auto w = qw;
@@ -552,8 +590,106 @@ namespace svd
         }
     }
 
-    //obtain A = USV' 
-    template < typename t > inline void compute( const matrix3x3<t>& in, quaternion<t>& u, vector3<t>& s, quaternion<t>& v )
+    //lanes where the off diagonal part of m is below tolerance_squared times its diagonal (squared frobenius norms)
+    template < typename t > inline auto jacobi_converged( const symmetric_matrix3x3<t>& m, t tolerance_squared ) -> decltype( math::cmp_le( m.a11, m.a11 ) )
+    {
+        using namespace svd::math;
+
+        auto off_diagonal = dot3( m.a21, m.a31, m.a32, m.a21, m.a31, m.a32 );
+        auto diagonal     = dot3( m.a11, m.a22, m.a33, m.a11, m.a22, m.a33 );
+
+        return cmp_le( off_diagonal, diagonal * tolerance_squared );
+    }
+
+    //lanes where every off diagonal element of m is below the tolerance relative to its two diagonal elements,
+    //a_pq^2 <= tolerance_squared * a_pp * a_qq. this also holds the small eigenvalues to the tolerance
+    template < typename t > inline auto jacobi_converged_pairs( const symmetric_matrix3x3<t>& m, t tolerance_squared ) -> decltype( math::cmp_le( m.a11, m.a11 ) )
+    {
+        using namespace svd::math;
+
+        auto d21 = nmadd( m.a11 * m.a22, tolerance_squared, m.a21 * m.a21 );
+        auto d31 = nmadd( m.a11 * m.a33, tolerance_squared, m.a31 * m.a31 );
+        auto d32 = nmadd( m.a22 * m.a33, tolerance_squared, m.a32 * m.a32 );
+
+        return cmp_le( max( max( d21, d31 ), d32 ), zero<t>() );
+    }
+
+    //jacobi sweeps that diagonalize m, v accumulates the rotations (m = v' * m0 * v).
+    //a non zero tolerance stops the sweeps once every lane has converged to it, 0 is the tolerance of the number type
+    //(jacobi_sweeps). returns the number of sweeps that ran
+    template < typename t > inline int32_t jacobi_sweep( symmetric_matrix3x3<t>& m, quaternion<t>& v, float tolerance )
+    {
+        using namespace svd::math;
+
+        if ( tolerance == 0.0f )
+        {
+            tolerance = jacobi_sweeps<t>::tolerance();
+        }
+
+        auto tolerance_squared = splat<t>( tolerance * tolerance );
+        auto sweeps = 0;
+
+        //the check costs more than it saves after the first sweep, where only tolerances above the distance of m from the
+        //diagonal stop, and after the last one, where it saves nothing
+        const auto first_check = 2;
+
+        while ( sweeps < jacobi_sweeps<t>::value )
+        {
+            svd::jacobi_conjugation< t, 1, 2 > ( m, v );
+            svd::jacobi_conjugation< t, 2, 3 > ( m, v );
+            svd::jacobi_conjugation< t, 1, 3 > ( m, v );
+
+            ++sweeps;
+
+            if ( tolerance > 0.0f && sweeps >= first_check && sweeps < jacobi_sweeps<t>::value && all( jacobi_converged( m, tolerance_squared ) ) )
+            {
+                break;
+            }
+        }
+
+        return sweeps;
+    }
+
+    //refinement of the right singular vectors v of A. the entries of A'A have errors relative to the largest singular value,
+    //so sweeps on it leave the small singular vectors of ill conditioned A inaccurate. the sweeps run again on (AV)'(AV), whose
+    //entries are accurate relative to their own rows and columns, until every lane has converged relative to the diagonal
+    //(jacobi_converged_pairs). v is nearly right, so this takes a few sweeps. returns the number of sweeps that ran
+    template < typename t > inline int32_t refine_v( const matrix3x3<t>& in, quaternion<t>& v )
+    {
+        using namespace svd::math;
+
+        auto r  = create_rotation_matrix( v );
+        auto av = create_matrix
+            (
+                dot3( in.a11, in.a12, in.a13, r.a11, r.a21, r.a31 ), dot3( in.a11, in.a12, in.a13, r.a12, r.a22, r.a32 ), dot3( in.a11, in.a12, in.a13, r.a13, r.a23, r.a33 ),
+                dot3( in.a21, in.a22, in.a23, r.a11, r.a21, r.a31 ), dot3( in.a21, in.a22, in.a23, r.a12, r.a22, r.a32 ), dot3( in.a21, in.a22, in.a23, r.a13, r.a23, r.a33 ),
+                dot3( in.a31, in.a32, in.a33, r.a11, r.a21, r.a31 ), dot3( in.a31, in.a32, in.a33, r.a12, r.a22, r.a32 ), dot3( in.a31, in.a32, in.a33, r.a13, r.a23, r.a33 )
+            );
+
+        //(AV)'(AV) = V'A'AV
+        auto m = create_symmetric_matrix( av );
+
+        auto tolerance         = jacobi_sweeps<t>::tolerance();
+        auto tolerance_squared = splat<t>( tolerance * tolerance );
+        auto sweeps = 0;
+
+        while ( sweeps < jacobi_sweeps<t>::value && !all( jacobi_converged_pairs( m, tolerance_squared ) ) )
+        {
+            svd::jacobi_conjugation< t, 1, 2 > ( m, v );
+            svd::jacobi_conjugation< t, 2, 3 > ( m, v );
+            svd::jacobi_conjugation< t, 1, 3 > ( m, v );
+
+            ++sweeps;
+        }
+
+        normalize<t>( v );
+
+        return sweeps;
+    }
+
+    //1. of the decomposition: v are the right singular vectors, the eigenvectors of A'A, as a unit quaternion.
+    //a non zero tolerance stops the sweeps once every lane has converged to it. returns the number of sweeps that ran
+    template < typename t > inline int32_t compute_v( const matrix3x3<t>& in, quaternion<t>& v, float tolerance = 0.0f )
     {
         using namespace svd::math;
 
@@ -563,24 +699,82 @@ namespace svd
         auto vz = splat<t>( 0.0f );
         auto vw = splat<t>( 1.0f );
 
-        u = create_quaternion ( vx, vy, vz, vw );
         v = create_quaternion ( vx, vy, vz, vw );
 
         auto m = create_symmetric_matrix( in );
-        
-        //1. Compute the V matrix as a quaternion
 
-        //4 iterations of jacobi conjugation to obtain V
-        for (auto i = 0; i < 4 ; ++i)
-        {
-            svd::jacobi_conjugation< t, 1, 2 > ( m, v );
-            svd::jacobi_conjugation< t, 2, 3 > ( m, v );
-            svd::jacobi_conjugation< t, 1, 3 > ( m, v );
-        }
+        //iterations of jacobi conjugation to obtain V
+        auto sweeps = jacobi_sweep( m, v, tolerance );
 
         //normalize the quaternion. this is optional
         normalize<t>(v);
 
+        if ( jacobi_sweeps<t>::refine )
+        {
+            sweeps += refine_v( in, v );
+        }
+
+        return sweeps;
+    }
+
+    //eigenvalues lambda (descending) and eigenvectors of a symmetric matrix, A = V * diag(lambda) * transpose(V).
+    //the columns of the rotation matrix of the unit quaternion v are the eigenvectors, the last one belongs to the smallest
+    //eigenvalue (the normal of a covariance matrix). this is step 1. of the decomposition applied to A itself, so there is
+    //no A'A and no qr factorization. A is scaled to unit norm first, because the thresholds of the jacobi rotations are absolute.
+    //a non zero tolerance stops the sweeps once every lane has converged to it. returns the number of sweeps that ran
+    template < typename t > inline int32_t eigen_symmetric( const symmetric_matrix3x3<t>& in, vector3<t>& lambda, quaternion<t>& v, float tolerance = 0.0f )
+    {
+        using namespace svd::math;
+
+        auto two  = splat<t>( 2.0f );
+        auto half = splat<t>( 0.5f );
+
+        auto norm2 = madd( two, dot3( in.a21, in.a31, in.a32, in.a21, in.a31, in.a32 ), dot3( in.a11, in.a22, in.a33, in.a11, in.a22, in.a33 ) );
+
+        //the zero matrix stays zero
+        auto scale     = rsqrt( max( norm2, constants<t>::tiny_number() ) );
+        auto inv_scale = one<t>() / scale;
+
+        symmetric_matrix3x3<t> m = { in.a11 * scale, in.a21 * scale, in.a22 * scale, in.a31 * scale, in.a32 * scale, in.a33 * scale };
+
+        v = create_quaternion ( zero<t>(), zero<t>(), zero<t>(), one<t>() );
+
+        auto sweeps = jacobi_sweep( m, v, tolerance );
+
+        auto l1 = m.a11 * inv_scale;
+        auto l2 = m.a22 * inv_scale;
+        auto l3 = m.a33 * inv_scale;
+
+        //sort, a column swap of the eigenvectors is a quarter turn of v, see compute_us
+        auto c = cmp_lt( l1, l2 );
+        conditional_swap( c, l1, l2 );
+        conditional_swap<t, 3>( v, negative_conditional_swap_multiplier<t>( c ) * half - half );
+
+        c = cmp_lt( l1, l3 );
+        conditional_swap( c, l1, l3 );
+        conditional_swap<t, 2>( v, negative_conditional_swap_multiplier<t>( c ) * half - half );
+
+        c = cmp_lt( l2, l3 );
+        conditional_swap( c, l2, l3 );
+        conditional_swap<t, 1>( v, negative_conditional_swap_multiplier<t>( c ) * half - half );
+
+        normalize( v );
+
+        lambda.x = l1;
+        lambda.y = l2;
+        lambda.z = l3;
+
+        return sweeps;
+    }
+
+    //2. and 3. of the decomposition with u as a quaternion: v are the right singular vectors from 1., they are
+    //reordered together with the singular values
+    template < typename t > inline void compute_us( const matrix3x3<t>& in, quaternion<t>& u, vector3<t>& s, quaternion<t>& v )
+    {
+        using namespace svd::math;
+
+        u = create_quaternion ( splat<t>( 0.0f ), splat<t>( 0.0f ), splat<t>( 0.0f ), splat<t>( 1.0f ) );
+
         //convert quaternion v to matrix {
         auto tmp1 = v.x * v.x;
         auto tmp2 = v.y * v.y;
@@ -641,15 +835,16 @@ namespace svd
         auto rho2 = dot3( a12, a22, a32, a12, a22, a32 );
         auto rho3 = dot3( a13, a23, a33, a13, a23, a33 );
 
-        auto c = rho1 < rho2;
+        auto c = cmp_lt( rho1, rho2 );
 
         // Swap columns 1-2 if necessary
         conditional_swap( c, a11, a12 );
         conditional_swap( c, a21, a22 );
         conditional_swap( c, a31, a32 );
+        conditional_swap( c, rho1, rho2 );
         
         //either -1 or 1
-        auto multiplier = negative_conditional_swap_multiplier( c );
+        auto multiplier = negative_conditional_swap_multiplier<t>( c );
 
         // If columns 1-2 have been swapped, negate 2nd column of A and V so that V is still a rotation
         a12 = a12 * multiplier;
@@ -662,14 +857,15 @@ namespace svd
         auto half = svd::math::splat<t> ( 0.5f );
         conditional_swap<t, 3>( v, multiplier * half - half );
 
-        c = rho1 < rho3;
+        c = cmp_lt( rho1, rho3 );
 
         // Swap columns 1-3 if necessary
         conditional_swap( c, a11, a13 );
         conditional_swap( c, a21, a23 );
         conditional_swap( c, a31, a33 );
+        conditional_swap( c, rho1, rho3 );
 
-        multiplier = negative_conditional_swap_multiplier( c );
+        multiplier = negative_conditional_swap_multiplier<t>( c );
 
         // If columns 1-3 have been swapped, negate 1st column of A and V so that V is still a rotation
         a11 = a11 * multiplier;
@@ -680,14 +876,15 @@ namespace svd
         // do v*vr, where vr= (1, 0, -c, 0) -> this represents column swap as a quaternion, see the paper for more details
         conditional_swap<t, 2>( v, multiplier * half - half );
 
-        c = rho2 < rho3;
+        c = cmp_lt( rho2, rho3 );
 
         // Swap columns 2-3 if necessary
         conditional_swap( c, a12, a13 );
         conditional_swap( c, a22, a23 );
         conditional_swap( c, a32, a33 );
+        conditional_swap( c, rho2, rho3 );
 
-        multiplier = negative_conditional_swap_multiplier( c );
+        multiplier = negative_conditional_swap_multiplier<t>( c );
 
         // If columns 2-3 have been swapped, negate 3rd column of A and V so that V is still a rotation
         a13 = a13 * multiplier;
@@ -712,6 +909,13 @@ namespace svd
         s.z = a33;
     }
 
+    //obtain A = USV' 
+    template < typename t > inline void compute( const matrix3x3<t>& in, quaternion<t>& u, vector3<t>& s, quaternion<t>& v )
+    {
+        compute_v( in, v );
+        compute_us( in, u, s, v );
+    }
+
     template <typename t>
     struct svd_result_quaternion_usv
     {
@@ -727,6 +931,21 @@ namespace svd
         quaternion<t> m_v;
     };
 
+    template <typename t>
+    struct svd_result_eigen
+    {
+        vector3<t>    m_lambda;
+        quaternion<t> m_v;
+    };
+
+    //obtain A = V * diag(lambda) * V' of a symmetric A
+    template < typename t > inline svd_result_eigen<t> eigen_symmetric( const symmetric_matrix3x3<t>& in )
+    {
+        svd_result_eigen<t> r;
+        eigen_symmetric( in, r.m_lambda, r.m_v );
+        return r;
+    }
+
     //obtain A = USV' 
     template < typename t > inline svd_result_quaternion_usv<t> compute_as_quaternion_rusv( const matrix3x3<t>& in )
     {
@@ -782,8 +1001,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -802,14 +1021,14 @@ namespace svd
             auto t22 = a22;
             auto t23 = a23;
 
-            a11 = c * t11 + s * t21;
-            a21 = c * t21 - s * t11;   
+            a11 = madd( c, t11, s * t21 );
+            a21 = nmadd( s, t11, c * t21 );   
 
-            a12 = c * t12 + s * t22;
-            a22 = c * t22 - s * t12;
+            a12 = madd( c, t12, s * t22 );
+            a22 = nmadd( s, t12, c * t22 );
             
-            a13 = c * t13 + s * t23;
-            a23 = c * t23 - s * t13;
+            a13 = madd( c, t13, s * t23 );
+            a23 = nmadd( s, t13, c * t23 );
 
             //u = { { c, -s, 0}, {  s, c, 0}, { 0, 0, 1 } }
             //u1.u
@@ -827,16 +1046,16 @@ namespace svd
             auto k33 = u33;
 
             /*
-            u11 = c * k11 + s * k12;
-            u12 = c * k12 - s * k11;
+            u11 = madd( c, k11, s * k12 );
+            u12 = nmadd( s, k11, c * k12 );
             u13 = k13;
 
-            u21 = c * k21 + s * k22;
-            u22 = c * k22 - s * k21;
+            u21 = madd( c, k21, s * k22 );
+            u22 = nmadd( s, k21, c * k22 );
             u23 = k23;
 
-            u31 = c * k31 + s * k32;
-            u32 = c * k32 - s * k31;
+            u31 = madd( c, k31, s * k32 );
+            u32 = nmadd( s, k31, c * k32 );
             u33 = k33;
             */
 
@@ -860,8 +1079,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -880,14 +1099,14 @@ namespace svd
             auto t22 = a32;
             auto t23 = a33;
 
-            a21 = c * t11 + s * t21;
-            a31 = c * t21 - s * t11;   
+            a21 = madd( c, t11, s * t21 );
+            a31 = nmadd( s, t11, c * t21 );   
 
-            a22 = c * t12 + s * t22;
-            a32 = c * t22 - s * t12;
+            a22 = madd( c, t12, s * t22 );
+            a32 = nmadd( s, t12, c * t22 );
             
-            a23 = c * t13 + s * t23;
-            a33 = c * t23 - s * t13;
+            a23 = madd( c, t13, s * t23 );
+            a33 = nmadd( s, t13, c * t23 );
 
             //u = { { c, -s, 0}, {  s, c, 0}, { 0, 0, 1 } }
             //u1.u
@@ -907,16 +1126,16 @@ namespace svd
             //u = { { 1, 0, 0}, {  0, c, -s}, { 0, s, c } }
             //u1.u
             u11 = k11;
-            u12 = c * k12 + s * k13;
-            u13 = c * k13 - s * k12;
+            u12 = madd( c, k12, s * k13 );
+            u13 = nmadd( s, k12, c * k13 );
 
             u21 = k21;
-            u22 = c * k22 + s * k23;
-            u23 = c * k23 - s * k22;
+            u22 = madd( c, k22, s * k23 );
+            u23 = nmadd( s, k22, c * k23 );
 
             u31 = k31;
-            u32 = c * k32 + s * k33;
-            u33 = c * k33 - s * k32;
+            u32 = madd( c, k32, s * k33 );
+            u33 = nmadd( s, k32, c * k33 );
         }
         else if ( p == 1 && q == 3 )
         {
@@ -924,8 +1143,8 @@ namespace svd
             auto ch = r.m_ch;
             auto sh = r.m_sh;
 
-            auto ch_minus_sh_2 = ch * ch - sh * sh;
-            auto ch_sh_2       = ch * sh + ch * sh;
+            auto ch_minus_sh_2 = nmadd( sh, sh, ch * ch );
+            auto ch_sh_2       = madd( ch, sh, ch * sh );
 
             //Q matrix in the jaocobi method, formed from quaternion
             auto r11 = ch_minus_sh_2;
@@ -944,14 +1163,14 @@ namespace svd
             auto t22 = a32;
             auto t23 = a33;
 
-            a11 = c * t11 + s * t21;
-            a31 = c * t21 - s * t11;   
+            a11 = madd( c, t11, s * t21 );
+            a31 = nmadd( s, t11, c * t21 );   
 
-            a12 = c * t12 + s * t22;
-            a32 = c * t22 - s * t12;
+            a12 = madd( c, t12, s * t22 );
+            a32 = nmadd( s, t12, c * t22 );
             
-            a13 = c * t13 + s * t23;
-            a33 = c * t23 - s * t13;
+            a13 = madd( c, t13, s * t23 );
+            a33 = nmadd( s, t13, c * t23 );
 
 
             //u = { { c, -s, 0}, {  s, c, 0}, { 0, 0, 1 } }
@@ -974,17 +1193,17 @@ namespace svd
             //u1.u
 
             /*
-            u11 = c * k11 + s * k13;
+            u11 = madd( c, k11, s * k13 );
             u12 = k12;
-            u13 = c * k13 - s * k11;
+            u13 = nmadd( s, k11, c * k13 );
 
-            u21 = c * k21 + s * k23;
+            u21 = madd( c, k21, s * k23 );
             u22 = k22;
-            u23 = c * k23 - s * k21;
+            u23 = nmadd( s, k21, c * k23 );
 
-            u31 = c * k31 + s * k33;
+            u31 = madd( c, k31, s * k33 );
             u32 = k32;
-            u33 = c * k33 - s * k31;
+            u33 = nmadd( s, k31, c * k33 );
             */
 
             //explore the special structure from the previous iteration
@@ -1003,48 +1222,11 @@ namespace svd
         }
     }
 
-    //obtain A = USV' 
-    template < typename t > inline void compute( const matrix3x3<t>& in, matrix3x3<t>& uu, vector3<t>& s, matrix3x3<t>& vv )
+    //rotation matrix of the unit quaternion v
+    template < typename t > inline matrix3x3<t> create_rotation_matrix( const quaternion<t>& v )
     {
         using namespace svd::math;
 
-        // initial value of v as a quaternion
-        auto vx = splat<t>( 0.0f );
-        auto vy = splat<t>( 0.0f );
-        auto vz = splat<t>( 0.0f );
-        auto vw = splat<t>( 1.0f );
-
-        auto u = create_quaternion ( vx, vy, vz, vw );
-        auto v = create_quaternion ( vx, vy, vz, vw );
-
-        auto m = create_symmetric_matrix( in );
-
-        uu.a11 = splat<t>(1.0f);
-        uu.a12 = splat<t>(0.0f);
-        uu.a13 = splat<t>(0.0f);
-
-        uu.a21 = splat<t>(0.0f);
-        uu.a22 = splat<t>(1.0f);
-        uu.a23 = splat<t>(0.0f);
-
-        uu.a31 = splat<t>(0.0f);
-        uu.a32 = splat<t>(0.0f);
-        uu.a33 = splat<t>(1.0f);
-        
-        //1. Compute the V matrix as a quaternion
-
-        //4 iterations of jacobi conjugation to obtain V
-        for (auto i = 0; i < 4 ; ++i)
-        {
-            svd::jacobi_conjugation< t, 1, 2 > ( m, v );
-            svd::jacobi_conjugation< t, 2, 3 > ( m, v );
-            svd::jacobi_conjugation< t, 1, 3 > ( m, v );
-        }
-
-        //normalize the quaternion. this is optional
-        normalize<t>(v);
-
-        //convert quaternion v to matrix {
         auto tmp1 = v.x * v.x;
         auto tmp2 = v.y * v.y;
         auto tmp3 = v.z * v.z;
@@ -1081,7 +1263,41 @@ namespace svd
         v21 = v21 + tmp1;
         v32 = v32 + tmp2;
         v13 = v13 + tmp3;
-        //} convert quaternion to matrix
+
+        return create_matrix( v11, v12, v13, v21, v22, v23, v31, v32, v33 );
+    }
+
+    //2. and 3. of the decomposition: v are the right singular vectors as a unit quaternion.
+    //sorts the singular values and factors AV = US
+    template < typename t > inline void compute_usv( const matrix3x3<t>& in, const quaternion<t>& v, matrix3x3<t>& uu, vector3<t>& s, matrix3x3<t>& vv )
+    {
+        using namespace svd::math;
+
+        uu.a11 = splat<t>(1.0f);
+        uu.a12 = splat<t>(0.0f);
+        uu.a13 = splat<t>(0.0f);
+
+        uu.a21 = splat<t>(0.0f);
+        uu.a22 = splat<t>(1.0f);
+        uu.a23 = splat<t>(0.0f);
+
+        uu.a31 = splat<t>(0.0f);
+        uu.a32 = splat<t>(0.0f);
+        uu.a33 = splat<t>(1.0f);
+
+        auto r   = create_rotation_matrix( v );
+
+        auto v11 = r.a11;
+        auto v12 = r.a12;
+        auto v13 = r.a13;
+
+        auto v21 = r.a21;
+        auto v22 = r.a22;
+        auto v23 = r.a23;
+
+        auto v31 = r.a31;
+        auto v32 = r.a32;
+        auto v33 = r.a33;
 
         // compute AV
 
@@ -1104,19 +1320,20 @@ namespace svd
         auto rho2 = dot3( a12, a22, a32, a12, a22, a32 );
         auto rho3 = dot3( a13, a23, a33, a13, a23, a33 );
 
-        auto c = rho1 < rho2;
+        auto c = cmp_lt( rho1, rho2 );
 
         // Swap columns 1-2 if necessary
         conditional_swap( c, a11, a12 );
         conditional_swap( c, a21, a22 );
         conditional_swap( c, a31, a32 );
+        conditional_swap( c, rho1, rho2 );
 
         conditional_swap( c, v11, v12 );
         conditional_swap( c, v21, v22 );
         conditional_swap( c, v31, v32 );
 
         //either -1 or 1
-        auto multiplier = negative_conditional_swap_multiplier( c );
+        auto multiplier = negative_conditional_swap_multiplier<t>( c );
 
         // If columns 1-2 have been swapped, negate 2nd column of A and V so that V is still a rotation
         a12 = a12 * multiplier;
@@ -1127,19 +1344,20 @@ namespace svd
         v22 = v22 * multiplier;
         v32 = v32 * multiplier;
 
-        c = rho1 < rho3;
+        c = cmp_lt( rho1, rho3 );
 
         // Swap columns 1-3 if necessary
         conditional_swap( c, a11, a13 );
         conditional_swap( c, a21, a23 );
         conditional_swap( c, a31, a33 );
+        conditional_swap( c, rho1, rho3 );
 
         conditional_swap( c, v11, v13 );
         conditional_swap( c, v21, v23 );
         conditional_swap( c, v31, v33 );
 
 
-        multiplier = negative_conditional_swap_multiplier( c );
+        multiplier = negative_conditional_swap_multiplier<t>( c );
 
         // If columns 1-3 have been swapped, negate 1st column of A and V so that V is still a rotation
         a11 = a11 * multiplier;
@@ -1150,19 +1368,20 @@ namespace svd
         v21 = v21 * multiplier;
         v31 = v31 * multiplier;
 
-        c = rho2 < rho3;
+        c = cmp_lt( rho2, rho3 );
 
         // Swap columns 2-3 if necessary
         conditional_swap( c, a12, a13 );
         conditional_swap( c, a22, a23 );
         conditional_swap( c, a32, a33 );
+        conditional_swap( c, rho2, rho3 );
 
         conditional_swap( c, v12, v13 );
         conditional_swap( c, v22, v23 );
         conditional_swap( c, v32, v33 );
 
 
-        multiplier = negative_conditional_swap_multiplier( c );
+        multiplier = negative_conditional_swap_multiplier<t>( c );
 
         // If columns 2-3 have been swapped, negate 3rd column of A and V so that V is still a rotation
         a13 = a13 * multiplier;
@@ -1195,6 +1414,56 @@ namespace svd
         vv.a33 = v33;
     }
 
+    //obtain A = USV' 
+    template < typename t > inline void compute( const matrix3x3<t>& in, matrix3x3<t>& uu, vector3<t>& s, matrix3x3<t>& vv )
+    {
+        quaternion<t> v;
+
+        compute_v( in, v );
+        compute_usv( in, v, uu, s, vv );
+    }
+
+    //obtain A = USV' with at most jacobi_sweeps<t>::value sweeps. the sweeps stop when every lane has converged to the tolerance,
+    //which pays off for near diagonal A'A (e.g. near identity A), where most sweeps only apply tiny rotations. on avx at a
+    //tolerance of 1e-6, I+E with |E| up to 1e-3 runs 3.6 sweeps 1.09x faster, up to 1e-4 3.2 sweeps 1.2x faster, up to
+    //1e-1 it is 2% slower. returns the number of sweeps that ran
+    template < typename t > inline int32_t compute_adaptive( const matrix3x3<t>& in, matrix3x3<t>& uu, vector3<t>& s, matrix3x3<t>& vv, float tolerance )
+    {
+        quaternion<t> v;
+
+        auto sweeps = compute_v( in, v, tolerance );
+        compute_usv( in, v, uu, s, vv );
+
+        return sweeps;
+    }
+
+    //mixed precision: the jacobi sweeps run on the float number f, refine_v on the double number t converges from that v in a
+    //few sweeps, and the sorting and the qr factorization run in t. f and t must have the same number of lanes (cpu_scalar and
+    //cpu_scalar_double, sse_vector and avx_vector_double)
+    template < typename f, typename t > inline void compute_mixed( const matrix3x3<t>& in, matrix3x3<t>& uu, vector3<t>& s, matrix3x3<t>& vv )
+    {
+        using namespace svd::math;
+
+        auto in_f = create_matrix
+            (
+                convert<f>( in.a11 ), convert<f>( in.a12 ), convert<f>( in.a13 ),
+                convert<f>( in.a21 ), convert<f>( in.a22 ), convert<f>( in.a23 ),
+                convert<f>( in.a31 ), convert<f>( in.a32 ), convert<f>( in.a33 )
+            );
+
+        auto v_f = create_quaternion( splat<f>( 0.0f ), splat<f>( 0.0f ), splat<f>( 0.0f ), splat<f>( 1.0f ) );
+        auto m_f = create_symmetric_matrix( in_f );
+
+        jacobi_sweep( m_f, v_f, 0.0f );
+
+        auto v = create_quaternion( convert<t>( v_f.x ), convert<t>( v_f.y ), convert<t>( v_f.z ), convert<t>( v_f.w ) );
+        normalize<t>( v );
+
+        refine_v( in, v );
+
+        compute_usv( in, v, uu, s, vv );
+    }
+
     template <typename t>
     struct svd_result_matrix_usv
     {
@@ -0,0 +1,763 @@
+#ifndef __svd_svd_batch_h__
+#define __svd_svd_batch_h__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "svd_types.h"
+#include "svd_math.h"
+#include "svd.h"
+#include "svd_cpu.h"
+#include "svd_polar.h"
+#include "svd_rotation.h"
+
+namespace svd
+{
+    //a[ k * n + i ] (soa, planes) or a[ i * 9 + k ] (aos, matrix after matrix) is the element k (row major) of the matrix i.
+    //s has 3 elements per matrix in the same layout
+    enum layout
+    {
+        layout_soa,
+        layout_aos
+    };
+
+    namespace details
+    {
+        //floats of the number t. from the size, so the raw vector types (sse_vector, avx_vector) are not template arguments
+        //of a specialization, which drops their alignment attributes
+        template <typename t> struct lanes
+        {
+            static const size_t value = sizeof( t ) / sizeof( float );
+        };
+
+        static const size_t max_lanes = 16;
+
+        //matrices per thread below which more threads do not pay off
+        static const size_t thread_grain = 4096;
+
+        //outputs above this size do not stay in the cache, so they are written with non temporal stores
+        static const size_t streaming_bytes = 16 * 1024 * 1024;
+
+        inline void write( float* destination, const float* source, size_t count, bool streaming )
+        {
+            size_t i = 0;
+
+            if ( streaming && ( reinterpret_cast<uintptr_t> ( destination ) & 15 ) == 0 )
+            {
+                for ( ; i + 4 <= count; i += 4 )
+                {
+                    _mm_stream_ps( destination + i, _mm_loadu_ps( source + i ) );
+                }
+            }
+
+            for ( ; i < count; ++i )
+            {
+                destination[i] = source[i];
+            }
+        }
+
+        //writes count lanes of a tile of planes (plane k at tile[ k * w ]) to the output of the matrices i .. i + count
+        inline void write_tile( float* destination, size_t n, size_t i, size_t count, layout l, bool streaming, const float* tile, size_t planes, size_t w, float* scratch )
+        {
+            if ( l == layout_soa )
+            {
+                for ( size_t k = 0; k < planes; ++k )
+                {
+                    write( destination + k * n + i, tile + k * w, count, streaming );
+                }
+            }
+            else
+            {
+                //transpose the tile to matrix after matrix and write it as one run
+                for ( size_t j = 0; j < count; ++j )
+                {
+                    for ( size_t k = 0; k < planes; ++k )
+                    {
+                        scratch[ j * planes + k ] = tile[ k * w + j ];
+                    }
+                }
+
+                write( destination + i * planes, scratch, count * planes, streaming );
+            }
+        }
+
+        //the lanes past count are masked: they decompose the identity and are not written back
+        template <typename t> inline matrix3x3<t> read_tile( const float* a, size_t n, size_t i, size_t count, layout l, float* scratch )
+        {
+            using namespace svd::math;
+
+            const size_t w = lanes<t>::value;
+
+            matrix3x3<t> m;
+            t* mm = &m.a11;
+
+            if ( l == layout_soa && count == w )
+            {
+                for ( size_t k = 0; k < 9; ++k )
+                {
+                    mm[k] = load<t>( a + k * n + i );
+                }
+            }
+            else
+            {
+                for ( size_t k = 0; k < 9; ++k )
+                {
+                    const float identity = ( k % 4 == 0 ) ? 1.0f : 0.0f;
+
+                    for ( size_t j = 0; j < w; ++j )
+                    {
+                        scratch[ k * w + j ] = j < count ? ( l == layout_soa ? a[ k * n + i + j ] : a[ ( i + j ) * 9 + k ] ) : identity;
+                    }
+
+                    mm[k] = load<t>( scratch + k * w );
+                }
+            }
+
+            return m;
+        }
+
+        //symmetric matrices have the 6 elements a11, a21, a22, a31, a32, a33 (see symmetric_matrix3x3), the masked lanes are the identity
+        template <typename t> inline symmetric_matrix3x3<t> read_symmetric_tile( const float* a, size_t n, size_t i, size_t count, layout l, float* scratch )
+        {
+            using namespace svd::math;
+
+            const size_t w = lanes<t>::value;
+
+            symmetric_matrix3x3<t> m;
+            t* mm = &m.a11;
+
+            if ( l == layout_soa && count == w )
+            {
+                for ( size_t k = 0; k < 6; ++k )
+                {
+                    mm[k] = load<t>( a + k * n + i );
+                }
+            }
+            else
+            {
+                for ( size_t k = 0; k < 6; ++k )
+                {
+                    const float identity = ( k == 0 || k == 2 || k == 5 ) ? 1.0f : 0.0f;
+
+                    for ( size_t j = 0; j < w; ++j )
+                    {
+                        scratch[ k * w + j ] = j < count ? ( l == layout_soa ? a[ k * n + i + j ] : a[ ( i + j ) * 6 + k ] ) : identity;
+                    }
+
+                    mm[k] = load<t>( scratch + k * w );
+                }
+            }
+
+            return m;
+        }
+
+        //a = u * diag(s) * transpose(v)
+        struct usv_kernel
+        {
+            const float* m_a;
+            float* m_u;
+            float* m_s;
+            float* m_v;
+
+            static const size_t output_floats = 21;
+
+            template <typename t> void compute_tile( size_t n, size_t i, size_t count, layout l, bool streaming, float* tile, float* scratch ) const
+            {
+                using namespace svd::math;
+
+                const size_t w = lanes<t>::value;
+
+                const matrix3x3<t> m = read_tile<t>( m_a, n, i, count, l, scratch );
+
+                matrix3x3<t> mu;
+                vector3<t>   ms;
+                matrix3x3<t> mv;
+
+                compute( m, mu, ms, mv );
+
+                const t* ru = &mu.a11;
+                const t* rs = &ms.x;
+                const t* rv = &mv.a11;
+
+                for ( size_t k = 0; k < 9; ++k )
+                {
+                    store( tile + k * w, ru[k] );
+                    store( tile + ( 12 + k ) * w, rv[k] );
+                }
+
+                for ( size_t k = 0; k < 3; ++k )
+                {
+                    store( tile + ( 9 + k ) * w, rs[k] );
+                }
+
+                write_tile( m_u, n, i, count, l, streaming, tile, 9, w, scratch );
+                write_tile( m_s, n, i, count, l, streaming, tile + 9 * w, 3, w, scratch );
+                write_tile( m_v, n, i, count, l, streaming, tile + 12 * w, 9, w, scratch );
+            }
+        };
+
+        //a = r * s, r is a rotation, s is symmetric. r only when m_s is null
+        struct polar_kernel
+        {
+            const float* m_a;
+            float*       m_r;
+            float*       m_s;
+            polar_method m_method;
+            float        m_tolerance;
+
+            static const size_t output_floats = 18;
+
+            template <typename t> void compute_tile( size_t n, size_t i, size_t count, layout l, bool streaming, float* tile, float* scratch ) const
+            {
+                using namespace svd::math;
+
+                const size_t w = lanes<t>::value;
+
+                const matrix3x3<t> m = read_tile<t>( m_a, n, i, count, l, scratch );
+
+                matrix3x3<t> mr;
+                matrix3x3<t> ms;
+
+                mr = rotation_only( m, m_method, m_tolerance );
+
+                if ( m_s != nullptr )
+                {
+                    ms = polar_symmetric( m, mr );
+                }
+
+                const t* rr = &mr.a11;
+                const t* rs = &ms.a11;
+
+                for ( size_t k = 0; k < 9; ++k )
+                {
+                    store( tile + k * w, rr[k] );
+                }
+
+                write_tile( m_r, n, i, count, l, streaming, tile, 9, w, scratch );
+
+                if ( m_s != nullptr )
+                {
+                    for ( size_t k = 0; k < 9; ++k )
+                    {
+                        store( tile + ( 9 + k ) * w, rs[k] );
+                    }
+
+                    write_tile( m_s, n, i, count, l, streaming, tile + 9 * w, 9, w, scratch );
+                }
+            }
+        };
+
+        //a = v * diag(lambda) * transpose(v) of symmetric a, v as a unit quaternion
+        struct eigen_kernel
+        {
+            const float* m_a;
+            float*       m_lambda;
+            float*       m_v;
+            float        m_tolerance;
+
+            static const size_t output_floats = 7;
+
+            template <typename t> void compute_tile( size_t n, size_t i, size_t count, layout l, bool streaming, float* tile, float* scratch ) const
+            {
+                using namespace svd::math;
+
+                const size_t w = lanes<t>::value;
+
+                const symmetric_matrix3x3<t> m = read_symmetric_tile<t>( m_a, n, i, count, l, scratch );
+
+                vector3<t>    mlambda;
+                quaternion<t> mv;
+
+                eigen_symmetric( m, mlambda, mv, m_tolerance );
+
+                const t* rl = &mlambda.x;
+                const t* rv = &mv.x;
+
+                for ( size_t k = 0; k < 3; ++k )
+                {
+                    store( tile + k * w, rl[k] );
+                }
+
+                for ( size_t k = 0; k < 4; ++k )
+                {
+                    store( tile + ( 3 + k ) * w, rv[k] );
+                }
+
+                write_tile( m_lambda, n, i, count, l, streaming, tile, 3, w, scratch );
+                write_tile( m_v, n, i, count, l, streaming, tile + 3 * w, 4, w, scratch );
+            }
+        };
+
+        //rigid transforms q = r * p + t of clusters of point pairs, one lane per cluster
+        struct rigid_kernel
+        {
+            const float*    m_p;
+            const float*    m_q;
+            const float*    m_w;
+            const uint32_t* m_offsets;
+            const uint32_t* m_indices;
+            float*          m_r;
+            float*          m_t;
+            polar_method    m_method;
+
+            static const size_t output_floats = 12;
+
+            //pair j of the cluster c
+            size_t pair( size_t c, size_t j ) const
+            {
+                const size_t k = m_offsets[c] + j;
+                return m_indices != nullptr ? m_indices[k] : k;
+            }
+
+            //pair j of the clusters i .. i + count, the lanes past the end of their cluster get zero weight
+            template <typename t> void gather( size_t i, size_t count, size_t j, float* scratch, vector3<t>& p, vector3<t>& q, t& w ) const
+            {
+                using namespace svd::math;
+
+                const size_t lanes_count = lanes<t>::value;
+
+                for ( size_t l = 0; l < lanes_count; ++l )
+                {
+                    const bool active = l < count && m_offsets[ i + l ] + j < m_offsets[ i + l + 1 ];
+                    const size_t k    = active ? pair( i + l, j ) : 0;
+
+                    for ( size_t c = 0; c < 3; ++c )
+                    {
+                        scratch[ c * lanes_count + l ]         = active ? m_p[ k * 3 + c ] : 0.0f;
+                        scratch[ ( 3 + c ) * lanes_count + l ] = active ? m_q[ k * 3 + c ] : 0.0f;
+                    }
+
+                    scratch[ 6 * lanes_count + l ] = active ? ( m_w != nullptr ? m_w[k] : 1.0f ) : 0.0f;
+                }
+
+                p.x = load<t>( scratch );
+                p.y = load<t>( scratch + lanes_count );
+                p.z = load<t>( scratch + 2 * lanes_count );
+                q.x = load<t>( scratch + 3 * lanes_count );
+                q.y = load<t>( scratch + 4 * lanes_count );
+                q.z = load<t>( scratch + 5 * lanes_count );
+                w   = load<t>( scratch + 6 * lanes_count );
+            }
+
+            template <typename t> void compute_tile( size_t n, size_t i, size_t count, layout l, bool streaming, float* tile, float* scratch ) const
+            {
+                using namespace svd::math;
+
+                const size_t w = lanes<t>::value;
+
+                size_t steps = 0;
+
+                for ( size_t c = i; c < i + count; ++c )
+                {
+                    steps = std::max<size_t>( steps, m_offsets[ c + 1 ] - m_offsets[c] );
+                }
+
+                vector3<t> p;
+                vector3<t> q;
+                t          pw;
+
+                gather( i, count, 0, scratch, p, q, pw );
+
+                auto a = make_rigid_accumulator( p, q );
+
+                accumulate( a, p, q, pw );
+
+                for ( size_t j = 1; j < steps; ++j )
+                {
+                    gather( i, count, j, scratch, p, q, pw );
+                    accumulate( a, p, q, pw );
+                }
+
+                matrix3x3<t> r;
+                vector3<t>   tr;
+
+                solve( a, r, tr, m_method );
+
+                const t* rr = &r.a11;
+                const t* rt = &tr.x;
+
+                for ( size_t k = 0; k < 9; ++k )
+                {
+                    store( tile + k * w, rr[k] );
+                }
+
+                for ( size_t k = 0; k < 3; ++k )
+                {
+                    store( tile + ( 9 + k ) * w, rt[k] );
+                }
+
+                write_tile( m_r, n, i, count, l, streaming, tile, 9, w, scratch );
+                write_tile( m_t, n, i, count, l, streaming, tile + 9 * w, 3, w, scratch );
+            }
+        };
+
+        template <typename t> inline float sum_lanes( t v )
+        {
+            float f[ max_lanes ];
+            math::store( f, v );
+
+            float r = 0.0f;
+
+            for ( size_t i = 0; i < lanes<t>::value; ++i )
+            {
+                r += f[i];
+            }
+
+            return r;
+        }
+
+        //sums of the pairs of one set, the pairs are spread over the lanes. p0, q0 is the first pair
+        template <typename t> inline rigid_accumulator<cpu_scalar> accumulate_pairs( const float* p, const float* q, const float* w, size_t n )
+        {
+            using namespace svd::math;
+
+            const size_t lanes_count = lanes<t>::value;
+
+            vector3<t> p0;
+            vector3<t> q0;
+
+            p0.x = splat<t>( p[0] ); p0.y = splat<t>( p[1] ); p0.z = splat<t>( p[2] );
+            q0.x = splat<t>( q[0] ); q0.y = splat<t>( q[1] ); q0.z = splat<t>( q[2] );
+
+            auto a = make_rigid_accumulator( p0, q0 );
+
+            float scratch[ 7 * max_lanes ];
+
+            for ( size_t i = 0; i < n; i += lanes_count )
+            {
+                const size_t count = std::min( lanes_count, n - i );
+
+                for ( size_t l = 0; l < lanes_count; ++l )
+                {
+                    const bool   active = l < count;
+                    const size_t k      = active ? i + l : 0;
+
+                    for ( size_t c = 0; c < 3; ++c )
+                    {
+                        scratch[ c * lanes_count + l ]         = p[ k * 3 + c ];
+                        scratch[ ( 3 + c ) * lanes_count + l ] = q[ k * 3 + c ];
+                    }
+
+                    scratch[ 6 * lanes_count + l ] = active ? ( w != nullptr ? w[k] : 1.0f ) : 0.0f;
+                }
+
+                vector3<t> pp;
+                vector3<t> qq;
+
+                pp.x = load<t>( scratch );
+                pp.y = load<t>( scratch + lanes_count );
+                pp.z = load<t>( scratch + 2 * lanes_count );
+                qq.x = load<t>( scratch + 3 * lanes_count );
+                qq.y = load<t>( scratch + 4 * lanes_count );
+                qq.z = load<t>( scratch + 5 * lanes_count );
+
+                accumulate( a, pp, qq, load<t>( scratch + 6 * lanes_count ) );
+            }
+
+            //fold the lanes, they share the reference pair
+            rigid_accumulator<cpu_scalar> r;
+
+            const t*    source      = &a.m_p0.x;
+            cpu_scalar* destination = &r.m_p0.x;
+
+            r.m_p0.x = make_cpu_scalar( p[0] ); r.m_p0.y = make_cpu_scalar( p[1] ); r.m_p0.z = make_cpu_scalar( p[2] );
+            r.m_q0.x = make_cpu_scalar( q[0] ); r.m_q0.y = make_cpu_scalar( q[1] ); r.m_q0.z = make_cpu_scalar( q[2] );
+
+            //m_w, m_p, m_q and m_m follow the reference pair
+            for ( size_t k = 6; k < 22; ++k )
+            {
+                destination[k] = make_cpu_scalar( sum_lanes( source[k] ) );
+            }
+
+            return r;
+        }
+
+        //a kernel reads the input of count <= lanes items starting at i and writes their results, see usv_kernel
+        template <typename t, typename kernel> inline void run_batch( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k )
+        {
+            const size_t w = lanes<t>::value;
+
+            float tile    [ 21 * w ];
+            float scratch [ 9 * w ];
+
+            for ( size_t i = begin; i < end; i += w )
+            {
+                const size_t count = std::min( w, end - i );
+                k.template compute_tile<t>( n, i, count, l, streaming, tile, scratch );
+            }
+
+            if ( streaming )
+            {
+                //non temporal stores are weakly ordered, make them visible before the thread reports completion
+                _mm_sfence();
+            }
+        }
+
+        //the backends wider than sse. with SVD_BATCH_KERNEL_OBJECTS defined they are compiled in objects of their own (see
+        //svd_batch_kernels.h) and the rest of the program is built for the baseline, so every processor runs it and the batches
+        //use the widest set it supports. otherwise they are compiled in every translation unit built for their set
+        #if defined(SVD_BATCH_KERNEL_OBJECTS)
+        template <typename kernel> void run_batch_avx( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k );
+        template <typename kernel> void run_batch_avx2( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k );
+        template <typename kernel> void run_batch_avx512( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k );
+
+        rigid_accumulator<cpu_scalar> accumulate_pairs_avx( const float* p, const float* q, const float* w, size_t n );
+        rigid_accumulator<cpu_scalar> accumulate_pairs_avx2( const float* p, const float* q, const float* w, size_t n );
+        rigid_accumulator<cpu_scalar> accumulate_pairs_avx512( const float* p, const float* q, const float* w, size_t n );
+
+        #define SVD_BATCH_AVX
+        #define SVD_BATCH_AVX2
+        #define SVD_BATCH_AVX512
+        #else
+        #if defined(SVD_MATH_AVX)
+        template <typename kernel> inline void run_batch_avx( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k )
+        {
+            run_batch<avx_vector>( n, begin, end, l, streaming, k );
+        }
+
+        inline rigid_accumulator<cpu_scalar> accumulate_pairs_avx( const float* p, const float* q, const float* w, size_t n )
+        {
+            return accumulate_pairs<avx_vector>( p, q, w, n );
+        }
+
+        #define SVD_BATCH_AVX
+        #endif
+
+        #if defined(SVD_MATH_AVX2)
+        template <typename kernel> inline void run_batch_avx2( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k )
+        {
+            run_batch<avx2_vector>( n, begin, end, l, streaming, k );
+        }
+
+        inline rigid_accumulator<cpu_scalar> accumulate_pairs_avx2( const float* p, const float* q, const float* w, size_t n )
+        {
+            return accumulate_pairs<avx2_vector>( p, q, w, n );
+        }
+
+        #define SVD_BATCH_AVX2
+        #endif
+
+        #if defined(SVD_MATH_AVX512)
+        template <typename kernel> inline void run_batch_avx512( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k )
+        {
+            run_batch<avx512_vector>( n, begin, end, l, streaming, k );
+        }
+
+        inline rigid_accumulator<cpu_scalar> accumulate_pairs_avx512( const float* p, const float* q, const float* w, size_t n )
+        {
+            return accumulate_pairs<avx512_vector>( p, q, w, n );
+        }
+
+        #define SVD_BATCH_AVX512
+        #endif
+        #endif
+
+        template <typename kernel> inline void run_batch( cpu::instruction_set set, size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k )
+        {
+            switch ( set )
+            {
+                #if defined(SVD_BATCH_AVX512)
+                case cpu::instruction_set_avx512:
+                    run_batch_avx512( n, begin, end, l, streaming, k );
+                    break;
+                #endif
+
+                #if defined(SVD_BATCH_AVX2)
+                case cpu::instruction_set_avx2:
+                    run_batch_avx2( n, begin, end, l, streaming, k );
+                    break;
+                #endif
+
+                #if defined(SVD_BATCH_AVX)
+                case cpu::instruction_set_avx:
+                    run_batch_avx( n, begin, end, l, streaming, k );
+                    break;
+                #endif
+
+                case cpu::instruction_set_sse:
+                    run_batch<sse_vector>( n, begin, end, l, streaming, k );
+                    break;
+
+                default:
+                    run_batch<cpu_scalar>( n, begin, end, l, streaming, k );
+                    break;
+            }
+        }
+
+        //spreads blocks of the batch over thread_count threads (0 picks the hardware concurrency). blocks are split on
+        //multiples of 16 matrices, so only the last tile of the batch is partially masked
+        template <typename kernel> inline void run_batch( size_t n, layout l, uint32_t thread_count, cpu::instruction_set set, const kernel& k )
+        {
+            const bool streaming = n * kernel::output_floats * sizeof(float) >= streaming_bytes;
+
+            size_t threads = thread_count != 0 ? thread_count : std::max( std::thread::hardware_concurrency(), 1u );
+            threads = std::max<size_t>( std::min( threads, n / thread_grain ), 1 );
+
+            if ( threads == 1 )
+            {
+                run_batch( set, n, 0, n, l, streaming, k );
+                return;
+            }
+
+            const size_t tiles = ( n + max_lanes - 1 ) / max_lanes;
+
+            std::vector<std::thread> workers;
+            workers.reserve( threads - 1 );
+
+            for ( size_t i = 1; i < threads; ++i )
+            {
+                const size_t begin = std::min( ( tiles * i / threads ) * max_lanes, n );
+                const size_t end   = std::min( ( tiles * ( i + 1 ) / threads ) * max_lanes, n );
+
+                workers.push_back( std::thread( [=]
+                {
+                    run_batch( set, n, begin, end, l, streaming, k );
+                }));
+            }
+
+            run_batch( set, n, 0, std::min( ( tiles / threads ) * max_lanes, n ), l, streaming, k );
+
+            for ( auto& w : workers )
+            {
+                w.join();
+            }
+        }
+    }
+
+    //widest backend that is both compiled in (all of them with SVD_BATCH_KERNEL_OBJECTS) and supported by the processor
+    inline cpu::instruction_set batch_instruction_set()
+    {
+        const cpu::instruction_set supported = cpu::supported_instruction_set();
+
+        #if defined(SVD_BATCH_AVX512)
+        if ( supported >= cpu::instruction_set_avx512 )
+        {
+            return cpu::instruction_set_avx512;
+        }
+        #endif
+
+        #if defined(SVD_BATCH_AVX2)
+        if ( supported >= cpu::instruction_set_avx2 )
+        {
+            return cpu::instruction_set_avx2;
+        }
+        #endif
+
+        #if defined(SVD_BATCH_AVX)
+        if ( supported >= cpu::instruction_set_avx )
+        {
+            return cpu::instruction_set_avx;
+        }
+        #endif
+
+        return supported >= cpu::instruction_set_sse ? cpu::instruction_set_sse : cpu::instruction_set_scalar;
+    }
+
+    //decomposes n matrices, a = u * diag(s) * transpose(v), with the widest supported backend on thread_count threads
+    //(0 picks the hardware concurrency)
+    inline void compute_batch( const float* a, size_t n, float* u, float* s, float* v, layout l = layout_soa, uint32_t thread_count = 0, cpu::instruction_set set = batch_instruction_set() )
+    {
+        const details::usv_kernel k = { a, u, s, v };
+        details::run_batch( n, l, thread_count, set, k );
+    }
+
+    //compute_batch on the calling thread with non temporal stores whatever the size of the batch, for drivers that walk
+    //a large input in chunks and keep the outputs of the chunks out of the cache. 16 byte aligned outputs are streamed
+    inline void compute_batch_streaming( const float* a, size_t n, float* u, float* s, float* v, layout l = layout_soa, cpu::instruction_set set = batch_instruction_set() )
+    {
+        const details::usv_kernel k = { a, u, s, v };
+        details::run_batch( set, n, 0, n, l, true, k );
+    }
+
+    //polar decompositions a = r * s of n matrices, r has 9 and the symmetric s has 9 elements per matrix in the layout of a.
+    //the tolerance stops the jacobi sweeps (polar_method_svd, 0 runs all of them) or the newton iteration (polar_method_newton, 0 runs all
+    //of them, polar_method_newton_svd, 0 picks 1e-6) early
+    inline void polar_batch( const float* a, size_t n, float* r, float* s, layout l = layout_soa, polar_method method = polar_method_newton_svd, float tolerance = 0.0f, uint32_t thread_count = 0, cpu::instruction_set set = batch_instruction_set() )
+    {
+        const details::polar_kernel k = { a, r, s, method, tolerance };
+        details::run_batch( n, l, thread_count, set, k );
+    }
+
+    //rotations r of the polar decompositions of n matrices
+    inline void rotation_batch( const float* a, size_t n, float* r, layout l = layout_soa, polar_method method = polar_method_newton_svd, float tolerance = 0.0f, uint32_t thread_count = 0, cpu::instruction_set set = batch_instruction_set() )
+    {
+        const details::polar_kernel k = { a, r, nullptr, method, tolerance };
+        details::run_batch( n, l, thread_count, set, k );
+    }
+
+    //eigenvalues (3 per matrix, descending) and eigenvectors (unit quaternions x, y, z, w, 4 per matrix) of n symmetric matrices with
+    //6 elements a11, a21, a22, a31, a32, a33 per matrix in the layout l. the last column of the rotation matrix of v is the eigenvector of
+    //the smallest eigenvalue (normal estimation). the tolerance stops the jacobi sweeps early, 0 runs all of them
+    inline void eigen_symmetric_batch( const float* a, size_t n, float* lambda, float* v, layout l = layout_soa, float tolerance = 0.0f, uint32_t thread_count = 0, cpu::instruction_set set = batch_instruction_set() )
+    {
+        const details::eigen_kernel k = { a, lambda, v, tolerance };
+        details::run_batch( n, l, thread_count, set, k );
+    }
+
+    //rigid transforms q = r * p + t of clusters of weighted point pairs in least squares sense, one lane per cluster (shape matching).
+    //p and q are xyz triples. the cluster c is the pairs offsets[c] .. offsets[c + 1] - 1, or the pairs indices[ offsets[c] ] ..
+    //when indices is not null, for clusters that share points. w is null for unit weights. r has 9 and t 3 elements per cluster
+    inline void rigid_transform_batch( const float* p, const float* q, const float* w, const uint32_t* offsets, const uint32_t* indices, size_t clusters, float* r, float* t, layout l = layout_soa, polar_method method = polar_method_svd, uint32_t thread_count = 0, cpu::instruction_set set = batch_instruction_set() )
+    {
+        const details::rigid_kernel k = { p, q, w, offsets, indices, r, t, method };
+        details::run_batch( clusters, l, thread_count, set, k );
+    }
+
+    //rigid transform q = r * p + t of one set of n > 0 weighted point pairs (icp), the pairs are spread over the lanes
+    inline void rigid_transform( const float* p, const float* q, const float* w, size_t n, float* r, float* t, polar_method method = polar_method_svd, cpu::instruction_set set = batch_instruction_set() )
+    {
+        rigid_accumulator<cpu_scalar> a;
+
+        switch ( set )
+        {
+            #if defined(SVD_BATCH_AVX512)
+            case cpu::instruction_set_avx512:
+                a = details::accumulate_pairs_avx512( p, q, w, n );
+                break;
+            #endif
+
+            #if defined(SVD_BATCH_AVX2)
+            case cpu::instruction_set_avx2:
+                a = details::accumulate_pairs_avx2( p, q, w, n );
+                break;
+            #endif
+
+            #if defined(SVD_BATCH_AVX)
+            case cpu::instruction_set_avx:
+                a = details::accumulate_pairs_avx( p, q, w, n );
+                break;
+            #endif
+
+            case cpu::instruction_set_sse:
+                a = details::accumulate_pairs<sse_vector>( p, q, w, n );
+                break;
+
+            default:
+                a = details::accumulate_pairs<cpu_scalar>( p, q, w, n );
+                break;
+        }
+
+        matrix3x3<cpu_scalar> mr;
+        vector3<cpu_scalar>   mt;
+
+        solve( a, mr, mt, method );
+
+        const cpu_scalar* rr = &mr.a11;
+        const cpu_scalar* rt = &mt.x;
+
+        for ( size_t k = 0; k < 9; ++k )
+        {
+            r[k] = rr[k].f;
+        }
+
+        for ( size_t k = 0; k < 3; ++k )
+        {
+            t[k] = rt[k].f;
+        }
+    }
+}
+
+#endif
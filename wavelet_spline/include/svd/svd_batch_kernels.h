@@ -0,0 +1,97 @@
+#ifndef __svd_svd_batch_kernels_h__
+#define __svd_svd_batch_kernels_h__
+
+//the batch kernels of one instruction set wider than sse, for programs built with SVD_BATCH_KERNEL_OBJECTS (see svd_batch.h).
+//include this in one translation unit per set, compiled with one of
+//
+//  SVD_BATCH_KERNELS_AVX       -mavx
+//  SVD_BATCH_KERNELS_AVX2      -mavx2 -mfma
+//  SVD_BATCH_KERNELS_AVX512    -mavx512f
+//
+//and link the three objects with the rest of the program, which is built for the baseline. msvc exposes every set without /arch
+
+#if !defined(SVD_BATCH_KERNEL_OBJECTS)
+    #define SVD_BATCH_KERNEL_OBJECTS
+#endif
+
+#include "svd_batch.h"
+
+//everything the entry points call is inlined into them, so the object does not emit its own copies of the inline functions it
+//shares with the baseline code, which the linker could pick for the whole program
+#if defined(_MSC_VER)
+    #define SVD_BATCH_KERNELS_ENTRY
+#else
+    #define SVD_BATCH_KERNELS_ENTRY __attribute__((flatten))
+#endif
+
+namespace svd
+{
+    namespace details
+    {
+        #if defined(SVD_BATCH_KERNELS_AVX)
+            #if !defined(SVD_MATH_AVX)
+                #error "SVD_BATCH_KERNELS_AVX needs the avx code generation flags"
+            #endif
+
+        template <typename kernel> SVD_BATCH_KERNELS_ENTRY void run_batch_avx( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k )
+        {
+            run_batch<avx_vector>( n, begin, end, l, streaming, k );
+        }
+
+        SVD_BATCH_KERNELS_ENTRY rigid_accumulator<cpu_scalar> accumulate_pairs_avx( const float* p, const float* q, const float* w, size_t n )
+        {
+            return accumulate_pairs<avx_vector>( p, q, w, n );
+        }
+
+        template void run_batch_avx( size_t, size_t, size_t, layout, bool, const usv_kernel& );
+        template void run_batch_avx( size_t, size_t, size_t, layout, bool, const polar_kernel& );
+        template void run_batch_avx( size_t, size_t, size_t, layout, bool, const eigen_kernel& );
+        template void run_batch_avx( size_t, size_t, size_t, layout, bool, const rigid_kernel& );
+
+        #elif defined(SVD_BATCH_KERNELS_AVX2)
+            #if !defined(SVD_MATH_AVX2)
+                #error "SVD_BATCH_KERNELS_AVX2 needs the avx2 and fma code generation flags"
+            #endif
+
+        template <typename kernel> SVD_BATCH_KERNELS_ENTRY void run_batch_avx2( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k )
+        {
+            run_batch<avx2_vector>( n, begin, end, l, streaming, k );
+        }
+
+        SVD_BATCH_KERNELS_ENTRY rigid_accumulator<cpu_scalar> accumulate_pairs_avx2( const float* p, const float* q, const float* w, size_t n )
+        {
+            return accumulate_pairs<avx2_vector>( p, q, w, n );
+        }
+
+        template void run_batch_avx2( size_t, size_t, size_t, layout, bool, const usv_kernel& );
+        template void run_batch_avx2( size_t, size_t, size_t, layout, bool, const polar_kernel& );
+        template void run_batch_avx2( size_t, size_t, size_t, layout, bool, const eigen_kernel& );
+        template void run_batch_avx2( size_t, size_t, size_t, layout, bool, const rigid_kernel& );
+
+        #elif defined(SVD_BATCH_KERNELS_AVX512)
+            #if !defined(SVD_MATH_AVX512)
+                #error "SVD_BATCH_KERNELS_AVX512 needs the avx-512f code generation flags"
+            #endif
+
+        template <typename kernel> SVD_BATCH_KERNELS_ENTRY void run_batch_avx512( size_t n, size_t begin, size_t end, layout l, bool streaming, const kernel& k )
+        {
+            run_batch<avx512_vector>( n, begin, end, l, streaming, k );
+        }
+
+        SVD_BATCH_KERNELS_ENTRY rigid_accumulator<cpu_scalar> accumulate_pairs_avx512( const float* p, const float* q, const float* w, size_t n )
+        {
+            return accumulate_pairs<avx512_vector>( p, q, w, n );
+        }
+
+        template void run_batch_avx512( size_t, size_t, size_t, layout, bool, const usv_kernel& );
+        template void run_batch_avx512( size_t, size_t, size_t, layout, bool, const polar_kernel& );
+        template void run_batch_avx512( size_t, size_t, size_t, layout, bool, const eigen_kernel& );
+        template void run_batch_avx512( size_t, size_t, size_t, layout, bool, const rigid_kernel& );
+
+        #else
+            #error "define one of SVD_BATCH_KERNELS_AVX, SVD_BATCH_KERNELS_AVX2, SVD_BATCH_KERNELS_AVX512"
+        #endif
+    }
+}
+
+#endif
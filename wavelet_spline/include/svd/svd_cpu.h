@@ -0,0 +1,131 @@
+#ifndef __svd_svd_cpu_h__
+#define __svd_svd_cpu_h__
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #include <immintrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+    #include <cpuid.h>
+#endif
+
+namespace svd
+{
+    namespace cpu
+    {
+        //ordered, every instruction set includes the previous ones
+        enum instruction_set
+        {
+            instruction_set_scalar,
+            instruction_set_sse,
+            instruction_set_avx,
+            instruction_set_avx2,       //avx2 + fma
+            instruction_set_avx512      //avx-512f
+        };
+
+        namespace details
+        {
+            inline void cpuid( uint32_t leaf, uint32_t sub_leaf, uint32_t r[4] )
+            {
+                #if defined(_MSC_VER)
+                    int v[4];
+                    __cpuidex( v, static_cast<int> ( leaf ), static_cast<int> ( sub_leaf ) );
+                    r[0] = static_cast<uint32_t> ( v[0] );
+                    r[1] = static_cast<uint32_t> ( v[1] );
+                    r[2] = static_cast<uint32_t> ( v[2] );
+                    r[3] = static_cast<uint32_t> ( v[3] );
+                #elif defined(__i386__) || defined(__x86_64__)
+                    __cpuid_count( leaf, sub_leaf, r[0], r[1], r[2], r[3] );
+                #else
+                    r[0] = r[1] = r[2] = r[3] = 0;
+                #endif
+            }
+
+            //register state the os saves on a context switch
+            inline uint64_t xgetbv0()
+            {
+                #if defined(_MSC_VER)
+                    return _xgetbv( 0 );
+                #elif defined(__i386__) || defined(__x86_64__)
+                    uint32_t lo;
+                    uint32_t hi;
+                    __asm__ __volatile__ ( "xgetbv" : "=a" (lo), "=d" (hi) : "c" (0) );
+                    return ( static_cast<uint64_t> ( hi ) << 32 ) | lo;
+                #else
+                    return 0;
+                #endif
+            }
+
+            inline instruction_set detect_instruction_set()
+            {
+                uint32_t r[4];
+
+                cpuid( 0, 0, r );
+                const uint32_t max_leaf = r[0];
+
+                if ( max_leaf < 1 )
+                {
+                    return instruction_set_scalar;
+                }
+
+                cpuid( 1, 0, r );
+
+                const bool sse     = ( r[3] & ( 1u << 25 ) ) != 0;
+                const bool fma     = ( r[2] & ( 1u << 12 ) ) != 0;
+                const bool osxsave = ( r[2] & ( 1u << 27 ) ) != 0;
+                const bool avx     = ( r[2] & ( 1u << 28 ) ) != 0;
+
+                if ( !sse )
+                {
+                    return instruction_set_scalar;
+                }
+
+                if ( !osxsave || !avx )
+                {
+                    return instruction_set_sse;
+                }
+
+                const uint64_t xcr0 = xgetbv0();
+
+                //xmm and ymm state
+                if ( ( xcr0 & 0x6 ) != 0x6 )
+                {
+                    return instruction_set_sse;
+                }
+
+                if ( max_leaf < 7 )
+                {
+                    return instruction_set_avx;
+                }
+
+                cpuid( 7, 0, r );
+
+                const bool avx2    = ( r[1] & ( 1u << 5 ) ) != 0;
+                const bool avx512f = ( r[1] & ( 1u << 16 ) ) != 0;
+
+                if ( !avx2 || !fma )
+                {
+                    return instruction_set_avx;
+                }
+
+                //opmask, upper halves of zmm0-15 and zmm16-31 state
+                if ( !avx512f || ( xcr0 & 0xe0 ) != 0xe0 )
+                {
+                    return instruction_set_avx2;
+                }
+
+                return instruction_set_avx512;
+            }
+        }
+
+        //widest instruction set of the processor that the os supports
+        inline instruction_set supported_instruction_set()
+        {
+            static const instruction_set s = details::detect_instruction_set();
+            return s;
+        }
+    }
+}
+
+#endif
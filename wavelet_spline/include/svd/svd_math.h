@@ -4,6 +4,7 @@
 #include <xmmintrin.h>
 #include <immintrin.h>
 
+#include <cmath>
 #include <cstdint>
 
 namespace svd
@@ -14,6 +15,12 @@ namespace svd
     const float tiny_number             =   static_cast<float> ( 1.e-20 );
     const float small_number            =   static_cast<float> ( 1.e-12 );
 
+    //the same in double, the thresholds scaled to its precision
+    const double sine_pi_over_eight_double      =   .5*sqrt( 2. - sqrt(2.) );
+    const double cosine_pi_over_eight_double    =   .5*sqrt( 2. + sqrt(2.) );
+    const double tiny_number_double             =   1.e-40;
+    const double small_number_double            =   1.e-30;
+
 
     namespace math
     {
@@ -21,13 +28,15 @@ namespace svd
         template <typename t> inline t sub( t a, t b );
         template <typename t> inline t div( t a, t b );
         template <typename t> inline t mul( t a, t b );
-        template <typename t> inline t madd( t a, t b, t c );
+        template <typename t> inline t madd( t a, t b, t c );   // a * b + c
+        template <typename t> inline t nmadd( t a, t b, t c );  // c - a * b
         template <typename t> inline t max( t a, t b );
 
         template <typename t> inline t rsqrt( t a );
 
         template <typename t> inline t cmp_ge( t a, t b );
         template <typename t> inline t cmp_le( t a, t b );
+        template <typename t> inline t cmp_lt( t a, t b );
         template <typename t> inline t blend(  t a, t b, t mask );
 
         template <typename t> inline t zero();
@@ -35,8 +44,39 @@ namespace svd
 
         template <typename t> inline t splat( float f );
 
-        template <typename t> inline t and ( t a, t mask );
-        template <typename t> inline t xor ( t a, t b );
+        //splat of a double constant, for the double numbers
+        template <typename t> inline t splat_double( double f );
+
+        //constants of the kernels in the precision of the number t
+        template <typename t> struct constants
+        {
+            static t tiny_number()              { return splat<t>( svd::tiny_number ); }
+            static t small_number()             { return splat<t>( svd::small_number ); }
+            static t sine_pi_over_eight()       { return splat<t>( svd::sine_pi_over_eight ); }
+            static t cosine_pi_over_eight()     { return splat<t>( svd::cosine_pi_over_eight ); }
+        };
+
+        //the pi / 8 rotation must be orthogonal in double too, otherwise the jacobi conjugation stops being a similarity
+        template <typename t> struct constants_double
+        {
+            static t tiny_number()              { return splat_double<t>( svd::tiny_number_double ); }
+            static t small_number()             { return splat_double<t>( svd::small_number_double ); }
+            static t sine_pi_over_eight()       { return splat_double<t>( svd::sine_pi_over_eight_double ); }
+            static t cosine_pi_over_eight()     { return splat_double<t>( svd::cosine_pi_over_eight_double ); }
+        };
+
+        template <typename t> inline t bit_and( t a, t mask );
+        template <typename t> inline t bit_xor( t a, t b );
+        template <typename t> inline bool all( t mask );      // every lane of a comparison result is set
+
+        template <typename t> inline t load( const float* p );
+        template <typename t> inline void store( float* p, t v );
+
+        template <typename t> inline t load( const double* p );
+        template <typename t> inline void store( double* p, t v );
+
+        //between float and double numbers with the same number of lanes
+        template <typename to, typename from> inline to convert( from v );
 
         template <typename t> inline t operator+( t a, t b )
         {
@@ -63,7 +103,7 @@ namespace svd
 
         template <typename t> inline t dot3( t a1, t a2, t a3, t b1, t b2, t b3)
         {
-            return a1 * b1 + a2 * b2 + a3 * b3;
+            return madd( a3, b3, madd( a2, b2, a1 * b1 ) );
         }
     }
 }
@@ -148,6 +188,13 @@ namespace svd
             return r;
         }
 
+        template <> inline cpu_scalar nmadd( cpu_scalar a, cpu_scalar b, cpu_scalar c )
+        {
+            cpu_scalar r;
+            r.f = c.f - a.f * b.f;
+            return r;
+        }
+
         template <> inline cpu_scalar max( cpu_scalar a, cpu_scalar b )
         {
             cpu_scalar r;
@@ -180,13 +227,18 @@ namespace svd
             return r;
         }
 
-        template <> inline cpu_scalar operator<( cpu_scalar a, cpu_scalar b )
+        template <> inline cpu_scalar cmp_lt( cpu_scalar a, cpu_scalar b )
         {
             cpu_scalar r;
             r.u = a.f < b.f ? 0xffffffff : 0;
             return r;
         }
 
+        template <> inline cpu_scalar operator<( cpu_scalar a, cpu_scalar b )
+        {
+            return cmp_lt( a, b );
+        }
+
         // r = (mask == 0) ? a : b;
         template <> inline cpu_scalar blend( cpu_scalar a, cpu_scalar b, cpu_scalar mask )
         {
@@ -197,19 +249,34 @@ namespace svd
             return r;
         }
 
-        template <> inline cpu_scalar and( cpu_scalar a, cpu_scalar mask )
+        template <> inline cpu_scalar bit_and( cpu_scalar a, cpu_scalar mask )
         {
             cpu_scalar r;
             r.u = a.u & mask.u;
             return r;
         }
 
-        template <> inline cpu_scalar xor( cpu_scalar a, cpu_scalar b )
+        template <> inline cpu_scalar bit_xor( cpu_scalar a, cpu_scalar b )
         {
             cpu_scalar r;
             r.u = a.u ^ b.u;
             return r;
         }
+
+        template <> inline bool all( cpu_scalar mask )
+        {
+            return mask.u != 0;
+        }
+
+        template <> inline cpu_scalar load( const float* p )
+        {
+            return make_cpu_scalar( *p );
+        }
+
+        template <> inline void store( float* p, cpu_scalar v )
+        {
+            *p = v.f;
+        }
     }
 }
 
@@ -254,6 +321,11 @@ namespace svd
             return add( mul(a, b ), c );
         }
 
+        template <> inline sse_vector nmadd( sse_vector a, sse_vector b, sse_vector c )
+        {
+            return sub( c, mul(a, b ) );
+        }
+
         template <> inline sse_vector max( sse_vector a, sse_vector b )
         {
             return _mm_max_ps(a, b);
@@ -282,23 +354,62 @@ namespace svd
             return _mm_or_ps(v1, v2);
         }
 
-        template <> inline sse_vector and( sse_vector a, sse_vector mask )
+        template <> inline sse_vector bit_and( sse_vector a, sse_vector mask )
         {
             return _mm_and_ps( a, mask );
         }
 
-        template <> inline sse_vector xor( sse_vector a, sse_vector b )
+        template <> inline sse_vector bit_xor( sse_vector a, sse_vector b )
         {
             return _mm_xor_ps( a, b );
         }
 
-        template <> inline sse_vector operator<( sse_vector a, sse_vector b )
+        template <> inline bool all( sse_vector mask )
+        {
+            return _mm_movemask_ps( mask ) == 0xf;
+        }
+
+        template <> inline sse_vector cmp_lt( sse_vector a, sse_vector b )
         {
             return _mm_cmplt_ps( a, b);
         }
+
+        template <> inline sse_vector load( const float* p )
+        {
+            return _mm_loadu_ps( p );
+        }
+
+        template <> inline void store( float* p, sse_vector v )
+        {
+            _mm_storeu_ps( p, v );
+        }
+
+        //__m128 is a class type only in msvc, other compilers have built in operators for it
+#if defined(_MSC_VER)
+        template <> inline sse_vector operator<( sse_vector a, sse_vector b )
+        {
+            return cmp_lt( a, b );
+        }
+#endif
     }
 }
 
+//avx, avx2 + fma and avx-512 backends. msvc exposes all intrinsics regardless of /arch, other compilers only
+//when the instruction set is enabled for the translation unit (-mavx, -mavx2 -mfma, -mavx512f). functions returning
+//avx vectors in a translation unit without avx would be compiled for a different abi
+#if defined(_MSC_VER) || defined(__AVX__)
+    #define SVD_MATH_AVX
+#endif
+
+#if defined(_MSC_VER) || ( defined(__AVX2__) && defined(__FMA__) )
+    #define SVD_MATH_AVX2
+#endif
+
+#if defined(_MSC_VER) || defined(__AVX512F__)
+    #define SVD_MATH_AVX512
+#endif
+
+#if defined(SVD_MATH_AVX)
 namespace svd
 {
     typedef __m256 avx_vector;
@@ -340,6 +451,11 @@ namespace svd
             return add( mul(a, b ), c );
         }
 
+        template <> inline avx_vector nmadd( avx_vector a, avx_vector b, avx_vector c )
+        {
+            return sub( c, mul(a, b ) );
+        }
+
         template <> inline avx_vector max( avx_vector a, avx_vector b )
         {
             return _mm256_max_ps(a, b);
@@ -366,23 +482,754 @@ namespace svd
             return _mm256_blendv_ps( a, b, mask) ;
         }
 
-        template <> inline avx_vector and( avx_vector a, avx_vector mask )
+        template <> inline avx_vector bit_and( avx_vector a, avx_vector mask )
         {
             return _mm256_and_ps( a, mask );
         }
 
-        template <> inline avx_vector xor( avx_vector a, avx_vector b )
+        template <> inline avx_vector bit_xor( avx_vector a, avx_vector b )
         {
             return _mm256_xor_ps( a, b );
         }
 
-        template <> inline avx_vector operator<( avx_vector a, avx_vector b )
+        template <> inline bool all( avx_vector mask )
+        {
+            return _mm256_movemask_ps( mask ) == 0xff;
+        }
+
+        template <> inline avx_vector cmp_lt( avx_vector a, avx_vector b )
         {
             return _mm256_cmp_ps(a, b, _CMP_LT_OS);
         }
+
+        template <> inline avx_vector load( const float* p )
+        {
+            return _mm256_loadu_ps( p );
+        }
+
+        template <> inline void store( float* p, avx_vector v )
+        {
+            _mm256_storeu_ps( p, v );
+        }
+
+#if defined(_MSC_VER)
+        template <> inline avx_vector operator<( avx_vector a, avx_vector b )
+        {
+            return cmp_lt( a, b );
+        }
+#endif
+    }
+}
+
+#endif
+
+#if defined(SVD_MATH_AVX2)
+namespace svd
+{
+    //same lanes as avx_vector, but madd and nmadd are fused. wrapped in a struct to be a distinct type from avx_vector
+    struct avx2_vector
+    {
+        __m256 m_v;
+    };
+
+    inline avx2_vector make_avx2_vector( __m256 v )
+    {
+        avx2_vector r = { v };
+        return r;
+    }
+
+    namespace math
+    {
+        template <> inline avx2_vector splat( float f )
+        {
+            return make_avx2_vector( _mm256_set1_ps(f) );
+        }
+
+        template <> inline avx2_vector zero( )
+        {
+            return make_avx2_vector( _mm256_setzero_ps() );
+        }
+
+        template <> inline avx2_vector one( )
+        {
+            return make_avx2_vector( _mm256_set1_ps(1.0f) );
+        }
+
+        template <> inline avx2_vector add( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_add_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx2_vector sub( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_sub_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx2_vector mul( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_mul_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx2_vector div( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_div_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx2_vector madd( avx2_vector a, avx2_vector b, avx2_vector c )
+        {
+            return make_avx2_vector( _mm256_fmadd_ps(a.m_v, b.m_v, c.m_v) );
+        }
+
+        template <> inline avx2_vector nmadd( avx2_vector a, avx2_vector b, avx2_vector c )
+        {
+            return make_avx2_vector( _mm256_fnmadd_ps(a.m_v, b.m_v, c.m_v) );
+        }
+
+        template <> inline avx2_vector max( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_max_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx2_vector rsqrt( avx2_vector a )
+        {
+            return make_avx2_vector( _mm256_rsqrt_ps(a.m_v) );
+        }
+
+        template <> inline avx2_vector cmp_ge( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_cmp_ps(a.m_v, b.m_v, _CMP_GE_OS) );
+        }
+
+        template <> inline avx2_vector cmp_le( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_cmp_ps(a.m_v, b.m_v, _CMP_LE_OS) );
+        }
+
+        template <> inline avx2_vector cmp_lt( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_cmp_ps(a.m_v, b.m_v, _CMP_LT_OS) );
+        }
+
+        template <> inline avx2_vector operator<( avx2_vector a, avx2_vector b )
+        {
+            return cmp_lt( a, b );
+        }
+
+        // r = (mask == 0) ? a : b;
+        template <> inline avx2_vector blend( avx2_vector a, avx2_vector b, avx2_vector mask )
+        {
+            return make_avx2_vector( _mm256_blendv_ps( a.m_v, b.m_v, mask.m_v ) );
+        }
+
+        template <> inline avx2_vector bit_and( avx2_vector a, avx2_vector mask )
+        {
+            return make_avx2_vector( _mm256_and_ps( a.m_v, mask.m_v ) );
+        }
+
+        template <> inline avx2_vector bit_xor( avx2_vector a, avx2_vector b )
+        {
+            return make_avx2_vector( _mm256_xor_ps( a.m_v, b.m_v ) );
+        }
+
+        template <> inline bool all( avx2_vector mask )
+        {
+            return _mm256_movemask_ps( mask.m_v ) == 0xff;
+        }
+
+        template <> inline avx2_vector load( const float* p )
+        {
+            return make_avx2_vector( _mm256_loadu_ps( p ) );
+        }
+
+        template <> inline void store( float* p, avx2_vector v )
+        {
+            _mm256_storeu_ps( p, v.m_v );
+        }
+    }
+}
+#endif
+
+#if defined(SVD_MATH_AVX512)
+namespace svd
+{
+    //16 lanes with fused madd. the comparisons produce a bit per lane in a mask register instead of a
+    //vector, so they are overloads returning avx512_mask and blend / bit_and take the mask
+    struct avx512_vector
+    {
+        __m512 m_v;
+    };
+
+    struct avx512_mask
+    {
+        __mmask16 m_k;
+    };
+
+    inline avx512_vector make_avx512_vector( __m512 v )
+    {
+        avx512_vector r = { v };
+        return r;
+    }
+
+    inline avx512_mask make_avx512_mask( __mmask16 k )
+    {
+        avx512_mask r = { k };
+        return r;
+    }
+
+    namespace math
+    {
+        template <> inline avx512_vector splat( float f )
+        {
+            return make_avx512_vector( _mm512_set1_ps(f) );
+        }
+
+        template <> inline avx512_vector zero( )
+        {
+            return make_avx512_vector( _mm512_setzero_ps() );
+        }
+
+        template <> inline avx512_vector one( )
+        {
+            return make_avx512_vector( _mm512_set1_ps(1.0f) );
+        }
+
+        template <> inline avx512_vector add( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_vector( _mm512_add_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx512_vector sub( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_vector( _mm512_sub_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx512_vector mul( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_vector( _mm512_mul_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx512_vector div( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_vector( _mm512_div_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx512_vector madd( avx512_vector a, avx512_vector b, avx512_vector c )
+        {
+            return make_avx512_vector( _mm512_fmadd_ps(a.m_v, b.m_v, c.m_v) );
+        }
+
+        template <> inline avx512_vector nmadd( avx512_vector a, avx512_vector b, avx512_vector c )
+        {
+            return make_avx512_vector( _mm512_fnmadd_ps(a.m_v, b.m_v, c.m_v) );
+        }
+
+        template <> inline avx512_vector max( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_vector( _mm512_max_ps(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx512_vector rsqrt( avx512_vector a )
+        {
+            return make_avx512_vector( _mm512_rsqrt14_ps(a.m_v) );
+        }
+
+        inline avx512_mask cmp_ge( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_mask( _mm512_cmp_ps_mask(a.m_v, b.m_v, _CMP_GE_OS) );
+        }
+
+        inline avx512_mask cmp_le( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_mask( _mm512_cmp_ps_mask(a.m_v, b.m_v, _CMP_LE_OS) );
+        }
+
+        inline avx512_mask cmp_lt( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_mask( _mm512_cmp_ps_mask(a.m_v, b.m_v, _CMP_LT_OS) );
+        }
+
+        inline avx512_mask operator<( avx512_vector a, avx512_vector b )
+        {
+            return cmp_lt( a, b );
+        }
+
+        // r = (mask == 0) ? a : b;
+        inline avx512_vector blend( avx512_vector a, avx512_vector b, avx512_mask mask )
+        {
+            return make_avx512_vector( _mm512_mask_blend_ps( mask.m_k, a.m_v, b.m_v ) );
+        }
+
+        inline avx512_vector bit_and( avx512_vector a, avx512_mask mask )
+        {
+            return make_avx512_vector( _mm512_maskz_mov_ps( mask.m_k, a.m_v ) );
+        }
+
+        inline avx512_vector bit_and( avx512_mask mask, avx512_vector a )
+        {
+            return make_avx512_vector( _mm512_maskz_mov_ps( mask.m_k, a.m_v ) );
+        }
+
+        template <> inline avx512_vector bit_xor( avx512_vector a, avx512_vector b )
+        {
+            return make_avx512_vector( _mm512_castsi512_ps( _mm512_xor_si512( _mm512_castps_si512( a.m_v ), _mm512_castps_si512( b.m_v ) ) ) );
+        }
+
+        inline bool all( avx512_mask mask )
+        {
+            return mask.m_k == 0xffff;
+        }
+
+        template <> inline avx512_vector load( const float* p )
+        {
+            return make_avx512_vector( _mm512_loadu_ps( p ) );
+        }
+
+        template <> inline void store( float* p, avx512_vector v )
+        {
+            _mm512_storeu_ps( p, v.m_v );
+        }
     }
 }
+#endif
 
+//double precision backends, for ill conditioned matrices. rsqrt is exact (1 / sqrt), so the newton
+//step of the float kernels is a no op for them
+namespace svd
+{
+    typedef union
+    {
+        double   f;
+        uint64_t u;
+    } cpu_scalar_double;
+
+    cpu_scalar_double inline make_cpu_scalar_double( double f )
+    {
+        cpu_scalar_double r;
+        r.f = f;
+        return r;
+    }
 
+    namespace math
+    {
+        template <> inline cpu_scalar_double splat( float f )
+        {
+            return make_cpu_scalar_double( f );
+        }
+
+        template <> inline cpu_scalar_double zero( )
+        {
+            return make_cpu_scalar_double( 0.0 );
+        }
+
+        template <> inline cpu_scalar_double one( )
+        {
+            return make_cpu_scalar_double( 1.0 );
+        }
+
+        template <> inline cpu_scalar_double add( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            return make_cpu_scalar_double( a.f + b.f );
+        }
+
+        template <> inline cpu_scalar_double sub( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            return make_cpu_scalar_double( a.f - b.f );
+        }
+
+        template <> inline cpu_scalar_double mul( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            return make_cpu_scalar_double( a.f * b.f );
+        }
+
+        template <> inline cpu_scalar_double div( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            return make_cpu_scalar_double( a.f / b.f );
+        }
+
+        template <> inline cpu_scalar_double madd( cpu_scalar_double a, cpu_scalar_double b, cpu_scalar_double c )
+        {
+            return make_cpu_scalar_double( a.f * b.f + c.f );
+        }
+
+        template <> inline cpu_scalar_double nmadd( cpu_scalar_double a, cpu_scalar_double b, cpu_scalar_double c )
+        {
+            return make_cpu_scalar_double( c.f - a.f * b.f );
+        }
+
+        template <> inline cpu_scalar_double max( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            return make_cpu_scalar_double( a.f > b.f ? a.f : b.f );
+        }
+
+        template <> inline cpu_scalar_double rsqrt( cpu_scalar_double a )
+        {
+            return make_cpu_scalar_double( 1.0 / std::sqrt( a.f ) );
+        }
+
+        template <> inline cpu_scalar_double cmp_ge( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            cpu_scalar_double r;
+            r.u = a.f < b.f ? 0 : 0xffffffffffffffffULL;
+            return r;
+        }
+
+        template <> inline cpu_scalar_double cmp_le( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            cpu_scalar_double r;
+            r.u = a.f > b.f ? 0 : 0xffffffffffffffffULL;
+            return r;
+        }
+
+        template <> inline cpu_scalar_double cmp_lt( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            cpu_scalar_double r;
+            r.u = a.f < b.f ? 0xffffffffffffffffULL : 0;
+            return r;
+        }
+
+        template <> inline cpu_scalar_double operator<( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            return cmp_lt( a, b );
+        }
+
+        // r = (mask == 0) ? a : b;
+        template <> inline cpu_scalar_double blend( cpu_scalar_double a, cpu_scalar_double b, cpu_scalar_double mask )
+        {
+            cpu_scalar_double r;
+            r.u = ( a.u & ~mask.u ) | ( mask.u & b.u );
+            return r;
+        }
+
+        template <> inline cpu_scalar_double bit_and( cpu_scalar_double a, cpu_scalar_double mask )
+        {
+            cpu_scalar_double r;
+            r.u = a.u & mask.u;
+            return r;
+        }
+
+        template <> inline cpu_scalar_double bit_xor( cpu_scalar_double a, cpu_scalar_double b )
+        {
+            cpu_scalar_double r;
+            r.u = a.u ^ b.u;
+            return r;
+        }
+
+        template <> inline bool all( cpu_scalar_double mask )
+        {
+            return mask.u != 0;
+        }
+
+        template <> inline cpu_scalar_double splat_double( double f )
+        {
+            return make_cpu_scalar_double( f );
+        }
+
+        template <> struct constants<cpu_scalar_double> : constants_double<cpu_scalar_double>
+        {
+
+        };
+
+        template <> inline cpu_scalar_double load( const double* p )
+        {
+            return make_cpu_scalar_double( *p );
+        }
+
+        template <> inline void store( double* p, cpu_scalar_double v )
+        {
+            *p = v.f;
+        }
+
+        template <> inline cpu_scalar_double convert( cpu_scalar v )
+        {
+            return make_cpu_scalar_double( v.f );
+        }
+
+        template <> inline cpu_scalar convert( cpu_scalar_double v )
+        {
+            return make_cpu_scalar( static_cast<float> ( v.f ) );
+        }
+    }
+}
+
+namespace svd
+{
+    //wrapped in a struct, the raw __m128d drops its attributes as a template argument of the specializations
+    struct sse_vector_double
+    {
+        __m128d m_v;
+    };
+
+    inline sse_vector_double make_sse_vector_double( __m128d v )
+    {
+        sse_vector_double r = { v };
+        return r;
+    }
+
+    namespace math
+    {
+        template <> inline sse_vector_double splat( float f )
+        {
+            return make_sse_vector_double( _mm_set1_pd( f ) );
+        }
+
+        template <> inline sse_vector_double zero( )
+        {
+            return make_sse_vector_double( _mm_setzero_pd() );
+        }
+
+        template <> inline sse_vector_double one( )
+        {
+            return make_sse_vector_double( _mm_set1_pd( 1.0 ) );
+        }
+
+        template <> inline sse_vector_double add( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_add_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline sse_vector_double sub( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_sub_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline sse_vector_double mul( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_mul_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline sse_vector_double div( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_div_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline sse_vector_double madd( sse_vector_double a, sse_vector_double b, sse_vector_double c )
+        {
+            return add( mul(a, b ), c );
+        }
+
+        template <> inline sse_vector_double nmadd( sse_vector_double a, sse_vector_double b, sse_vector_double c )
+        {
+            return sub( c, mul(a, b ) );
+        }
+
+        template <> inline sse_vector_double max( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_max_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline sse_vector_double rsqrt( sse_vector_double a )
+        {
+            return make_sse_vector_double( _mm_div_pd( _mm_set1_pd( 1.0 ), _mm_sqrt_pd( a.m_v ) ) );
+        }
+
+        template <> inline sse_vector_double cmp_ge( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_cmpge_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline sse_vector_double cmp_le( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_cmple_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline sse_vector_double cmp_lt( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_cmplt_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline sse_vector_double operator<( sse_vector_double a, sse_vector_double b )
+        {
+            return cmp_lt( a, b );
+        }
+
+        // r = (mask == 0) ? a : b;
+        template <> inline sse_vector_double blend( sse_vector_double a, sse_vector_double b, sse_vector_double mask )
+        {
+            return make_sse_vector_double( _mm_or_pd( _mm_andnot_pd( mask.m_v, a.m_v ), _mm_and_pd( b.m_v, mask.m_v ) ) );
+        }
+
+        template <> inline sse_vector_double bit_and( sse_vector_double a, sse_vector_double mask )
+        {
+            return make_sse_vector_double( _mm_and_pd( a.m_v, mask.m_v ) );
+        }
+
+        template <> inline sse_vector_double bit_xor( sse_vector_double a, sse_vector_double b )
+        {
+            return make_sse_vector_double( _mm_xor_pd( a.m_v, b.m_v ) );
+        }
+
+        template <> inline bool all( sse_vector_double mask )
+        {
+            return _mm_movemask_pd( mask.m_v ) == 0x3;
+        }
+
+        template <> inline sse_vector_double splat_double( double f )
+        {
+            return make_sse_vector_double( _mm_set1_pd( f ) );
+        }
+
+        template <> struct constants<sse_vector_double> : constants_double<sse_vector_double>
+        {
+
+        };
+
+        template <> inline sse_vector_double load( const double* p )
+        {
+            return make_sse_vector_double( _mm_loadu_pd( p ) );
+        }
+
+        template <> inline void store( double* p, sse_vector_double v )
+        {
+            _mm_storeu_pd( p, v.m_v );
+        }
+    }
+}
+
+#if defined(SVD_MATH_AVX)
+namespace svd
+{
+    //wrapped in a struct like sse_vector_double
+    struct avx_vector_double
+    {
+        __m256d m_v;
+    };
+
+    inline avx_vector_double make_avx_vector_double( __m256d v )
+    {
+        avx_vector_double r = { v };
+        return r;
+    }
+
+    namespace math
+    {
+        template <> inline avx_vector_double splat( float f )
+        {
+            return make_avx_vector_double( _mm256_set1_pd( f ) );
+        }
+
+        template <> inline avx_vector_double zero( )
+        {
+            return make_avx_vector_double( _mm256_setzero_pd() );
+        }
+
+        template <> inline avx_vector_double one( )
+        {
+            return make_avx_vector_double( _mm256_set1_pd( 1.0 ) );
+        }
+
+        template <> inline avx_vector_double add( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_add_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx_vector_double sub( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_sub_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx_vector_double mul( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_mul_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx_vector_double div( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_div_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx_vector_double madd( avx_vector_double a, avx_vector_double b, avx_vector_double c )
+        {
+            return add( mul(a, b ), c );
+        }
+
+        template <> inline avx_vector_double nmadd( avx_vector_double a, avx_vector_double b, avx_vector_double c )
+        {
+            return sub( c, mul(a, b ) );
+        }
+
+        template <> inline avx_vector_double max( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_max_pd(a.m_v, b.m_v) );
+        }
+
+        template <> inline avx_vector_double rsqrt( avx_vector_double a )
+        {
+            return make_avx_vector_double( _mm256_div_pd( _mm256_set1_pd( 1.0 ), _mm256_sqrt_pd( a.m_v ) ) );
+        }
+
+        template <> inline avx_vector_double cmp_ge( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_cmp_pd(a.m_v, b.m_v, _CMP_GE_OS) );
+        }
+
+        template <> inline avx_vector_double cmp_le( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_cmp_pd(a.m_v, b.m_v, _CMP_LE_OS) );
+        }
+
+        template <> inline avx_vector_double cmp_lt( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_cmp_pd(a.m_v, b.m_v, _CMP_LT_OS) );
+        }
+
+        template <> inline avx_vector_double operator<( avx_vector_double a, avx_vector_double b )
+        {
+            return cmp_lt( a, b );
+        }
+
+        // r = (mask == 0) ? a : b;
+        template <> inline avx_vector_double blend( avx_vector_double a, avx_vector_double b, avx_vector_double mask )
+        {
+            return make_avx_vector_double( _mm256_blendv_pd( a.m_v, b.m_v, mask.m_v ) );
+        }
+
+        template <> inline avx_vector_double bit_and( avx_vector_double a, avx_vector_double mask )
+        {
+            return make_avx_vector_double( _mm256_and_pd( a.m_v, mask.m_v ) );
+        }
+
+        template <> inline avx_vector_double bit_xor( avx_vector_double a, avx_vector_double b )
+        {
+            return make_avx_vector_double( _mm256_xor_pd( a.m_v, b.m_v ) );
+        }
+
+        template <> inline bool all( avx_vector_double mask )
+        {
+            return _mm256_movemask_pd( mask.m_v ) == 0xf;
+        }
+
+        template <> inline avx_vector_double splat_double( double f )
+        {
+            return make_avx_vector_double( _mm256_set1_pd( f ) );
+        }
+
+        template <> struct constants<avx_vector_double> : constants_double<avx_vector_double>
+        {
+
+        };
+
+        template <> inline avx_vector_double load( const double* p )
+        {
+            return make_avx_vector_double( _mm256_loadu_pd( p ) );
+        }
+
+        template <> inline void store( double* p, avx_vector_double v )
+        {
+            _mm256_storeu_pd( p, v.m_v );
+        }
+
+        //4 lanes each, for the mixed precision mode
+        template <> inline avx_vector_double convert( sse_vector v )
+        {
+            return make_avx_vector_double( _mm256_cvtps_pd( v ) );
+        }
+
+        template <> inline sse_vector convert( avx_vector_double v )
+        {
+            return _mm256_cvtpd_ps( v.m_v );
+        }
+    }
+}
+#endif
 
 #endif
@@ -0,0 +1,222 @@
+#ifndef __svd_polar_h__
+#define __svd_polar_h__
+
+#include <cstdint>
+
+#include "svd_types.h"
+#include "svd_math.h"
+#include "svd.h"
+
+namespace svd
+{
+    //polar_method_svd is exact for every matrix and gives rotations. polar_method_newton is much cheaper for near rotations, see rotation_newton.
+    //polar_method_newton_svd is the newton iteration with the svd for the lanes where it does not give a rotation, see rotation_newton_svd
+    enum polar_method
+    {
+        polar_method_svd,
+        polar_method_newton,
+        polar_method_newton_svd
+    };
+
+    //u * conjugate(v), the rotation matrix of the result is U * transpose(V)
+    template <typename t> inline quaternion<t> multiply_conjugate( const quaternion<t>& u, const quaternion<t>& v )
+    {
+        using namespace svd::math;
+
+        auto w = madd( u.z, v.z, madd( u.y, v.y, madd( u.x, v.x, u.w * v.w ) ) );
+        auto x = madd( u.z, v.y, nmadd( u.y, v.z, nmadd( u.w, v.x, u.x * v.w ) ) );
+        auto y = nmadd( u.z, v.x, madd( u.x, v.z, nmadd( u.w, v.y, u.y * v.w ) ) );
+        auto z = madd( u.y, v.x, nmadd( u.x, v.y, nmadd( u.w, v.z, u.z * v.w ) ) );
+
+        return create_quaternion( x, y, z, w );
+    }
+
+    //rotation r of the polar decomposition A = R * S as a unit quaternion.
+    //the decomposition keeps U and V as quaternions, so neither of them is converted to a matrix
+    //and U * transpose(V) is one quaternion product. sigma is a by product of the qr factorization.
+    //r is a rotation also when det(A) < 0, then S has a negative eigenvalue.
+    //the jacobi sweeps take most of the time. a non zero tolerance stops them once every lane has converged,
+    //which is most of the time saved for near rotations A (co-rotational fem, shape matching), see compute_v
+    template <typename t> inline quaternion<t> rotation_only_as_quaternion( const matrix3x3<t>& in, float tolerance = 0.0f )
+    {
+        quaternion<t> u;
+        quaternion<t> v;
+        vector3<t>    s;
+
+        compute_v( in, v, tolerance );
+        compute_us( in, u, s, v );
+
+        auto r = multiply_conjugate( u, v );
+        normalize( r );
+        return r;
+    }
+
+    //rotation r of the polar decomposition A = R * S
+    template <typename t> inline matrix3x3<t> rotation_only( const matrix3x3<t>& in, float tolerance = 0.0f )
+    {
+        return create_rotation_matrix( rotation_only_as_quaternion( in, tolerance ) );
+    }
+
+    //symmetric part S = transpose(R) * A of the polar decomposition A = R * S
+    template <typename t> inline matrix3x3<t> polar_symmetric( const matrix3x3<t>& in, const matrix3x3<t>& r )
+    {
+        using namespace svd::math;
+
+        auto s11 = dot3( r.a11, r.a21, r.a31, in.a11, in.a21, in.a31 );
+        auto s12 = dot3( r.a11, r.a21, r.a31, in.a12, in.a22, in.a32 );
+        auto s13 = dot3( r.a11, r.a21, r.a31, in.a13, in.a23, in.a33 );
+
+        auto s21 = dot3( r.a12, r.a22, r.a32, in.a11, in.a21, in.a31 );
+        auto s22 = dot3( r.a12, r.a22, r.a32, in.a12, in.a22, in.a32 );
+        auto s23 = dot3( r.a12, r.a22, r.a32, in.a13, in.a23, in.a33 );
+
+        auto s31 = dot3( r.a13, r.a23, r.a33, in.a11, in.a21, in.a31 );
+        auto s32 = dot3( r.a13, r.a23, r.a33, in.a12, in.a22, in.a32 );
+        auto s33 = dot3( r.a13, r.a23, r.a33, in.a13, in.a23, in.a33 );
+
+        //remove the rounding error of the product from the symmetric part
+        auto half = splat<t>( 0.5f );
+
+        s12 = ( s12 + s21 ) * half;
+        s13 = ( s13 + s31 ) * half;
+        s23 = ( s23 + s32 ) * half;
+
+        return create_matrix( s11, s12, s13, s12, s22, s23, s13, s23, s33 );
+    }
+
+    //polar decomposition A = R * S, R is a rotation and S = transpose(R) * A is symmetric
+    template <typename t> inline void polar( const matrix3x3<t>& in, matrix3x3<t>& r, matrix3x3<t>& s, float tolerance = 0.0f )
+    {
+        r = rotation_only( in, tolerance );
+        s = polar_symmetric( in, r );
+    }
+
+    //orthogonal factor of the polar decomposition with the scaled newton iteration of higham,
+    //x = ( gamma * x + inverse(transpose(x)) / gamma ) / 2, gamma = ( |inverse(x)| / |x| ) ^ 1/2 (frobenius norms).
+    //no jacobi sweeps and no qr, only cofactors and one division per iteration, so it is several times cheaper
+    //than rotation_only when the iteration converges quickly, as for near rotations (2 - 3 iterations).
+    //the result is a rotation only for det(A) > 0, it is a reflection for det(A) < 0. A must not be singular.
+    //iterates until every lane has moved less than tolerance (relative) or for max_iterations
+    template <typename t> inline matrix3x3<t> rotation_newton( const matrix3x3<t>& in, float tolerance = 1e-6f, int32_t max_iterations = 8 )
+    {
+        using namespace svd::math;
+
+        auto x = in;
+
+        auto half       = splat<t>( 0.5f );
+        auto tolerance2 = splat<t>( 3.0f * tolerance * tolerance );
+
+        for ( int32_t i = 0; i < max_iterations; ++i )
+        {
+            //cofactors, inverse(transpose(x)) = c / det(x)
+            auto c11 = x.a22 * x.a33 - x.a23 * x.a32;
+            auto c12 = x.a23 * x.a31 - x.a21 * x.a33;
+            auto c13 = x.a21 * x.a32 - x.a22 * x.a31;
+
+            auto c21 = x.a13 * x.a32 - x.a12 * x.a33;
+            auto c22 = x.a11 * x.a33 - x.a13 * x.a31;
+            auto c23 = x.a12 * x.a31 - x.a11 * x.a32;
+
+            auto c31 = x.a12 * x.a23 - x.a13 * x.a22;
+            auto c32 = x.a13 * x.a21 - x.a11 * x.a23;
+            auto c33 = x.a11 * x.a22 - x.a12 * x.a21;
+
+            auto det = dot3( x.a11, x.a12, x.a13, c11, c12, c13 );
+
+            auto x_norm2 = dot3( x.a11, x.a12, x.a13, x.a11, x.a12, x.a13 ) + dot3( x.a21, x.a22, x.a23, x.a21, x.a22, x.a23 ) + dot3( x.a31, x.a32, x.a33, x.a31, x.a32, x.a33 );
+            auto c_norm2 = dot3( c11, c12, c13, c11, c12, c13 ) + dot3( c21, c22, c23, c21, c22, c23 ) + dot3( c31, c32, c33, c31, c32, c33 );
+
+            //gamma = ( |c| ^ 2 / ( det ^ 2 * |x| ^ 2 ) ) ^ 1/4, the estimate of rsqrt is accurate enough for a scale factor
+            auto gamma      = rsqrt( rsqrt( c_norm2 / ( det * det * x_norm2 ) ) );
+            auto x_scale    = gamma * half;
+            auto c_scale    = half / ( gamma * det );
+
+            matrix3x3<t> next = create_matrix
+            (
+                madd( x.a11, x_scale, c11 * c_scale ), madd( x.a12, x_scale, c12 * c_scale ), madd( x.a13, x_scale, c13 * c_scale ),
+                madd( x.a21, x_scale, c21 * c_scale ), madd( x.a22, x_scale, c22 * c_scale ), madd( x.a23, x_scale, c23 * c_scale ),
+                madd( x.a31, x_scale, c31 * c_scale ), madd( x.a32, x_scale, c32 * c_scale ), madd( x.a33, x_scale, c33 * c_scale )
+            );
+
+            auto d1 = next.a11 - x.a11; auto d2 = next.a12 - x.a12; auto d3 = next.a13 - x.a13;
+            auto d4 = next.a21 - x.a21; auto d5 = next.a22 - x.a22; auto d6 = next.a23 - x.a23;
+            auto d7 = next.a31 - x.a31; auto d8 = next.a32 - x.a32; auto d9 = next.a33 - x.a33;
+
+            x = next;
+
+            if ( tolerance > 0.0f && all( cmp_le( dot3( d1, d2, d3, d1, d2, d3 ) + dot3( d4, d5, d6, d4, d5, d6 ) + dot3( d7, d8, d9, d7, d8, d9 ), tolerance2 ) ) )
+            {
+                break;
+            }
+        }
+
+        return x;
+    }
+
+    //polar decomposition A = R * S with the newton iteration, see rotation_newton
+    template <typename t> inline void polar_newton( const matrix3x3<t>& in, matrix3x3<t>& r, matrix3x3<t>& s, float tolerance = 1e-6f, int32_t max_iterations = 8 )
+    {
+        r = rotation_newton( in, tolerance, max_iterations );
+        s = polar_symmetric( in, r );
+    }
+
+    //rotation of the polar decomposition with the newton iteration, and with rotation_only in the lanes where det(A) <= 0, where the
+    //iteration gives a reflection or breaks down. the svd runs only for vectors with such a lane, so for near rotations this is as
+    //fast as rotation_newton and exact for every matrix. the tolerance stops the newton iteration, 0 picks the one of rotation_newton.
+    //the svd runs every jacobi sweep
+    template <typename t> inline matrix3x3<t> rotation_newton_svd( const matrix3x3<t>& in, float tolerance = 1e-6f, int32_t max_iterations = 8 )
+    {
+        using namespace svd::math;
+
+        auto det = dot3( in.a11, in.a12, in.a13, in.a22 * in.a33 - in.a23 * in.a32, in.a23 * in.a31 - in.a21 * in.a33, in.a21 * in.a32 - in.a22 * in.a31 );
+        auto positive = cmp_lt( zero<t>(), det );
+
+        auto r = rotation_newton( in, tolerance > 0.0f ? tolerance : 1e-6f, max_iterations );
+
+        if ( all( positive ) )
+        {
+            return r;
+        }
+
+        auto rs = rotation_only( in );
+
+        return create_matrix
+        (
+            blend( rs.a11, r.a11, positive ), blend( rs.a12, r.a12, positive ), blend( rs.a13, r.a13, positive ),
+            blend( rs.a21, r.a21, positive ), blend( rs.a22, r.a22, positive ), blend( rs.a23, r.a23, positive ),
+            blend( rs.a31, r.a31, positive ), blend( rs.a32, r.a32, positive ), blend( rs.a33, r.a33, positive )
+        );
+    }
+
+    template <typename t>
+    struct svd_result_polar
+    {
+        matrix3x3<t> m_r;
+        matrix3x3<t> m_s;
+    };
+
+    //obtain A = RS
+    template <typename t> inline svd_result_polar<t> compute_as_matrix_polar_decomposition( const matrix3x3<t>& in )
+    {
+        matrix3x3<t> r;
+        matrix3x3<t> s;
+        polar( in, r, s );
+        return { r, s };
+    }
+
+    //rotation of the polar decomposition with the chosen method
+    template <typename t> inline matrix3x3<t> rotation_only( const matrix3x3<t>& in, polar_method method, float tolerance )
+    {
+        switch ( method )
+        {
+            case polar_method_newton:
+                return rotation_newton( in, tolerance );
+            case polar_method_newton_svd:
+                return rotation_newton_svd( in, tolerance );
+            default:
+                return rotation_only( in, tolerance );
+        }
+    }
+}
+
+#endif
@@ -6,146 +6,136 @@
 #include "svd_types.h"
 #include "svd_math.h"
 #include "svd.h"
-
+#include "svd_polar.h"
 
 namespace svd
 {
-    //finds rotation and translation from points p to points q in least squares sense
-    //p is 3 points, q is 3 points
-    template <typename t> inline void rotation ( const vector3<t>* p, const vector3<t>* q, matrix3x3<t>& rotation, vector3<t>& translation )
+    //weighted sums of point pairs p -> q relative to a reference pair, every lane accumulates its own set of points.
+    //the reference pair keeps the one pass covariance accurate for points far from the origin
+    template <typename t> struct rigid_accumulator
     {
-        using namespace svd::math;
-
-        auto size = 3;
-        auto cp = vector3<t>();
-        auto cq = vector3<t>();
-        
-        cp.x = math::zero<t>();
-        cp.y = math::zero<t>();
-        cp.z = math::zero<t>();
-
-        cq.x = math::zero<t>();
-        cq.y = math::zero<t>();
-        cq.z = math::zero<t>();
-
-        
-        for ( int32_t i = 0; i < size; ++i )
-        {
-            cp.x = cp.x + p[i].x;
-            cp.y = cp.y + p[i].y;
-            cp.z = cp.z + p[i].z;
-
-            cq.x = cq.x + q[i].x;
-            cq.y = cq.y + q[i].y;
-            cq.z = cq.z + q[i].z;
-        }
-        
-        cp.x = cp.x / math::splat<t>(3.0f);
-        cp.y = cp.y / math::splat<t>(3.0f);
-        cp.z = cp.z / math::splat<t>(3.0f);
+        vector3<t>      m_p0;
+        vector3<t>      m_q0;
 
-        cq.x = cq.x / math::splat<t>(3.0f);
-        cq.y = cq.y / math::splat<t>(3.0f);
-        cq.z = cq.z / math::splat<t>(3.0f);
+        t               m_w;    // sum w
+        vector3<t>      m_p;    // sum w * ( p - p0 )
+        vector3<t>      m_q;    // sum w * ( q - q0 )
+        matrix3x3<t>    m_m;    // sum w * ( q - q0 ) * transpose( p - p0 )
+    };
 
-        vector3<t> x[3];
-        vector3<t> y[3];
-
-        for ( int32_t i = 0; i < size; ++i )
-        {
-            x[i].x = p[i].x - cp.x;
-            x[i].y = p[i].y - cp.y;
-            x[i].z = p[i].z - cp.z;
+    //p0, q0 is any pair of the set, for example the first one
+    template <typename t> inline rigid_accumulator<t> make_rigid_accumulator( const vector3<t>& p0, const vector3<t>& q0 )
+    {
+        using namespace svd::math;
 
-            y[i].x = q[i].x - cq.x;
-            y[i].y = q[i].y - cq.y;
-            y[i].z = q[i].z - cq.z;
-        }
+        auto z = zero<t>();
 
-        //compute x.transpose(y)
-        
-        //x0x y0x + x1x y1x + x2x y2x
-        auto s11 = dot3( x[0].x, x[1].x, x[2].x, y[0].x, y[1].x, y[2].x );
+        rigid_accumulator<t> r;
 
-        //x0 x y0y + x1x y1y + x2x y2y
-        auto s12 = dot3( x[0].x, x[1].x, x[2].x, y[0].y, y[1].y, y[2].y );
+        r.m_p0 = p0;
+        r.m_q0 = q0;
+        r.m_w  = z;
+        r.m_p.x = z; r.m_p.y = z; r.m_p.z = z;
+        r.m_q.x = z; r.m_q.y = z; r.m_q.z = z;
+        r.m_m  = create_matrix( z, z, z, z, z, z, z, z, z );
 
-        //x0x y0z + x1x y1z + x2x y2z
-        auto s13 = dot3( x[0].x, x[1].x, x[2].x, y[0].z, y[1].z, y[2].z );
+        return r;
+    }
 
+    template <typename t> inline void accumulate( rigid_accumulator<t>& a, const vector3<t>& p, const vector3<t>& q, t w )
+    {
+        using namespace svd::math;
 
-        //x0y y0x + x1y y1x + x2y y2x
-        auto s21 = dot3( x[0].y, x[1].y, x[2].y, y[0].x, y[1].x, y[2].x );
-        
-        //x0y y0y + x1y y1y + x2y y2y
-        auto s22 = dot3( x[0].y, x[1].y, x[2].y, y[0].y, y[1].y, y[2].y );
-        
-        //x0y y0z + x1y y1z + x2y y2z
-        auto s23 = dot3( x[0].y, x[1].y, x[2].y, y[0].z, y[1].z, y[2].z );
+        auto px = p.x - a.m_p0.x;
+        auto py = p.y - a.m_p0.y;
+        auto pz = p.z - a.m_p0.z;
 
+        auto wqx = w * ( q.x - a.m_q0.x );
+        auto wqy = w * ( q.y - a.m_q0.y );
+        auto wqz = w * ( q.z - a.m_q0.z );
 
-        //x0z y0x + x1z y1x + x2z y2x
-        auto s31 = dot3( x[0].z, x[1].z, x[2].z, y[0].x, y[1].x, y[2].x );
+        a.m_w = a.m_w + w;
 
-        //x0z y0y + x1z y1y + x2z y2y
-        auto s32 = dot3( x[0].z, x[1].z, x[2].z, y[0].y, y[1].y, y[2].y );
-        
-        //x0z y0z + x1z y1z + x2z y2z
-        auto s33 = dot3( x[0].z, x[1].z, x[2].z, y[0].z, y[1].z, y[2].z );
+        a.m_p.x = madd( w, px, a.m_p.x );
+        a.m_p.y = madd( w, py, a.m_p.y );
+        a.m_p.z = madd( w, pz, a.m_p.z );
 
-        matrix3x3<t> u;
-        matrix3x3<t> v;
+        a.m_q.x = a.m_q.x + wqx;
+        a.m_q.y = a.m_q.y + wqy;
+        a.m_q.z = a.m_q.z + wqz;
 
-        compute_as_matrix_uv( create_matrix( s11, s12, s13, s21, s22, s23, s31, s32, s33 ), u, v );
+        a.m_m.a11 = madd( wqx, px, a.m_m.a11 );
+        a.m_m.a12 = madd( wqx, py, a.m_m.a12 );
+        a.m_m.a13 = madd( wqx, pz, a.m_m.a13 );
 
-        
-        //compute u.transpose(v)
-        //see svd rotation paper for more details
+        a.m_m.a21 = madd( wqy, px, a.m_m.a21 );
+        a.m_m.a22 = madd( wqy, py, a.m_m.a22 );
+        a.m_m.a23 = madd( wqy, pz, a.m_m.a23 );
 
-        //u11 v11 + u12 v12 + u13 v13
-        auto r11 = dot3 ( u.a11, u.a12, u.a13, v.a11, v.a12, v.a13 );
+        a.m_m.a31 = madd( wqz, px, a.m_m.a31 );
+        a.m_m.a32 = madd( wqz, py, a.m_m.a32 );
+        a.m_m.a33 = madd( wqz, pz, a.m_m.a33 );
+    }
 
-        //u21 v11 + u22 v12 + u23 v13
-        auto r12 = dot3 ( u.a21, u.a22, u.a23, v.a11, v.a12, v.a13 );
+    //rotation and translation, q = rotation * p + translation, that minimize sum w * | rotation * p + translation - q | ^ 2 (kabsch).
+    //the rotation is the one of the polar decomposition of the covariance sum w * ( q - cq ) * transpose( p - cp ), so it is never
+    //a reflection. polar_method_newton needs a covariance of full rank, points that are not on a plane.
+    //lanes without points (zero weight) get an unspecified transform
+    template <typename t> inline void solve( const rigid_accumulator<t>& a, matrix3x3<t>& rotation, vector3<t>& translation, polar_method method = polar_method_svd, float tolerance = 0.0f )
+    {
+        using namespace svd::math;
 
-        //u31 v11 + u32 v12 + u33 v13
-        auto r13 = dot3 ( u.a31, u.a32, u.a33, v.a11, v.a12, v.a13 );
+        auto inv_w = one<t>() / max( a.m_w, splat<t>( 1e-30f ) );
 
-        //u11 v21 + u12 v22 + u13 v23
-        auto r21 = dot3 ( u.a11, u.a12, u.a13, v.a21, v.a22, v.a23 );
+        //centroids relative to the reference pair
+        auto cpx = a.m_p.x * inv_w;
+        auto cpy = a.m_p.y * inv_w;
+        auto cpz = a.m_p.z * inv_w;
 
-        //u21 v21 + u22 v22 + u23 v23
-        auto r22 = dot3 ( u.a21, u.a22, u.a23, v.a21, v.a22, v.a23 );
+        auto cqx = a.m_q.x * inv_w;
+        auto cqy = a.m_q.y * inv_w;
+        auto cqz = a.m_q.z * inv_w;
 
-        //u31 v21 + u32 v22 + u33 v23
-        auto r23 = dot3 ( u.a31, u.a32, u.a33, v.a21, v.a22, v.a23 );
+        //sum w * ( q - cq ) * transpose( p - cp ) = sum w * q * transpose( p ) - sum( w ) * cq * transpose( cp )
+        auto m = create_matrix
+        (
+            nmadd( a.m_q.x, cpx, a.m_m.a11 ), nmadd( a.m_q.x, cpy, a.m_m.a12 ), nmadd( a.m_q.x, cpz, a.m_m.a13 ),
+            nmadd( a.m_q.y, cpx, a.m_m.a21 ), nmadd( a.m_q.y, cpy, a.m_m.a22 ), nmadd( a.m_q.y, cpz, a.m_m.a23 ),
+            nmadd( a.m_q.z, cpx, a.m_m.a31 ), nmadd( a.m_q.z, cpy, a.m_m.a32 ), nmadd( a.m_q.z, cpz, a.m_m.a33 )
+        );
 
-        //u11 v31 + u12 v32 + u13 v33
-        auto r31 = dot3 ( u.a11, u.a12, u.a13, v.a31, v.a32, v.a33 );
+        rotation = rotation_only( m, method, tolerance );
 
-        //u21 v31 + u22 v32 + u23 v33
-        auto r32 = dot3 ( u.a21, u.a22, u.a23, v.a31, v.a32, v.a33 );
+        cpx = cpx + a.m_p0.x;
+        cpy = cpy + a.m_p0.y;
+        cpz = cpz + a.m_p0.z;
 
-        //u31 v31 + u32 v32 + u33 v33
-        auto r33 = dot3 ( u.a31, u.a32, u.a33, v.a31, v.a32, v.a33 );
+        translation.x = cqx + a.m_q0.x - dot3( rotation.a11, rotation.a12, rotation.a13, cpx, cpy, cpz );
+        translation.y = cqy + a.m_q0.y - dot3( rotation.a21, rotation.a22, rotation.a23, cpx, cpy, cpz );
+        translation.z = cqz + a.m_q0.z - dot3( rotation.a31, rotation.a32, rotation.a33, cpx, cpy, cpz );
+    }
 
+    //finds rotation and translation from points p to points q in weighted least squares sense. w is null for unit weights.
+    //every lane is an independent set of size points
+    template <typename t> inline void rotation ( const vector3<t>* p, const vector3<t>* q, const t* w, int32_t size, matrix3x3<t>& rotation, vector3<t>& translation, polar_method method = polar_method_svd )
+    {
+        using namespace svd::math;
 
-        //calculate translation
-        translation.x = cq.x - dot3( cp.x, cp.y, cp.z, r11, r12, r13 );
-        translation.y = cq.y - dot3( cp.x, cp.y, cp.z, r21, r22, r23 );
-        translation.z = cq.z - dot3( cp.x, cp.y, cp.z, r31, r32, r33 );
+        auto a = make_rigid_accumulator( p[0], q[0] );
 
-        rotation.a11 = r11;
-        rotation.a12 = r12;
-        rotation.a13 = r13;
+        for ( int32_t i = 0; i < size; ++i )
+        {
+            accumulate( a, p[i], q[i], w != nullptr ? w[i] : one<t>() );
+        }
 
-        rotation.a21 = r21;
-        rotation.a22 = r22;
-        rotation.a23 = r23;
+        solve( a, rotation, translation, method );
+    }
 
-        rotation.a31 = r31;
-        rotation.a32 = r32;
-        rotation.a33 = r33;
+    //finds rotation and translation from points p to points q in least squares sense
+    //p is 3 points, q is 3 points
+    template <typename t> inline void rotation ( const vector3<t>* p, const vector3<t>* q, matrix3x3<t>& rotation, vector3<t>& translation )
+    {
+        svd::rotation<t>( p, q, nullptr, 3, rotation, translation );
     }
 }
 
@@ -1,6 +1,8 @@
 #ifndef __svd_types_h__
 #define __svd_types_h__
 
+#include "svd_math.h"
+
 namespace svd
 {
     template <typename t> struct matrix3x3
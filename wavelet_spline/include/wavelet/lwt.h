@@ -1,8 +1,375 @@
 #ifndef __wavelet_lwt_curve_h__
 #define __wavelet_lwt_curve_h__
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#else
+#include <xmmintrin.h>
+#endif
+
 namespace lwt
 {
+    namespace details
+    {
+        //evens to [begin, begin + (n + 1) / 2), odds to scratch[0, n / 2)
+        template <typename iterator, typename scratch_iterator>
+        void deinterleave( iterator begin, iterator end, scratch_iterator odd )
+        {
+            auto  pairs     = thrust::distance( begin, end ) / 2;
+            auto  even      = begin;
+            auto  it        = begin;
+
+            for ( decltype(pairs) i = 0; i < pairs; ++i, ++even, ++odd )
+            {
+                //the even element is written at i <= 2 * i, after it was read
+                auto e = *it++;
+                *odd   = *it++;
+                *even  = e;
+            }
+
+            if ( it < end )
+            {
+                *even = *it;
+            }
+        }
+
+        //inverse of deinterleave, the odds come from scratch[0, n / 2)
+        template <typename iterator, typename scratch_iterator>
+        void interleave( iterator begin, iterator end, scratch_iterator odd )
+        {
+            auto  distance  = thrust::distance( begin, end );
+            auto  pairs     = distance / 2;
+
+            //backwards, element 2 * i + 1 and 2 * i are written after the evens up to i were read
+            if ( distance & 1 )
+            {
+                *( begin + ( distance - 1 ) ) = *( begin + pairs );
+            }
+
+            for ( auto i = pairs; i-- > 0; )
+            {
+                auto e = *( begin + i );
+                *( begin + ( 2 * i + 1 ) ) = *( odd + i );
+                *( begin + ( 2 * i ) )     = e;
+            }
+        }
+
+        //floats are shuffled four pairs at a time
+        inline void deinterleave( float* begin, float* end, float* odd )
+        {
+            auto  distance  = end - begin;
+            auto  pairs     = distance / 2;
+
+            std::ptrdiff_t i = 0;
+
+            for ( ; i + 4 <= pairs; i += 4 )
+            {
+                auto a = _mm_loadu_ps( begin + 2 * i );
+                auto b = _mm_loadu_ps( begin + 2 * i + 4 );
+
+                _mm_storeu_ps( begin + i, _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+                _mm_storeu_ps( odd + i,   _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+            }
+
+            for ( ; i < pairs; ++i )
+            {
+                auto e      = begin[ 2 * i ];
+                odd[ i ]    = begin[ 2 * i + 1 ];
+                begin[ i ]  = e;
+            }
+
+            if ( distance & 1 )
+            {
+                begin[ pairs ] = begin[ distance - 1 ];
+            }
+        }
+
+        inline void interleave( float* begin, float* end, float* odd )
+        {
+            auto  distance  = end - begin;
+            auto  pairs     = distance / 2;
+
+            if ( distance & 1 )
+            {
+                begin[ distance - 1 ] = begin[ pairs ];
+            }
+
+            //the pairs that do not fill a vector are the last ones, they go first
+            auto i = pairs;
+
+            for ( ; i & 3; )
+            {
+                --i;
+                auto e                  = begin[ i ];
+                begin[ 2 * i + 1 ]      = odd[ i ];
+                begin[ 2 * i ]          = e;
+            }
+
+            while ( i > 0 )
+            {
+                i -= 4;
+
+                auto e = _mm_loadu_ps( begin + i );
+                auto o = _mm_loadu_ps( odd + i );
+
+                _mm_storeu_ps( begin + 2 * i + 4, _mm_unpackhi_ps( e, o ) );
+                _mm_storeu_ps( begin + 2 * i,     _mm_unpacklo_ps( e, o ) );
+            }
+        }
+
+        //fused lifting: a tile of the signal is de-interleaved once into two buffers that stay in the l1 cache, every
+        //lifting step runs on them and the tile is written once. the tiles overlap by lift_halo pairs on both sides, so a
+        //two tap step never reads a value of a neighbour tile that is not lifted yet. edges of the signal are lifted by
+        //the wavelet, only the first and the last tile see them
+        static const size_t lift_tile = 1024;
+        static const size_t lift_halo = 4;
+
+        //load, store and arithmetic of the lifting, specialized per value type. deinterleave / interleave split 2 * width
+        //values into the evens and the odds and back
+        template <typename value> struct lift_simd;
+
+        #if defined(__AVX__)
+        template <> struct lift_simd<float>
+        {
+            typedef __m256 type;
+            static const size_t width = 8;
+
+            static type load( const float* p )              { return _mm256_loadu_ps( p ); }
+            static void store( float* p, type v )           { _mm256_storeu_ps( p, v ); }
+            static type set( float f )                      { return _mm256_set1_ps( f ); }
+            static type add( type a, type b )               { return _mm256_add_ps( a, b ); }
+            static type mul( type a, type b )               { return _mm256_mul_ps( a, b ); }
+
+            static void deinterleave( const float* p, type& even, type& odd )
+            {
+                auto a  = _mm256_loadu_ps( p );
+                auto b  = _mm256_loadu_ps( p + 8 );
+                auto lo = _mm256_permute2f128_ps( a, b, 0x20 );
+                auto hi = _mm256_permute2f128_ps( a, b, 0x31 );
+
+                even    = _mm256_shuffle_ps( lo, hi, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+                odd     = _mm256_shuffle_ps( lo, hi, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+            }
+
+            static void interleave( float* p, type even, type odd )
+            {
+                auto lo = _mm256_unpacklo_ps( even, odd );
+                auto hi = _mm256_unpackhi_ps( even, odd );
+
+                _mm256_storeu_ps( p,     _mm256_permute2f128_ps( lo, hi, 0x20 ) );
+                _mm256_storeu_ps( p + 8, _mm256_permute2f128_ps( lo, hi, 0x31 ) );
+            }
+        };
+        #else
+        template <> struct lift_simd<float>
+        {
+            typedef __m128 type;
+            static const size_t width = 4;
+
+            static type load( const float* p )              { return _mm_loadu_ps( p ); }
+            static void store( float* p, type v )           { _mm_storeu_ps( p, v ); }
+            static type set( float f )                      { return _mm_set1_ps( f ); }
+            static type add( type a, type b )               { return _mm_add_ps( a, b ); }
+            static type mul( type a, type b )               { return _mm_mul_ps( a, b ); }
+
+            static void deinterleave( const float* p, type& even, type& odd )
+            {
+                auto a  = _mm_loadu_ps( p );
+                auto b  = _mm_loadu_ps( p + 4 );
+
+                even    = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+                odd     = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+            }
+
+            static void interleave( float* p, type even, type odd )
+            {
+                _mm_storeu_ps( p,     _mm_unpacklo_ps( even, odd ) );
+                _mm_storeu_ps( p + 4, _mm_unpackhi_ps( even, odd ) );
+            }
+        };
+        #endif
+
+        template <typename value> inline void deinterleave( const value* in, value* even, value* odd, size_t pairs )
+        {
+            typedef lift_simd<value> simd;
+
+            size_t i = 0;
+
+            for ( ; i + simd::width <= pairs; i += simd::width )
+            {
+                typename simd::type e;
+                typename simd::type o;
+                simd::deinterleave( in + 2 * i, e, o );
+                simd::store( even + i, e );
+                simd::store( odd + i, o );
+            }
+
+            for ( ; i < pairs; ++i )
+            {
+                even[i] = in[ 2 * i ];
+                odd[i]  = in[ 2 * i + 1 ];
+            }
+        }
+
+        template <typename value> inline void interleave( const value* even, const value* odd, value* out, size_t pairs )
+        {
+            typedef lift_simd<value> simd;
+
+            size_t i = 0;
+
+            for ( ; i + simd::width <= pairs; i += simd::width )
+            {
+                simd::interleave( out + 2 * i, simd::load( even + i ), simd::load( odd + i ) );
+            }
+
+            for ( ; i < pairs; ++i )
+            {
+                out[ 2 * i ]     = even[i];
+                out[ 2 * i + 1 ] = odd[i];
+            }
+        }
+
+        //x[i] += c * y[i]
+        inline void lift1( float* x, const float* y, float c, size_t count )
+        {
+            typedef lift_simd<float> simd;
+
+            const auto f = simd::set( c );
+            size_t i = 0;
+
+            for ( ; i + simd::width <= count; i += simd::width )
+            {
+                simd::store( x + i, simd::add( simd::load( x + i ), simd::mul( f, simd::load( y + i ) ) ) );
+            }
+
+            for ( ; i < count; ++i )
+            {
+                x[i] = x[i] + c * y[i];
+            }
+        }
+
+        //x[i] *= c
+        inline void scale( float* x, float c, size_t count )
+        {
+            typedef lift_simd<float> simd;
+
+            const auto f = simd::set( c );
+            size_t i = 0;
+
+            for ( ; i + simd::width <= count; i += simd::width )
+            {
+                simd::store( x + i, simd::mul( f, simd::load( x + i ) ) );
+            }
+
+            for ( ; i < count; ++i )
+            {
+                x[i] = c * x[i];
+            }
+        }
+
+        //x[i] += c * ( y[i] + y[i + 1] ), offset 1, the predict of the odds from the evens, or
+        //x[i] += c * ( y[i - 1] + y[i] ), offset -1, the update of the evens from the odds,
+        //for i in [first, last)
+        template <int offset> inline void lift2( float* x, const float* y, float c, size_t first, size_t last )
+        {
+            typedef lift_simd<float> simd;
+
+            const auto f = simd::set( c );
+            size_t i = first;
+
+            for ( ; i + simd::width <= last; i += simd::width )
+            {
+                auto sum = simd::add( simd::load( y + i ), simd::load( y + i + offset ) );
+                simd::store( x + i, simd::add( simd::load( x + i ), simd::mul( f, sum ) ) );
+            }
+
+            for ( ; i < last; ++i )
+            {
+                x[i] = x[i] + c * ( y[i] + y[ i + offset ] );
+            }
+        }
+
+        //the predict of the pairs [0, pairs) of a tile, the last pair has no right neighbour
+        inline void predict2( float* odd, const float* even, float c, size_t pairs )
+        {
+            lift2<1>( odd, even, c, 0, pairs - 1 );
+        }
+
+        //the update of the pairs [0, pairs) of a tile, the first pair has no left neighbour
+        inline void update2( float* even, const float* odd, float c, size_t pairs )
+        {
+            lift2<-1>( even, odd, c, 1, pairs );
+        }
+
+        //low = [0, n / 2) and high = [0, n / 2) of the lifted signal in [0, n), n even. low may be in, each element of in
+        //is read once, each element of low and high is written once
+        template <typename wavelet, typename value> inline void lift_fwd( const value* in, value* low, value* high, size_t n )
+        {
+            const size_t h = n / 2;
+
+            value even[ lift_tile + 2 * lift_halo ];
+            value odd[ lift_tile + 2 * lift_halo ];
+
+            for ( size_t k = 0; k < h; k += lift_tile )
+            {
+                const size_t k_end  = std::min( k + lift_tile, h );
+                const size_t a      = k > lift_halo ? k - lift_halo : 0;
+                const size_t b      = std::min( k_end + lift_halo, h );
+
+                deinterleave( in + 2 * a, even, odd, b - a );
+                wavelet::fwd( even, odd, b - a, a == 0, b == h );
+
+                std::copy( even + ( k - a ), even + ( k_end - a ), low + k );
+                std::copy( odd + ( k - a ), odd + ( k_end - a ), high + k );
+            }
+        }
+
+        //inverse of lift_fwd into out. out may be low, the tiles run from the end so out does not overwrite low before
+        //it is read
+        template <typename wavelet, typename value> inline void lift_inv( const value* low, const value* high, value* out, size_t n )
+        {
+            const size_t h = n / 2;
+
+            value even[ lift_tile + 2 * lift_halo ];
+            value odd[ lift_tile + 2 * lift_halo ];
+
+            for ( size_t k = h > 0 ? ( ( h - 1 ) / lift_tile ) * lift_tile : 0; k < h; k -= lift_tile )
+            {
+                const size_t k_end  = std::min( k + lift_tile, h );
+                const size_t a      = k > lift_halo ? k - lift_halo : 0;
+                const size_t b      = std::min( k_end + lift_halo, h );
+
+                std::copy( low + a, low + b, even );
+                std::copy( high + a, high + b, odd );
+                wavelet::inv( even, odd, b - a, a == 0, b == h );
+
+                interleave( even + ( k - a ), odd + ( k - a ), out + 2 * k, k_end - k );
+            }
+        }
+
+        //in place, the high half goes through scratch of n / 2 elements. the last element of an odd n is left as it is
+        template <typename wavelet, typename value> inline void lift_fwd( value* begin, value* end )
+        {
+            const size_t h = ( end - begin ) / 2;
+
+            std::vector<value> scratch( h );
+            lift_fwd<wavelet>( begin, begin, scratch.data(), 2 * h );
+            std::copy( scratch.begin(), scratch.end(), begin + h );
+        }
+
+        template <typename wavelet, typename value> inline void lift_inv( value* begin, value* end )
+        {
+            const size_t h = ( end - begin ) / 2;
+
+            std::vector<value> scratch( begin + h, begin + 2 * h );
+            lift_inv<wavelet>( begin, scratch.data(), begin, 2 * h );
+        }
+    }
+
     template < typename iterator, typename normalizer >
     void normalize_even(iterator begin, iterator end, normalizer n)
     {
@@ -29,22 +396,29 @@ namespace lwt
 
     namespace fwd
     {
+        //evens to the first half, odds to the second half in O(n). scratch holds n / 2 elements
+        template <typename iterator, typename scratch_iterator>
+        void split( iterator begin, iterator end, scratch_iterator scratch )
+        {
+            auto  distance  = thrust::distance( begin, end );
+
+            details::deinterleave( begin, end, scratch );
+            std::copy( scratch, scratch + distance / 2, begin + ( distance - distance / 2 ) );
+        }
+
         template <typename iterator>
         void split( iterator begin, iterator end )
         {
-            begin = begin + 1;
-            end   = end - 1; 
+            typedef typename thrust::iterator_value<iterator>::type value;
 
-            while ( begin < end )
-            {
-                for ( auto it = begin; it < end; it+=2)
-                {
-                    std::swap( *it, *(it+1) );
-                }
+            std::vector<value> scratch( thrust::distance( begin, end ) / 2 );
+            split( begin, end, scratch.begin() );
+        }
 
-                begin++;
-                end--;
-            }
+        inline void split( float* begin, float* end )
+        {
+            std::vector<float> scratch( ( end - begin ) / 2 );
+            split( begin, end, scratch.data() );
         }
 
         template <typename iterator, typename predictor >
@@ -84,25 +458,29 @@ namespace lwt
 
     namespace inv
     {
+        //inverse of split in O(n). scratch holds n / 2 elements
+        template <typename iterator, typename scratch_iterator>
+        void merge( iterator begin, iterator end, scratch_iterator scratch )
+        {
+            auto  distance  = thrust::distance( begin, end );
+
+            std::copy( begin + ( distance - distance / 2 ), end, scratch );
+            details::interleave( begin, end, scratch );
+        }
+
         template <typename iterator>
         void merge( iterator begin, iterator end )
         {
-            auto  middle    = thrust::distance( begin, end );
-            auto  half      = begin + (middle / 2);
+            typedef typename thrust::iterator_value<iterator>::type value;
 
-            auto  s         = half - 1;
-            auto  e         = half;
-        
-            while ( s > begin )
-            {
-                for ( auto it = s; it < e; it+=2 )
-                {
-                    std::swap( *it, *(it+1));
-                }
+            std::vector<value> scratch( thrust::distance( begin, end ) / 2 );
+            merge( begin, end, scratch.begin() );
+        }
 
-                s--;
-                e++;
-            }
+        inline void merge( float* begin, float* end )
+        {
+            std::vector<float> scratch( ( end - begin ) / 2 );
+            merge( begin, end, scratch.data() );
         }
 
         template <typename iterator, typename predictor >
@@ -196,6 +574,67 @@ namespace lwt
                 lwt::inv::merge(begin, end);
             }
         }
+
+        //the steps above on a tile of lwt::details::lift_fwd, same results
+        struct lifting
+        {
+            static void fwd( float* even, float* odd, size_t pairs, bool, bool )
+            {
+                details::lift1( odd, even, -1.0f, pairs );
+                details::lift1( even, odd, 0.5f, pairs );
+            }
+
+            static void inv( float* even, float* odd, size_t pairs, bool, bool )
+            {
+                details::lift1( even, odd, -0.5f, pairs );
+                details::lift1( odd, even, 1.0f, pairs );
+            }
+        };
+
+        namespace fwd
+        {
+            //contiguous floats of even length take the fused lifting
+            inline void transform( float* begin, float* end )
+            {
+                if ( ( end - begin ) & 1 )
+                {
+                    transform<float*>( begin, end );
+                    return;
+                }
+
+                details::lift_fwd<lifting>( begin, end );
+            }
+        }
+
+        namespace inv
+        {
+            inline void transform( float* begin, float* end )
+            {
+                if ( ( end - begin ) & 1 )
+                {
+                    transform<float*>( begin, end );
+                    return;
+                }
+
+                details::lift_inv<lifting>( begin, end );
+            }
+        }
+
+        //the 1d transforms of the family, for the 2d transform of lwt_2d.h
+        struct kernel
+        {
+            template < typename iterator>
+            static void fwd( iterator begin, iterator end )
+            {
+                haar::fwd::transform( begin, end );
+            }
+
+            template < typename iterator>
+            static void inv( iterator begin, iterator end )
+            {
+                haar::inv::transform( begin, end );
+            }
+        };
     }
 
     namespace linear
@@ -248,27 +687,124 @@ namespace lwt
         };
 
 
-        namespace fwd
+        namespace fwd
+        {
+            template < typename iterator>
+            void transform( iterator begin, iterator end )
+            {
+                lwt::fwd::split( begin, end );
+                lwt::fwd::predict( begin, end, predictor<iterator>() );
+                lwt::fwd::update( begin, end, updater<iterator>() );
+            }
+        }
+
+        namespace inv
+        {
+            template < typename iterator>
+            void transform( iterator begin, iterator end )
+            {
+                lwt::inv::update( begin, end, updater<iterator>() );
+                lwt::inv::predict( begin, end, predictor<iterator>());
+                lwt::inv::merge( begin, end );
+            }
+        }
+
+        //the steps above on a tile of lwt::details::lift_fwd, same results. this is the cdf 5/3 wavelet with the edges
+        //of the predictor and the updater above
+        struct lifting
+        {
+            static void fwd( float* even, float* odd, size_t pairs, bool left, bool right )
+            {
+                details::predict2( odd, even, -0.5f, pairs );
+
+                if ( right )
+                {
+                    odd[ pairs - 1 ] = odd[ pairs - 1 ] - edge( even, pairs );
+                }
+
+                details::update2( even, odd, 0.25f, pairs );
+
+                if ( left )
+                {
+                    even[0] = even[0] + odd[0] / 2.0f;
+                }
+            }
+
+            static void inv( float* even, float* odd, size_t pairs, bool left, bool right )
+            {
+                details::update2( even, odd, -0.25f, pairs );
+
+                if ( left )
+                {
+                    even[0] = even[0] - odd[0] / 2.0f;
+                }
+
+                details::predict2( odd, even, 0.5f, pairs );
+
+                if ( right )
+                {
+                    odd[ pairs - 1 ] = odd[ pairs - 1 ] + edge( even, pairs );
+                }
+            }
+
+            //the prediction of the last odd, the line through the last two evens
+            static float edge( const float* even, size_t pairs )
+            {
+                if ( pairs == 1 )
+                {
+                    return even[0];
+                }
+
+                auto y2 = even[ pairs - 1 ];
+                auto y1 = even[ pairs - 2 ];
+                return ( y2 + 2 * y2 - y1 ) / 2;
+            }
+        };
+
+        namespace fwd
+        {
+            //contiguous floats of even length take the fused lifting
+            inline void transform( float* begin, float* end )
+            {
+                if ( ( end - begin ) & 1 )
+                {
+                    transform<float*>( begin, end );
+                    return;
+                }
+
+                details::lift_fwd<lifting>( begin, end );
+            }
+        }
+
+        namespace inv
+        {
+            inline void transform( float* begin, float* end )
+            {
+                if ( ( end - begin ) & 1 )
+                {
+                    transform<float*>( begin, end );
+                    return;
+                }
+
+                details::lift_inv<lifting>( begin, end );
+            }
+        }
+
+        //the 1d transforms of the family, for the 2d transform of lwt_2d.h
+        struct kernel
         {
             template < typename iterator>
-            void transform( iterator begin, iterator end )
+            static void fwd( iterator begin, iterator end )
             {
-                lwt::fwd::split( begin, end );
-                lwt::fwd::predict( begin, end, predictor<iterator>() );
-                lwt::fwd::update( begin, end, updater<iterator>() );
+                linear::fwd::transform( begin, end );
             }
-        }
 
-        namespace inv
-        {
             template < typename iterator>
-            void transform( iterator begin, iterator end )
+            static void inv( iterator begin, iterator end )
             {
-                lwt::inv::update( begin, end, updater<iterator>() );
-                lwt::inv::predict( begin, end, predictor<iterator>());
-                lwt::inv::merge( begin, end );
+                linear::inv::transform( begin, end );
             }
-        }
+        };
     }
 
     namespace d4
@@ -399,6 +935,22 @@ namespace lwt
                 lwt::inv::merge(begin, end);
             }
         }
+
+        //the 1d transforms of the family, for the 2d transform of lwt_2d.h
+        struct kernel
+        {
+            template < typename iterator>
+            static void fwd( iterator begin, iterator end )
+            {
+                d4::fwd::transform( begin, end );
+            }
+
+            template < typename iterator>
+            static void inv( iterator begin, iterator end )
+            {
+                d4::inv::transform( begin, end );
+            }
+        };
     }
 
     namespace cdf1
@@ -526,18 +1078,83 @@ namespace lwt
                 }
             };
 
+            template < template <typename> class updater, typename iterator>
+            void lift( iterator begin, iterator end )
+            {
+                lwt::fwd::split(begin, end);
+
+                lwt::fwd::predict( begin, end, predictor0<iterator>());
+                lwt::fwd::update( begin, end, updater<iterator>() );
+
+                lwt::normalize_even( begin, end, scale_even<iterator>() );
+                lwt::normalize_odd( begin, end, scale_odd<iterator>() );
+            }
+
             template < typename iterator>
             void transform( iterator begin, iterator end )
             {
-                lwt::fwd::split(begin, end);
+                lift<cdf15>( begin, end );
+            }
+        }
+
+        namespace inv
+        {
+            template <typename iterator> struct scale_even
+            {
+                typedef typename thrust::iterator_value<iterator>::type value;
+
+                value operator()( iterator even, iterator begin, iterator end ) const
+                {
+                    const auto f = 1.0 / sqrt(2.0);
+                    return f * (*even) ;
+                }
+            };
+
+            template <typename iterator> struct scale_odd
+            {
+                typedef typename thrust::iterator_value<iterator>::type value;
 
-                lwt::fwd::predict( begin, end, predictor0<iterator>());                
-                lwt::fwd::update( begin, end, cdf15<iterator>() );
+                value operator()( iterator odd, iterator begin, iterator end ) const
+                {
+                    const auto f = sqrt(2.0);
+                    return f * (*odd);
+                }
+            };
 
+            template < template <typename> class updater, typename iterator>
+            void lift( iterator begin, iterator end )
+            {
                 lwt::normalize_even( begin, end, scale_even<iterator>() );
                 lwt::normalize_odd( begin, end, scale_odd<iterator>() );
+
+                lwt::inv::update( begin, end, updater<iterator>() );
+                lwt::inv::predict( begin, end, predictor0<iterator>());
+                lwt::inv::merge(begin, end);
+            }
+
+            template < typename iterator>
+            void transform( iterator begin, iterator end )
+            {
+                lift<cdf15>( begin, end );
             }
         }
+
+        //cdf11, cdf13 or cdf15 as the update, for the 2d transform of lwt_2d.h
+        template < template <typename> class updater = cdf15 >
+        struct kernel
+        {
+            template < typename iterator>
+            static void fwd( iterator begin, iterator end )
+            {
+                cdf1::fwd::lift<updater>( begin, end );
+            }
+
+            template < typename iterator>
+            static void inv( iterator begin, iterator end )
+            {
+                cdf1::inv::lift<updater>( begin, end );
+            }
+        };
     }
 
     namespace cdf4
@@ -681,20 +1298,284 @@ namespace lwt
                 }
             };
 
-            template < typename iterator>
-            void transform( iterator begin, iterator end )
+            template < template <typename> class updater, typename iterator>
+            void lift( iterator begin, iterator end )
             {
                 lwt::fwd::split(begin, end);
 
                 lwt::fwd::update( begin, end, updater0<iterator>() );
-                lwt::fwd::predict( begin, end, predictor0<iterator>());                
+                lwt::fwd::predict( begin, end, predictor0<iterator>());
+
+                lwt::fwd::update( begin, end, updater<iterator>() );
+
+                lwt::normalize_even( begin, end, scale_even<iterator>() );
+                lwt::normalize_odd( begin, end, scale_odd<iterator>() );
+            }
+
+            template < typename iterator>
+            void transform( iterator begin, iterator end )
+            {
+                lift<cdf44>( begin, end );
+            }
+        }
+
+        namespace inv
+        {
+            template <typename iterator> struct scale_even
+            {
+                typedef typename thrust::iterator_value<iterator>::type value;
+
+                value operator()( iterator even, iterator begin, iterator end ) const
+                {
+                    const auto f = 1.0 / ( 2 * sqrt(2.0) );
+                    return f * (*even) ;
+                }
+            };
+
+            template <typename iterator> struct scale_odd
+            {
+                typedef typename thrust::iterator_value<iterator>::type value;
 
-                lwt::fwd::update( begin, end, cdf44<iterator>() );
+                value operator()( iterator odd, iterator begin, iterator end ) const
+                {
+                    const auto f = 4.0 / sqrt(2.0);
+                    return f * (*odd);
+                }
+            };
 
+            template < template <typename> class updater, typename iterator>
+            void lift( iterator begin, iterator end )
+            {
                 lwt::normalize_even( begin, end, scale_even<iterator>() );
                 lwt::normalize_odd( begin, end, scale_odd<iterator>() );
+
+                lwt::inv::update( begin, end, updater<iterator>() );
+                lwt::inv::predict( begin, end, predictor0<iterator>());
+                lwt::inv::update( begin, end, updater0<iterator>() );
+                lwt::inv::merge(begin, end);
+            }
+
+            template < typename iterator>
+            void transform( iterator begin, iterator end )
+            {
+                lift<cdf44>( begin, end );
+            }
+        }
+
+        //cdf42 or cdf44 as the last update, for the 2d transform of lwt_2d.h
+        template < template <typename> class updater = cdf44 >
+        struct kernel
+        {
+            template < typename iterator>
+            static void fwd( iterator begin, iterator end )
+            {
+                cdf4::fwd::lift<updater>( begin, end );
+            }
+
+            template < typename iterator>
+            static void inv( iterator begin, iterator end )
+            {
+                cdf4::inv::lift<updater>( begin, end );
+            }
+        };
+    }
+
+    //cdf 9/7 with symmetric extension at the edges, two predict and two update steps (daubechies and sweldens)
+    namespace cdf97
+    {
+        inline float alpha()    { return -1.586134342f; }
+        inline float beta()     { return -0.05298011854f; }
+        inline float gamma()    { return 0.8829110762f; }
+        inline float delta()    { return 0.4435068522f; }
+        inline float zeta()     { return 1.149604398f; }
+
+        //c * ( even + right even ), the last even is its own right neighbour
+        template <typename iterator> struct predictor
+        {
+            typedef typename thrust::iterator_value<iterator>::type value;
+
+            float c;
+
+            explicit predictor( float c ) : c( c ) {}
+
+            value operator()( iterator even, iterator begin, iterator end ) const
+            {
+                auto  distance  = thrust::distance( begin, end );
+                auto  half      = begin + (distance / 2);
+                auto  right     = even + 1;
+
+                if ( right > half - 1 )
+                {
+                    right = even;
+                }
+
+                //lwt::fwd::predict subtracts
+                return -c * ( *even + *right );
+            }
+        };
+
+        //c * ( left odd + odd ), the first odd is its own left neighbour
+        template <typename iterator> struct updater
+        {
+            typedef typename thrust::iterator_value<iterator>::type value;
+
+            float c;
+
+            explicit updater( float c ) : c( c ) {}
+
+            value operator()( iterator odd, iterator begin, iterator end ) const
+            {
+                auto  distance  = thrust::distance( begin, end );
+                auto  half      = begin + (distance / 2);
+                auto  left      = odd - 1;
+
+                if ( left < half )
+                {
+                    left = odd;
+                }
+
+                return c * ( *left + *odd );
+            }
+        };
+
+        template <typename iterator> struct scale
+        {
+            typedef typename thrust::iterator_value<iterator>::type value;
+
+            float f;
+
+            explicit scale( float f ) : f( f ) {}
+
+            value operator()( iterator it, iterator begin, iterator end ) const
+            {
+                return f * (*it);
+            }
+        };
+
+        namespace fwd
+        {
+            template < typename iterator>
+            void transform( iterator begin, iterator end )
+            {
+                lwt::fwd::split( begin, end );
+
+                lwt::fwd::predict( begin, end, predictor<iterator>( alpha() ) );
+                lwt::fwd::update( begin, end, updater<iterator>( beta() ) );
+                lwt::fwd::predict( begin, end, predictor<iterator>( gamma() ) );
+                lwt::fwd::update( begin, end, updater<iterator>( delta() ) );
+
+                lwt::normalize_even( begin, end, scale<iterator>( zeta() ) );
+                lwt::normalize_odd( begin, end, scale<iterator>( 1.0f / zeta() ) );
+            }
+        }
+
+        namespace inv
+        {
+            template < typename iterator>
+            void transform( iterator begin, iterator end )
+            {
+                lwt::normalize_even( begin, end, scale<iterator>( 1.0f / zeta() ) );
+                lwt::normalize_odd( begin, end, scale<iterator>( zeta() ) );
+
+                lwt::inv::update( begin, end, updater<iterator>( delta() ) );
+                lwt::inv::predict( begin, end, predictor<iterator>( gamma() ) );
+                lwt::inv::update( begin, end, updater<iterator>( beta() ) );
+                lwt::inv::predict( begin, end, predictor<iterator>( alpha() ) );
+
+                lwt::inv::merge( begin, end );
+            }
+        }
+
+        //the steps above on a tile of lwt::details::lift_fwd, same results
+        struct lifting
+        {
+            static void fwd( float* even, float* odd, size_t pairs, bool left, bool right )
+            {
+                predict( odd, even, alpha(), pairs, right );
+                update( even, odd, beta(), pairs, left );
+                predict( odd, even, gamma(), pairs, right );
+                update( even, odd, delta(), pairs, left );
+
+                details::scale( even, zeta(), pairs );
+                details::scale( odd, 1.0f / zeta(), pairs );
+            }
+
+            static void inv( float* even, float* odd, size_t pairs, bool left, bool right )
+            {
+                details::scale( even, 1.0f / zeta(), pairs );
+                details::scale( odd, zeta(), pairs );
+
+                update( even, odd, -delta(), pairs, left );
+                predict( odd, even, -gamma(), pairs, right );
+                update( even, odd, -beta(), pairs, left );
+                predict( odd, even, -alpha(), pairs, right );
+            }
+
+            static void predict( float* odd, const float* even, float c, size_t pairs, bool right )
+            {
+                details::predict2( odd, even, c, pairs );
+
+                if ( right )
+                {
+                    odd[ pairs - 1 ] = odd[ pairs - 1 ] + c * ( even[ pairs - 1 ] + even[ pairs - 1 ] );
+                }
+            }
+
+            static void update( float* even, const float* odd, float c, size_t pairs, bool left )
+            {
+                details::update2( even, odd, c, pairs );
+
+                if ( left )
+                {
+                    even[0] = even[0] + c * ( odd[0] + odd[0] );
+                }
+            }
+        };
+
+        namespace fwd
+        {
+            //contiguous floats of even length take the fused lifting
+            inline void transform( float* begin, float* end )
+            {
+                if ( ( end - begin ) & 1 )
+                {
+                    transform<float*>( begin, end );
+                    return;
+                }
+
+                details::lift_fwd<lifting>( begin, end );
+            }
+        }
+
+        namespace inv
+        {
+            inline void transform( float* begin, float* end )
+            {
+                if ( ( end - begin ) & 1 )
+                {
+                    transform<float*>( begin, end );
+                    return;
+                }
+
+                details::lift_inv<lifting>( begin, end );
             }
         }
+
+        //the 1d transforms of the family, for the 2d transform of lwt_2d.h
+        struct kernel
+        {
+            template < typename iterator>
+            static void fwd( iterator begin, iterator end )
+            {
+                cdf97::fwd::transform( begin, end );
+            }
+
+            template < typename iterator>
+            static void inv( iterator begin, iterator end )
+            {
+                cdf97::inv::transform( begin, end );
+            }
+        };
     }
 }
 
@@ -0,0 +1,283 @@
+#ifndef __wavelet_lwt_2d_h__
+#define __wavelet_lwt_2d_h__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <immintrin.h>
+
+#include "lwt.h"
+
+//multi-level separable 2d lifting transform (mallat decomposition) of a float image. every level transforms the rows,
+//then the columns of the low pass quadrant of the previous level, leaving low-low in the top left quarter, high pass
+//rows to the right and high pass columns below. kernel is one of lwt::haar::kernel, lwt::linear::kernel,
+//lwt::d4::kernel, lwt::cdf1::kernel<lwt::cdf1::cdf11 / cdf13 / cdf15>, lwt::cdf4::kernel<lwt::cdf4::cdf42 / cdf44>,
+//lwt::cdf97::kernel
+namespace lwt
+{
+    namespace details
+    {
+        //eight columns of one row, the value the 1d kernels run on in the column pass
+        struct lanes8
+        {
+            float v[8];
+        };
+
+        #if defined(__AVX__)
+        struct lanes8_add { static __m256 apply( __m256 a, __m256 b ) { return _mm256_add_ps( a, b ); } };
+        struct lanes8_sub { static __m256 apply( __m256 a, __m256 b ) { return _mm256_sub_ps( a, b ); } };
+        struct lanes8_mul { static __m256 apply( __m256 a, __m256 b ) { return _mm256_mul_ps( a, b ); } };
+        struct lanes8_div { static __m256 apply( __m256 a, __m256 b ) { return _mm256_div_ps( a, b ); } };
+
+        template <typename op> inline lanes8 lanes8_apply( const lanes8& a, const lanes8& b )
+        {
+            lanes8 r;
+            _mm256_storeu_ps( r.v, op::apply( _mm256_loadu_ps( a.v ), _mm256_loadu_ps( b.v ) ) );
+            return r;
+        }
+        #else
+        struct lanes8_add { static __m128 apply( __m128 a, __m128 b ) { return _mm_add_ps( a, b ); } };
+        struct lanes8_sub { static __m128 apply( __m128 a, __m128 b ) { return _mm_sub_ps( a, b ); } };
+        struct lanes8_mul { static __m128 apply( __m128 a, __m128 b ) { return _mm_mul_ps( a, b ); } };
+        struct lanes8_div { static __m128 apply( __m128 a, __m128 b ) { return _mm_div_ps( a, b ); } };
+
+        template <typename op> inline lanes8 lanes8_apply( const lanes8& a, const lanes8& b )
+        {
+            lanes8 r;
+            _mm_storeu_ps( r.v,     op::apply( _mm_loadu_ps( a.v ),     _mm_loadu_ps( b.v ) ) );
+            _mm_storeu_ps( r.v + 4, op::apply( _mm_loadu_ps( a.v + 4 ), _mm_loadu_ps( b.v + 4 ) ) );
+            return r;
+        }
+        #endif
+
+        inline lanes8 splat( float f )
+        {
+            lanes8 r;
+            std::fill( r.v, r.v + 8, f );
+            return r;
+        }
+
+        inline lanes8 operator+( const lanes8& a, const lanes8& b ) { return lanes8_apply<lanes8_add>( a, b ); }
+        inline lanes8 operator-( const lanes8& a, const lanes8& b ) { return lanes8_apply<lanes8_sub>( a, b ); }
+        inline lanes8 operator-( const lanes8& a )                  { return lanes8_apply<lanes8_sub>( splat( 0.0f ), a ); }
+
+        //scalars of the kernels are int, float or double, the lanes compute in float
+        template <typename scalar> inline typename std::enable_if< std::is_arithmetic<scalar>::value, lanes8 >::type operator*( scalar s, const lanes8& a )
+        {
+            return lanes8_apply<lanes8_mul>( splat( static_cast<float> ( s ) ), a );
+        }
+
+        template <typename scalar> inline typename std::enable_if< std::is_arithmetic<scalar>::value, lanes8 >::type operator*( const lanes8& a, scalar s )
+        {
+            return lanes8_apply<lanes8_mul>( a, splat( static_cast<float> ( s ) ) );
+        }
+
+        template <typename scalar> inline typename std::enable_if< std::is_arithmetic<scalar>::value, lanes8 >::type operator/( const lanes8& a, scalar s )
+        {
+            return lanes8_apply<lanes8_div>( a, splat( static_cast<float> ( s ) ) );
+        }
+
+        template <typename scalar> inline typename std::enable_if< std::is_arithmetic<scalar>::value, lanes8& >::type operator*=( lanes8& a, scalar s )
+        {
+            return a = a * s;
+        }
+
+        template <typename scalar> inline typename std::enable_if< std::is_arithmetic<scalar>::value, lanes8& >::type operator/=( lanes8& a, scalar s )
+        {
+            return a = a / s;
+        }
+
+        static const size_t column_lanes = 8;
+
+        //samples per thread below which more threads do not pay off
+        static const size_t transform2d_grain = 64 * 1024;
+
+        //calls f( begin, end ) on blocks of [0, n) on up to threads threads, blocks per thread at least grain_items long
+        template <typename function> inline void parallel_blocks( size_t n, size_t threads, size_t grain_items, const function& f )
+        {
+            threads = std::max<size_t>( std::min( threads, n / std::max<size_t>( grain_items, 1 ) ), 1 );
+
+            if ( threads == 1 )
+            {
+                f( 0, n );
+                return;
+            }
+
+            std::vector<std::thread> workers;
+            workers.reserve( threads - 1 );
+
+            for ( size_t i = 1; i < threads; ++i )
+            {
+                const size_t begin = n * i / threads;
+                const size_t end   = n * ( i + 1 ) / threads;
+
+                workers.push_back( std::thread( [=, &f]
+                {
+                    f( begin, end );
+                }));
+            }
+
+            f( 0, n / threads );
+
+            for ( auto& w : workers )
+            {
+                w.join();
+            }
+        }
+
+        template <typename kernel, bool forward> inline void transform_rows( float* image, size_t width, size_t pitch, size_t row_begin, size_t row_end )
+        {
+            for ( size_t y = row_begin; y < row_end; ++y )
+            {
+                float* row = image + y * pitch;
+
+                if ( forward )
+                {
+                    kernel::fwd( row, row + width );
+                }
+                else
+                {
+                    kernel::inv( row, row + width );
+                }
+            }
+        }
+
+        //strips of eight columns are copied to a contiguous buffer, transformed together and copied back. the last strip
+        //of a width that is not a multiple of eight is padded with zeros
+        template <typename kernel, bool forward> inline void transform_columns( float* image, size_t width, size_t height, size_t pitch, size_t strip_begin, size_t strip_end )
+        {
+            std::vector<lanes8> strip( height );
+
+            for ( size_t s = strip_begin; s < strip_end; ++s )
+            {
+                const size_t x       = s * column_lanes;
+                const size_t columns = std::min( column_lanes, width - x );
+
+                for ( size_t y = 0; y < height; ++y )
+                {
+                    const float* row = image + y * pitch + x;
+                    std::copy( row, row + columns, strip[y].v );
+                    std::fill( strip[y].v + columns, strip[y].v + column_lanes, 0.0f );
+                }
+
+                if ( forward )
+                {
+                    kernel::fwd( strip.data(), strip.data() + height );
+                }
+                else
+                {
+                    kernel::inv( strip.data(), strip.data() + height );
+                }
+
+                for ( size_t y = 0; y < height; ++y )
+                {
+                    std::copy( strip[y].v, strip[y].v + columns, image + y * pitch + x );
+                }
+            }
+        }
+
+        template <typename kernel, bool forward> inline void transform_level( float* image, size_t width, size_t height, size_t pitch, size_t threads )
+        {
+            const size_t strips = ( width + column_lanes - 1 ) / column_lanes;
+
+            auto rows = [=]( size_t begin, size_t end )
+            {
+                transform_rows<kernel, forward>( image, width, pitch, begin, end );
+            };
+
+            auto columns = [=]( size_t begin, size_t end )
+            {
+                transform_columns<kernel, forward>( image, width, height, pitch, begin, end );
+            };
+
+            if ( forward )
+            {
+                parallel_blocks( height, threads, transform2d_grain / std::max<size_t>( width, 1 ), rows );
+                parallel_blocks( strips, threads, transform2d_grain / std::max<size_t>( height * column_lanes, 1 ), columns );
+            }
+            else
+            {
+                parallel_blocks( strips, threads, transform2d_grain / std::max<size_t>( height * column_lanes, 1 ), columns );
+                parallel_blocks( height, threads, transform2d_grain / std::max<size_t>( width, 1 ), rows );
+            }
+        }
+
+        //the shortest length a kernel inverts. the updates of cdf15 and cdf44 wrap two odd samples around each side,
+        //at length 2 they read the even half and past the end
+        template <typename kernel> struct kernel_min_length
+        {
+            static const size_t value = 2;
+        };
+
+        template <> struct kernel_min_length< cdf1::kernel<cdf1::cdf15> >
+        {
+            static const size_t value = 4;
+        };
+
+        template <> struct kernel_min_length< cdf4::kernel<cdf4::cdf44> >
+        {
+            static const size_t value = 4;
+        };
+
+        //the lifting steps need even lengths, levels stop once a side of the low pass quadrant is odd or below the
+        //minimum length of the kernel
+        template <typename kernel> inline uint32_t transform2d_levels( size_t width, size_t height, uint32_t levels )
+        {
+            const size_t min_length = kernel_min_length<kernel>::value;
+
+            uint32_t level = 0;
+
+            for ( ; level < levels; ++level, width /= 2, height /= 2 )
+            {
+                if ( width < min_length || height < min_length || ( width & 1 ) || ( height & 1 ) )
+                {
+                    break;
+                }
+            }
+
+            return level;
+        }
+    }
+
+    namespace fwd
+    {
+        //pitch is the distance between rows in floats. returns the number of levels done, see details::transform2d_levels
+        template <typename kernel> inline uint32_t transform2d( float* image, size_t width, size_t height, size_t pitch, uint32_t levels, uint32_t thread_count = 0 )
+        {
+            const size_t threads = thread_count != 0 ? thread_count : std::max( std::thread::hardware_concurrency(), 1u );
+
+            levels = details::transform2d_levels<kernel>( width, height, levels );
+
+            for ( uint32_t level = 0; level < levels; ++level )
+            {
+                details::transform_level<kernel, true>( image, width >> level, height >> level, pitch, threads );
+            }
+
+            return levels;
+        }
+    }
+
+    namespace inv
+    {
+        //inverse of fwd::transform2d with the same levels
+        template <typename kernel> inline uint32_t transform2d( float* image, size_t width, size_t height, size_t pitch, uint32_t levels, uint32_t thread_count = 0 )
+        {
+            const size_t threads = thread_count != 0 ? thread_count : std::max( std::thread::hardware_concurrency(), 1u );
+
+            levels = details::transform2d_levels<kernel>( width, height, levels );
+
+            for ( uint32_t level = levels; level-- > 0; )
+            {
+                details::transform_level<kernel, false>( image, width >> level, height >> level, pitch, threads );
+            }
+
+            return levels;
+        }
+    }
+}
+
+#endif
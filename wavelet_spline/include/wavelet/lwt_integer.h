@@ -0,0 +1,299 @@
+#ifndef __wavelet_lwt_integer_h__
+#define __wavelet_lwt_integer_h__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <immintrin.h>
+
+#include "lwt.h"
+
+//integer to integer (reversible) lifting of int16_t or int32_t signals, the s transform and the legall 5/3 wavelet of
+//jpeg 2000 with floor rounding. the arithmetic wraps around like the simd lanes (modulo 2^16 or 2^32), so the inverse
+//gives back every signal bit for bit. the coefficients equal the exact ones while they do not overflow, for int16_t
+//that is 15 bit samples for the s transform and 14 bit samples for legall 5/3
+namespace lwt
+{
+    namespace details
+    {
+        #if defined(__AVX2__)
+        template <> struct lift_simd<int16_t>
+        {
+            typedef __m256i type;
+            static const size_t width = 16;
+
+            static type load( const int16_t* p )            { return _mm256_loadu_si256( reinterpret_cast<const __m256i*> ( p ) ); }
+            static void store( int16_t* p, type v )         { _mm256_storeu_si256( reinterpret_cast<__m256i*> ( p ), v ); }
+            static type set( int16_t v )                    { return _mm256_set1_epi16( v ); }
+            static type add( type a, type b )               { return _mm256_add_epi16( a, b ); }
+            static type sub( type a, type b )               { return _mm256_sub_epi16( a, b ); }
+            template <int shift> static type sra( type a )  { return _mm256_srai_epi16( a, shift ); }
+
+            static void deinterleave( const int16_t* p, type& even, type& odd )
+            {
+                auto a  = load( p );
+                auto b  = load( p + 16 );
+
+                //the 32 bit lanes hold an even in the low and an odd in the high half, packs keeps the order per 128 bits
+                auto e  = _mm256_packs_epi32( _mm256_srai_epi32( _mm256_slli_epi32( a, 16 ), 16 ), _mm256_srai_epi32( _mm256_slli_epi32( b, 16 ), 16 ) );
+                auto o  = _mm256_packs_epi32( _mm256_srai_epi32( a, 16 ), _mm256_srai_epi32( b, 16 ) );
+
+                even    = _mm256_permute4x64_epi64( e, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+                odd     = _mm256_permute4x64_epi64( o, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+            }
+
+            static void interleave( int16_t* p, type even, type odd )
+            {
+                auto lo = _mm256_unpacklo_epi16( even, odd );
+                auto hi = _mm256_unpackhi_epi16( even, odd );
+
+                store( p,      _mm256_permute2x128_si256( lo, hi, 0x20 ) );
+                store( p + 16, _mm256_permute2x128_si256( lo, hi, 0x31 ) );
+            }
+        };
+
+        template <> struct lift_simd<int32_t>
+        {
+            typedef __m256i type;
+            static const size_t width = 8;
+
+            static type load( const int32_t* p )            { return _mm256_loadu_si256( reinterpret_cast<const __m256i*> ( p ) ); }
+            static void store( int32_t* p, type v )         { _mm256_storeu_si256( reinterpret_cast<__m256i*> ( p ), v ); }
+            static type set( int32_t v )                    { return _mm256_set1_epi32( v ); }
+            static type add( type a, type b )               { return _mm256_add_epi32( a, b ); }
+            static type sub( type a, type b )               { return _mm256_sub_epi32( a, b ); }
+            template <int shift> static type sra( type a )  { return _mm256_srai_epi32( a, shift ); }
+
+            static void deinterleave( const int32_t* p, type& even, type& odd )
+            {
+                auto a  = _mm256_castsi256_ps( load( p ) );
+                auto b  = _mm256_castsi256_ps( load( p + 8 ) );
+                auto lo = _mm256_permute2f128_ps( a, b, 0x20 );
+                auto hi = _mm256_permute2f128_ps( a, b, 0x31 );
+
+                even    = _mm256_castps_si256( _mm256_shuffle_ps( lo, hi, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+                odd     = _mm256_castps_si256( _mm256_shuffle_ps( lo, hi, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+            }
+
+            static void interleave( int32_t* p, type even, type odd )
+            {
+                auto lo = _mm256_unpacklo_epi32( even, odd );
+                auto hi = _mm256_unpackhi_epi32( even, odd );
+
+                store( p,     _mm256_permute2x128_si256( lo, hi, 0x20 ) );
+                store( p + 8, _mm256_permute2x128_si256( lo, hi, 0x31 ) );
+            }
+        };
+        #else
+        template <> struct lift_simd<int16_t>
+        {
+            typedef __m128i type;
+            static const size_t width = 8;
+
+            static type load( const int16_t* p )            { return _mm_loadu_si128( reinterpret_cast<const __m128i*> ( p ) ); }
+            static void store( int16_t* p, type v )         { _mm_storeu_si128( reinterpret_cast<__m128i*> ( p ), v ); }
+            static type set( int16_t v )                    { return _mm_set1_epi16( v ); }
+            static type add( type a, type b )               { return _mm_add_epi16( a, b ); }
+            static type sub( type a, type b )               { return _mm_sub_epi16( a, b ); }
+            template <int shift> static type sra( type a )  { return _mm_srai_epi16( a, shift ); }
+
+            static void deinterleave( const int16_t* p, type& even, type& odd )
+            {
+                auto a  = load( p );
+                auto b  = load( p + 8 );
+
+                //the 32 bit lanes hold an even in the low and an odd in the high half
+                even    = _mm_packs_epi32( _mm_srai_epi32( _mm_slli_epi32( a, 16 ), 16 ), _mm_srai_epi32( _mm_slli_epi32( b, 16 ), 16 ) );
+                odd     = _mm_packs_epi32( _mm_srai_epi32( a, 16 ), _mm_srai_epi32( b, 16 ) );
+            }
+
+            static void interleave( int16_t* p, type even, type odd )
+            {
+                store( p,     _mm_unpacklo_epi16( even, odd ) );
+                store( p + 8, _mm_unpackhi_epi16( even, odd ) );
+            }
+        };
+
+        template <> struct lift_simd<int32_t>
+        {
+            typedef __m128i type;
+            static const size_t width = 4;
+
+            static type load( const int32_t* p )            { return _mm_loadu_si128( reinterpret_cast<const __m128i*> ( p ) ); }
+            static void store( int32_t* p, type v )         { _mm_storeu_si128( reinterpret_cast<__m128i*> ( p ), v ); }
+            static type set( int32_t v )                    { return _mm_set1_epi32( v ); }
+            static type add( type a, type b )               { return _mm_add_epi32( a, b ); }
+            static type sub( type a, type b )               { return _mm_sub_epi32( a, b ); }
+            template <int shift> static type sra( type a )  { return _mm_srai_epi32( a, shift ); }
+
+            static void deinterleave( const int32_t* p, type& even, type& odd )
+            {
+                auto a  = _mm_castsi128_ps( load( p ) );
+                auto b  = _mm_castsi128_ps( load( p + 4 ) );
+
+                even    = _mm_castps_si128( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+                odd     = _mm_castps_si128( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+            }
+
+            static void interleave( int32_t* p, type even, type odd )
+            {
+                store( p,     _mm_unpacklo_epi32( even, odd ) );
+                store( p + 4, _mm_unpackhi_epi32( even, odd ) );
+            }
+        };
+        #endif
+
+        //v modulo 2^16 or 2^32 as a signed value, what the simd lanes compute
+        template <typename value> inline value wrap( int64_t v )
+        {
+            return static_cast<value> ( static_cast<typename std::make_unsigned<value>::type> ( v ) );
+        }
+
+        //x - ( ( y0 + y1 + bias ) >> shift ) or x + ( ( y0 + y1 + bias ) >> shift ), every sum wrapped
+        template <typename value, int bias, int shift, bool subtract> inline value lift_integer( value x, value y0, value y1 )
+        {
+            const value t = static_cast<value> ( wrap<value>( int64_t( y0 ) + y1 + bias ) >> shift );
+            return wrap<value>( subtract ? int64_t( x ) - t : int64_t( x ) + t );
+        }
+
+        //x[i] -= y[i] >> shift or x[i] += y[i] >> shift
+        template <typename value, int shift, bool subtract> inline void lift_integer1( value* x, const value* y, size_t count )
+        {
+            typedef lift_simd<value> simd;
+
+            size_t i = 0;
+
+            for ( ; i + simd::width <= count; i += simd::width )
+            {
+                auto t = simd::template sra<shift>( simd::load( y + i ) );
+                simd::store( x + i, subtract ? simd::sub( simd::load( x + i ), t ) : simd::add( simd::load( x + i ), t ) );
+            }
+
+            for ( ; i < count; ++i )
+            {
+                const value t = static_cast<value> ( y[i] >> shift );
+                x[i] = wrap<value>( subtract ? int64_t( x[i] ) - t : int64_t( x[i] ) + t );
+            }
+        }
+
+        //x[i] -= ( y[i] + y[i + offset] + bias ) >> shift or x[i] += ..., for i in [first, last). offset 1 predicts the
+        //odds from the evens, offset -1 updates the evens from the odds
+        template <typename value, int offset, int bias, int shift, bool subtract> inline void lift_integer2( value* x, const value* y, size_t first, size_t last )
+        {
+            typedef lift_simd<value> simd;
+
+            const auto b = simd::set( static_cast<value> ( bias ) );
+            size_t i = first;
+
+            for ( ; i + simd::width <= last; i += simd::width )
+            {
+                auto t = simd::template sra<shift>( simd::add( simd::add( simd::load( y + i ), simd::load( y + i + offset ) ), b ) );
+                simd::store( x + i, subtract ? simd::sub( simd::load( x + i ), t ) : simd::add( simd::load( x + i ), t ) );
+            }
+
+            for ( ; i < last; ++i )
+            {
+                x[i] = lift_integer<value, bias, shift, subtract>( x[i], y[i], y[ i + offset ] );
+            }
+        }
+    }
+
+    //integer haar: d = o - e, s = e + floor( d / 2 )
+    namespace s_transform
+    {
+        //the steps on a tile of lwt::details::lift_fwd
+        struct lifting
+        {
+            template <typename value> static void fwd( value* even, value* odd, size_t pairs, bool, bool )
+            {
+                details::lift_integer1<value, 0, true>( odd, even, pairs );
+                details::lift_integer1<value, 1, false>( even, odd, pairs );
+            }
+
+            template <typename value> static void inv( value* even, value* odd, size_t pairs, bool, bool )
+            {
+                details::lift_integer1<value, 1, true>( even, odd, pairs );
+                details::lift_integer1<value, 0, false>( odd, even, pairs );
+            }
+        };
+
+        namespace fwd
+        {
+            //in place, low half then high half. the last sample of an odd length is left as it is
+            template <typename value> void transform( value* begin, value* end )
+            {
+                details::lift_fwd<lifting>( begin, end );
+            }
+        }
+
+        namespace inv
+        {
+            template <typename value> void transform( value* begin, value* end )
+            {
+                details::lift_inv<lifting>( begin, end );
+            }
+        }
+    }
+
+    //reversible cdf 5/3 of jpeg 2000: d = o - floor( ( e + e_right ) / 2 ), s = e + floor( ( d_left + d + 2 ) / 4 ),
+    //symmetric extension at the edges
+    namespace legall53
+    {
+        struct lifting
+        {
+            template <typename value> static void fwd( value* even, value* odd, size_t pairs, bool left, bool right )
+            {
+                details::lift_integer2<value, 1, 0, 1, true>( odd, even, 0, pairs - 1 );
+
+                if ( right )
+                {
+                    odd[ pairs - 1 ] = details::lift_integer<value, 0, 1, true>( odd[ pairs - 1 ], even[ pairs - 1 ], even[ pairs - 1 ] );
+                }
+
+                details::lift_integer2<value, -1, 2, 2, false>( even, odd, 1, pairs );
+
+                if ( left )
+                {
+                    even[0] = details::lift_integer<value, 2, 2, false>( even[0], odd[0], odd[0] );
+                }
+            }
+
+            template <typename value> static void inv( value* even, value* odd, size_t pairs, bool left, bool right )
+            {
+                details::lift_integer2<value, -1, 2, 2, true>( even, odd, 1, pairs );
+
+                if ( left )
+                {
+                    even[0] = details::lift_integer<value, 2, 2, true>( even[0], odd[0], odd[0] );
+                }
+
+                details::lift_integer2<value, 1, 0, 1, false>( odd, even, 0, pairs - 1 );
+
+                if ( right )
+                {
+                    odd[ pairs - 1 ] = details::lift_integer<value, 0, 1, false>( odd[ pairs - 1 ], even[ pairs - 1 ], even[ pairs - 1 ] );
+                }
+            }
+        };
+
+        namespace fwd
+        {
+            //in place, low half then high half. the last sample of an odd length is left as it is
+            template <typename value> void transform( value* begin, value* end )
+            {
+                details::lift_fwd<lifting>( begin, end );
+            }
+        }
+
+        namespace inv
+        {
+            template <typename value> void transform( value* begin, value* end )
+            {
+                details::lift_inv<lifting>( begin, end );
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,157 @@
+//round trip tests of include/wavelet: split and merge at every length, the 2d transforms of every kernel down to the
+//coarsest level. prints the failures and returns their number
+//
+//  lwt_test
+
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <wavelet/lwt.h>
+#include <wavelet/lwt_2d.h>
+
+namespace
+{
+    //split puts the evens in front of the odds, merge restores the order
+    template <typename container, typename splitter, typename merger>
+    int test_split_merge( const char* name, splitter split, merger merge )
+    {
+        int failures = 0;
+
+        for ( size_t n = 1; n <= 67; ++n )
+        {
+            container v( n );
+
+            for ( size_t i = 0; i < n; ++i )
+            {
+                v[i] = static_cast< typename container::value_type > ( i );
+            }
+
+            split( v );
+
+            bool split_ok = true;
+
+            for ( size_t i = 0; i < n; ++i )
+            {
+                const size_t expected = i < ( n + 1 ) / 2 ? 2 * i : 2 * ( i - ( n + 1 ) / 2 ) + 1;
+                split_ok = split_ok && v[i] == static_cast< typename container::value_type > ( expected );
+            }
+
+            merge( v );
+
+            bool merge_ok = true;
+
+            for ( size_t i = 0; i < n; ++i )
+            {
+                merge_ok = merge_ok && v[i] == static_cast< typename container::value_type > ( i );
+            }
+
+            if ( !split_ok || !merge_ok )
+            {
+                std::printf( "%s: n = %u %s\n", name, static_cast<unsigned> ( n ), split_ok ? "merge does not invert split" : "wrong split order" );
+                ++failures;
+            }
+        }
+
+        return failures;
+    }
+
+    int test_split_merge()
+    {
+        int failures = 0;
+
+        //the generic iterator versions
+        failures += test_split_merge< std::vector<double> >( "split / merge, iterators",
+            []( std::vector<double>& v ) { lwt::fwd::split( v.begin(), v.end() ); },
+            []( std::vector<double>& v ) { lwt::inv::merge( v.begin(), v.end() ); } );
+
+        //the simd versions for contiguous floats
+        failures += test_split_merge< std::vector<float> >( "split / merge, float*",
+            []( std::vector<float>& v ) { lwt::fwd::split( v.data(), v.data() + v.size() ); },
+            []( std::vector<float>& v ) { lwt::inv::merge( v.data(), v.data() + v.size() ); } );
+
+        return failures;
+    }
+
+    //fwd then inv of as many levels as the size allows, on a pitch wider than the image
+    template <typename kernel> int test_transform2d( const char* name )
+    {
+        static const size_t sizes[][2] =
+        {
+            { 2, 2 }, { 4, 4 }, { 8, 8 }, { 16, 16 }, { 32, 8 }, { 8, 32 }, { 6, 10 }, { 12, 4 }, { 64, 48 }, { 100, 36 }, { 256, 256 }
+        };
+
+        int failures = 0;
+
+        for ( const auto& size : sizes )
+        {
+            const size_t width  = size[0];
+            const size_t height = size[1];
+            const size_t pitch  = width + 3;
+
+            std::vector<float> image( pitch * height );
+            uint32_t           state = 12345;
+
+            for ( auto& v : image )
+            {
+                state = state * 1664525u + 1013904223u;
+                v     = static_cast<float> ( state >> 8 ) / static_cast<float> ( 1u << 24 );
+            }
+
+            auto transformed = image;
+
+            const uint32_t levels  = lwt::fwd::transform2d<kernel>( transformed.data(), width, height, pitch, 32 );
+            const uint32_t inverse = lwt::inv::transform2d<kernel>( transformed.data(), width, height, pitch, 32 );
+
+            float error = 0.0f;
+
+            for ( size_t i = 0; i < image.size(); ++i )
+            {
+                error = std::max( error, std::abs( transformed[i] - image[i] ) );
+            }
+
+            if ( levels != inverse || !( error < 1.0e-4f ) )
+            {
+                std::printf( "transform2d %s: %ux%u, %u levels, error %g\n", name, static_cast<unsigned> ( width ), static_cast<unsigned> ( height ), levels, error );
+                ++failures;
+            }
+        }
+
+        return failures;
+    }
+
+    //the kernels lwt_2d.h lists
+    int test_transform2d()
+    {
+        int failures = 0;
+
+        failures += test_transform2d< lwt::haar::kernel >( "haar" );
+        failures += test_transform2d< lwt::linear::kernel >( "linear" );
+        failures += test_transform2d< lwt::d4::kernel >( "d4" );
+        failures += test_transform2d< lwt::cdf1::kernel<lwt::cdf1::cdf11> >( "cdf11" );
+        failures += test_transform2d< lwt::cdf1::kernel<lwt::cdf1::cdf13> >( "cdf13" );
+        failures += test_transform2d< lwt::cdf1::kernel<lwt::cdf1::cdf15> >( "cdf15" );
+        failures += test_transform2d< lwt::cdf4::kernel<lwt::cdf4::cdf42> >( "cdf42" );
+        failures += test_transform2d< lwt::cdf4::kernel<lwt::cdf4::cdf44> >( "cdf44" );
+        failures += test_transform2d< lwt::cdf97::kernel >( "cdf97" );
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+
+    failures += test_split_merge();
+    failures += test_transform2d();
+
+    std::printf( "%s, %d failures\n", failures == 0 ? "passed" : "failed", failures );
+    return failures;
+}
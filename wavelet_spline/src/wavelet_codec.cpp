@@ -0,0 +1,270 @@
+//command line front end of compression/wavelet_codec.h: codes a binary pgm / ppm image at one or more quantization
+//steps and prints the rate, the psnr and the encode and decode throughput of every step
+//
+//  wavelet_codec image.ppm [-q step,step,...] [-t tile size] [-l levels] [-j threads] [-r repeats]
+//                          [-o stream.wlt] [-d decoded.ppm]
+//
+//-o and -d write the stream and the decoded image of the last step
+
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <compression/wavelet_codec.h>
+
+namespace
+{
+    bool read_token( FILE* f, uint32_t& v )
+    {
+        int c = fgetc( f );
+
+        for ( ;; )
+        {
+            if ( c == '#' )
+            {
+                while ( c != '\n' && c != EOF )
+                {
+                    c = fgetc( f );
+                }
+            }
+            else if ( c == ' ' || c == '\t' || c == '\r' || c == '\n' )
+            {
+                c = fgetc( f );
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if ( c < '0' || c > '9' )
+        {
+            return false;
+        }
+
+        v = 0;
+
+        while ( c >= '0' && c <= '9' )
+        {
+            v = 10 * v + ( c - '0' );
+            c = fgetc( f );
+        }
+
+        //one white space ends the header
+        return true;
+    }
+
+    bool read_pnm( const char* name, compression::wavelet::image& img )
+    {
+        FILE* f = fopen( name, "rb" );
+
+        if ( f == nullptr )
+        {
+            return false;
+        }
+
+        char     magic[2] = {};
+        uint32_t max_value = 0;
+
+        bool ok = fread( magic, 1, 2, f ) == 2 && magic[0] == 'P' && ( magic[1] == '5' || magic[1] == '6' )
+            && read_token( f, img.m_width ) && read_token( f, img.m_height ) && read_token( f, max_value ) && max_value == 255
+            && img.m_width != 0 && img.m_height != 0;
+
+        if ( ok )
+        {
+            img.m_channels = magic[1] == '5' ? 1 : 3;
+            img.m_pixels.resize( size_t( img.m_width ) * img.m_height * img.m_channels );
+            ok = fread( img.m_pixels.data(), 1, img.m_pixels.size(), f ) == img.m_pixels.size();
+        }
+
+        fclose( f );
+        return ok;
+    }
+
+    bool write_pnm( const char* name, const compression::wavelet::image& img )
+    {
+        FILE* f = fopen( name, "wb" );
+
+        if ( f == nullptr )
+        {
+            return false;
+        }
+
+        fprintf( f, "P%c\n%u %u\n255\n", img.m_channels == 1 ? '5' : '6', img.m_width, img.m_height );
+
+        bool ok = fwrite( img.m_pixels.data(), 1, img.m_pixels.size(), f ) == img.m_pixels.size();
+
+        return fclose( f ) == 0 && ok;
+    }
+
+    bool write_file( const char* name, const std::vector<uint8_t>& data )
+    {
+        FILE* f = fopen( name, "wb" );
+
+        if ( f == nullptr )
+        {
+            return false;
+        }
+
+        bool ok = fwrite( data.data(), 1, data.size(), f ) == data.size();
+
+        return fclose( f ) == 0 && ok;
+    }
+
+    double psnr( const std::vector<uint8_t>& a, const std::vector<uint8_t>& b )
+    {
+        double e = 0.0;
+
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            const double d = double( a[i] ) - b[i];
+            e += d * d;
+        }
+
+        e /= a.size();
+
+        return e > 0.0 ? 10.0 * std::log10( 255.0 * 255.0 / e ) : 99.0;
+    }
+
+    //best of repeats runs in seconds
+    template <typename function> double best_time( uint32_t repeats, const function& f )
+    {
+        double best = 1e30;
+
+        for ( uint32_t i = 0; i < repeats; ++i )
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            f();
+            auto end   = std::chrono::high_resolution_clock::now();
+
+            best = std::min( best, std::chrono::duration<double>( end - start ).count() );
+        }
+
+        return best;
+    }
+
+    int usage()
+    {
+        fprintf( stderr, "usage: wavelet_codec image.ppm [-q step,step,...] [-t tile size] [-l levels] [-j threads] [-r repeats] [-o stream.wlt] [-d decoded.ppm]\n" );
+        return 1;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( argc < 2 )
+    {
+        return usage();
+    }
+
+    compression::wavelet::parameters p;
+    std::vector<float>               steps;
+    uint32_t                         repeats = 3;
+    const char*                      stream_name = nullptr;
+    const char*                      decoded_name = nullptr;
+
+    for ( int i = 2; i < argc; ++i )
+    {
+        if ( i + 1 >= argc || argv[i][0] != '-' || argv[i][1] == 0 || argv[i][2] != 0 )
+        {
+            return usage();
+        }
+
+        const char  option = argv[i][1];
+        const char* v      = argv[ ++i ];
+
+        switch ( option )
+        {
+            case 'q':
+            {
+                for ( const char* s = v; *s != 0; )
+                {
+                    char* e;
+                    steps.push_back( strtof( s, &e ) );
+
+                    if ( e == s )
+                    {
+                        return usage();
+                    }
+
+                    s = *e == ',' ? e + 1 : e;
+                }
+                break;
+            }
+            case 't': p.m_tile_size = atoi( v ); break;
+            case 'l': p.m_levels    = atoi( v ); break;
+            case 'j': p.m_threads   = atoi( v ); break;
+            case 'r': repeats       = std::max( atoi( v ), 1 ); break;
+            case 'o': stream_name   = v; break;
+            case 'd': decoded_name  = v; break;
+            default:  return usage();
+        }
+    }
+
+    if ( steps.empty() )
+    {
+        steps = { 1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f };
+    }
+
+    compression::wavelet::image source;
+
+    if ( !read_pnm( argv[1], source ) )
+    {
+        fprintf( stderr, "cannot read %s, binary pgm / ppm with 255 levels only\n", argv[1] );
+        return 1;
+    }
+
+    const double mb = double( source.m_pixels.size() ) / ( 1024.0 * 1024.0 );
+
+    printf( "%s: %u x %u, %u channels, tiles %u, levels %u\n", argv[1], source.m_width, source.m_height, source.m_channels, p.m_tile_size, p.m_levels );
+    printf( "%10s %12s %8s %8s %12s %12s\n", "step", "bytes", "bpp", "psnr", "enc MB/s", "dec MB/s" );
+
+    try
+    {
+        for ( size_t i = 0; i < steps.size(); ++i )
+        {
+            const float step = steps[i];
+
+            p.m_step = step;
+
+            std::vector<uint8_t>        stream;
+            compression::wavelet::image decoded;
+
+            const double encode_time = best_time( repeats, [&] { stream  = compression::wavelet::encode( source.m_pixels.data(), source.m_width, source.m_height, source.m_channels, p ); } );
+            const double decode_time = best_time( repeats, [&] { decoded = compression::wavelet::decode( stream, p.m_threads ); } );
+
+            printf( "%10g %12zu %8.3f %8.2f %12.1f %12.1f\n", step, stream.size(), 8.0 * stream.size() / ( double( source.m_width ) * source.m_height ),
+                psnr( source.m_pixels, decoded.m_pixels ), mb / encode_time, mb / decode_time );
+
+            if ( i + 1 == steps.size() )
+            {
+                if ( stream_name && !write_file( stream_name, stream ) )
+                {
+                    fprintf( stderr, "cannot write %s\n", stream_name );
+                    return 1;
+                }
+
+                if ( decoded_name && !write_pnm( decoded_name, decoded ) )
+                {
+                    fprintf( stderr, "cannot write %s\n", decoded_name );
+                    return 1;
+                }
+            }
+        }
+    }
+    catch ( const std::exception& )
+    {
+        fprintf( stderr, "the codec rejected the image or the stream\n" );
+        return 1;
+    }
+
+    return 0;
+}